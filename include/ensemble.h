@@ -0,0 +1,118 @@
+#ifndef ENSEMBLE
+#define ENSEMBLE
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/grid/tria.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parameters.h"
+
+using namespace dealii;
+
+namespace MPI
+{
+  /*! \brief Run many parameter variants of a simulation in one MPI job.
+   *
+   * MPI_COMM_WORLD is split into groups of consecutive ranks, and the members
+   * are dealt out to the groups round-robin. A group runs its members one
+   * after the other on its own communicator. Members whose mesh signature
+   * matches the previous member of the group run on the same meshes, so the
+   * mesh generation, refinement and partitioning are only paid once per
+   * signature. The default signature is made of the dimension, the global
+   * refinements, and whether the mesh is adapted during the run, in which
+   * case it is never reused.
+   *
+   * The meshes are created with the member's parameters. The runner gets a
+   * copy of them with the global refinements set to 0, because the shared
+   * meshes are already refined. The solvers are constructed by the runner, so
+   * every member still distributes its own dofs. Every member runs in its
+   * own directory member_NNNN, which keeps the output and the checkpoints of
+   * the members apart.
+   */
+  template <int dim>
+  class Ensemble
+  {
+  public:
+    /// Meshes shared by the consecutive members of a group.
+    struct SharedMeshes
+    {
+      std::unique_ptr<parallel::distributed::Triangulation<dim>> fluid;
+      std::unique_ptr<Triangulation<dim>> solid;
+    };
+
+    /// Create (and refine) the meshes of a member on a group communicator.
+    using MeshCreator = std::function<void(
+      MPI_Comm, const Parameters::AllParameters &, SharedMeshes &)>;
+
+    /// Run a member, given by its index, on the shared meshes.
+    using MemberRunner = std::function<void(MPI_Comm,
+                                            const unsigned int,
+                                            const Parameters::AllParameters &,
+                                            SharedMeshes &)>;
+
+    /// Key of the parameters the meshes depend on.
+    using Signature =
+      std::function<std::string(const Parameters::AllParameters &)>;
+
+    Ensemble(const std::vector<Parameters::AllParameters> &members,
+             const unsigned int n_groups,
+             const Signature &signature = mesh_signature);
+    Ensemble(const Ensemble &) = delete;
+    ~Ensemble();
+
+    /// Run the members of the group of this process.
+    void run(const MeshCreator &, const MemberRunner &);
+
+    /// Print the timing of every member and the throughput on rank 0.
+    void print_summary() const;
+
+    /// The communicator of the group of this process.
+    MPI_Comm get_communicator() const { return group_communicator; }
+
+    /// The group of this process.
+    unsigned int get_group() const { return group; }
+
+    /// The members run by the group of this process, in the order they run.
+    const std::vector<unsigned int> &get_group_members() const
+    {
+      return group_members;
+    }
+
+    /// Whether a member of this group ran on the meshes of the previous one.
+    bool reused_meshes(const unsigned int member) const;
+
+    /// The default signature.
+    static std::string mesh_signature(const Parameters::AllParameters &);
+
+  private:
+    /// Timing of a member, recorded on the first process of its group.
+    struct MemberRecord
+    {
+      unsigned int member;
+      double setup_time;
+      double run_time;
+      bool reused;
+    };
+
+    const std::vector<Parameters::AllParameters> members;
+    const unsigned int n_groups;
+    const Signature signature;
+
+    unsigned int group;
+    MPI_Comm group_communicator;
+    std::vector<unsigned int> group_members;
+    std::vector<MemberRecord> records;
+
+    /// Wall time of the whole ensemble.
+    double wall_time;
+  };
+} // namespace MPI
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef FIELDSPLIT_SOLVER
+#define FIELDSPLIT_SOLVER
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/petsc_block_sparse_matrix.h>
+#include <deal.II/lac/petsc_block_vector.h>
+#include <deal.II/lac/solver_control.h>
+#include <petscksp.h>
+
+#include <string>
+
+using namespace dealii;
+
+/** \brief Solve a velocity-pressure block system with PETSc PCFIELDSPLIT.
+ * The blocks of the deal.II block matrix are wrapped in a PETSc nested
+ * matrix without copying, whose row index sets define the velocity field
+ * "u" and the pressure field "p". The system is solved by FGMRES
+ * preconditioned by PCFIELDSPLIT, which can be tuned at runtime through the
+ * PETSc options with the prefix "fluid_", e.g.
+ * -fluid_pc_fieldsplit_schur_fact_type upper or
+ * -fluid_fieldsplit_u_pc_type hypre. The options can be given in the
+ * parameter file or on the command line.
+ */
+class FieldSplitSolver
+{
+public:
+  /**
+   * Standardized data struct to pipe additional flags to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const std::string &split_type = "Schur",
+                   const std::string &options = "");
+
+    /**
+     * How the splits are combined: Schur, Multiplicative or Additive.
+     */
+    std::string split_type;
+
+    /**
+     * PETSc options inserted before the solver is set up.
+     */
+    std::string options;
+  };
+
+  /**
+   * Constructor. Nothing is set up before the first solve.
+   */
+  FieldSplitSolver(const AdditionalData &additional_data = AdditionalData());
+
+  FieldSplitSolver(const FieldSplitSolver &) = delete;
+
+  FieldSplitSolver &operator=(const FieldSplitSolver &) = delete;
+
+  ~FieldSplitSolver();
+
+  /**
+   * Destroy the PETSc objects. This must be called when the matrix is
+   * reinitialized, because the nested matrix references its blocks.
+   */
+  void clear();
+
+  /**
+   * Whether the preconditioner has been set up.
+   */
+  bool empty() const;
+
+  /**
+   * Solve Ax = b with x as the initial guess. The tolerance and the maximum
+   * number of iterations are taken from the solver control, which is updated
+   * with the final iteration count and residual. Unless asked to update the
+   * preconditioner, the one of the previous solve is reused.
+   */
+  void solve(const PETScWrappers::MPI::BlockSparseMatrix &A,
+             PETScWrappers::MPI::BlockVector &x,
+             const PETScWrappers::MPI::BlockVector &b,
+             SolverControl &solver_control,
+             const bool update_preconditioner = true);
+
+private:
+  /// Create the nested matrix, its vectors and the solver.
+  void setup(const PETScWrappers::MPI::BlockSparseMatrix &A);
+
+  AdditionalData additional_data;
+
+  Mat nested_matrix;
+  Vec solution;
+  Vec rhs;
+  KSP ksp;
+};
+
+#endif
@@ -48,8 +48,10 @@ private:                                                                       \
   using FluidSolver<dim>::locally_relevant_scalar_dofs;                        \
   using FluidSolver<dim>::times_and_names;                                     \
   using FluidSolver<dim>::time;                                                \
+  using FluidSolver<dim>::time_step_controller;                                \
   using FluidSolver<dim>::timer;                                               \
   using FluidSolver<dim>::timer2;                                              \
+  using FluidSolver<dim>::field_split_solver;                                  \
   using FluidSolver<dim>::cell_property;                                       \
   using FluidSolver<dim>::hard_coded_boundary_values;                          \
   using FluidSolver<dim>::body_force;                                          \
@@ -87,10 +89,15 @@ private:                                                                       \
   using SharedSolidSolver<dim>::this_mpi_process;                              \
   using SharedSolidSolver<dim>::pcout;                                         \
   using SharedSolidSolver<dim>::time;                                          \
+  using SharedSolidSolver<dim>::time_step_controller;                          \
   using SharedSolidSolver<dim>::timer;                                         \
   using SharedSolidSolver<dim>::locally_owned_dofs;                            \
   using SharedSolidSolver<dim>::locally_owned_scalar_dofs;                     \
   using SharedSolidSolver<dim>::locally_relevant_dofs;                         \
+  using SharedSolidSolver<dim>::penetration_criterion;                         \
+  using SharedSolidSolver<dim>::penetration_direction;                         \
+  using SharedSolidSolver<dim>::contact_vertices;                              \
+  using SharedSolidSolver<dim>::reference_cache;                               \
   using SharedSolidSolver<dim>::times_and_names
 
 #endif
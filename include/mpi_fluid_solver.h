@@ -51,15 +51,18 @@
 #include <deal.II/numerics/matrix_tools.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <deal.II/distributed/fully_distributed_tria.h>
 #include <deal.II/distributed/grid_refinement.h>
 #include <deal.II/distributed/solution_transfer.h>
 #include <deal.II/distributed/tria.h>
+#include <deal.II/distributed/tria_base.h>
 
 #include <experimental/filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
+#include "fieldsplit_solver.h"
 #include "inheritance_macros.h"
 #include "parameters.h"
 #include "utilities.h"
@@ -86,8 +89,15 @@ namespace Fluid
       //! FSI solver need access to the private members of this solver.
       friend ::MPI::FSI<dim>;
 
-      //! Constructor.
-      FluidSolver(parallel::distributed::Triangulation<dim> &,
+      /*! \brief Constructor.
+       *
+       * The mesh is either a parallel::distributed::Triangulation, or a
+       * parallel::fullydistributed::Triangulation read from a partitioned
+       * mesh with Utils::GridCreator::read_partitioned. The latter is used
+       * as it is: it can not be refined, and its checkpoints can only be
+       * loaded with the same partitions.
+       */
+      FluidSolver(parallel::DistributedTriangulationBase<dim> &,
                   const Parameters::AllParameters &);
 
       //! Run the simulation.
@@ -166,9 +176,19 @@ namespace Fluid
       /// Load from checkpoint to restart.
       bool load_checkpoint();
 
+      /// Save the solution, the time and the outputs at the beginning of a
+      /// time step. The solvers that keep more state over the time steps
+      /// save it as well.
+      virtual void save_state();
+
+      /// Return to the state saved last, so that the time step is repeated.
+      virtual void restore_state();
+
       std::vector<types::global_dof_index> dofs_per_block;
 
-      parallel::distributed::Triangulation<dim> &triangulation;
+      parallel::DistributedTriangulationBase<dim> &triangulation;
+      /// Whether the triangulation is a fully distributed one.
+      const bool fully_distributed;
       FESystem<dim> fe;
       FE_Q<dim> scalar_fe;
       DoFHandler<dim> dof_handler;
@@ -226,9 +246,20 @@ namespace Fluid
       mutable std::vector<std::pair<double, std::string>> times_and_names;
 
       Utils::Time time;
+      Utils::TimeStepController time_step_controller;
       mutable TimerOutput timer;
       mutable TimerOutput timer2;
 
+      /// The state saved by save_state.
+      PETScWrappers::MPI::BlockVector saved_solution;
+      PETScWrappers::MPI::BlockVector saved_increment;
+      Utils::Time::State saved_time;
+      unsigned int n_saved_outputs;
+
+      /// PETSc PCFIELDSPLIT solver, used instead of the block preconditioners
+      /// if told so in the input parameters.
+      FieldSplitSolver field_split_solver;
+
       CellDataStorage<
         typename parallel::distributed::Triangulation<dim>::cell_iterator,
         CellProperty>
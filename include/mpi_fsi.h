@@ -27,9 +27,35 @@ extern template class Utils::SPHInterpolator<3,
                                              PETScWrappers::MPI::BlockVector>;
 extern template class Utils::CellLocator<2, DoFHandler<2, 2>>;
 extern template class Utils::CellLocator<3, DoFHandler<3, 3>>;
+extern template class Utils::CellHints<2>;
+extern template class Utils::CellHints<3>;
 
 namespace MPI
 {
+  /*! \brief Communicators to construct the fluid and solid solvers with.
+   *
+   * If "Solid processes" is 0, both of them are MPI_COMM_WORLD and the two
+   * solvers run one after the other on all the processes. Otherwise the last
+   * "Solid processes" ranks form the solid group and the rest the fluid
+   * group. Every process still constructs both solvers: the solid solver on
+   * a fluid process is a serial copy that is used in the coupling, and the
+   * fluid solver on a solid process is never set up.
+   * This object must outlive the solvers.
+   */
+  class SplitCommunicators
+  {
+  public:
+    SplitCommunicators(const Parameters::AllParameters &);
+    SplitCommunicators(const SplitCommunicators &) = delete;
+    ~SplitCommunicators();
+
+    MPI_Comm fluid;
+    MPI_Comm solid;
+
+  private:
+    MPI_Comm group;
+  };
+
   template <int dim>
   class FSI
   {
@@ -51,9 +77,16 @@ namespace MPI
     /// Collect all the boundary lines in solid triangulation.
     void collect_solid_boundaries();
 
-    /// Setup the hints for searching for each fluid cell.
+    /// Setup the hints for searching for each fluid cell. The hints start
+    /// from the stored solid cells where there are any.
     void setup_cell_hints();
 
+    /// Write the solid cells the hints point to along with a checkpoint.
+    void save_cell_hints(const int output_index) const;
+
+    /// Read the hints written at the current time step, if any.
+    void load_cell_hints();
+
     /// Define a smallest rectangle (or hex in 3d) that contains the solid.
     void update_solid_box();
 
@@ -109,18 +142,94 @@ namespace MPI
     void find_fluid_bc();
 
     /*! \brief Apply contact model specific to VF simulation
+     *
+     * Only used if the solid solver does not enforce contact in its own
+     * Newton loop, see SharedSolidSolver::assembles_contact.
      */
     void apply_contact_model(bool);
 
     /// Mesh adaption.
     void refine_mesh(const unsigned int, const unsigned int);
 
+    /*! \brief Number the solid dofs independent of the partitioning.
+     *
+     *  The solid group and the serial solid copies on the fluid processes
+     * partition the solid mesh differently, hence number the dofs
+     * differently. The dofs are exchanged in the order in which they are
+     * first met in a loop over the active cells, which is the same for both.
+     */
+    void setup_solid_dof_permutation();
+
+    /// Send the FSI stress rows from the fluid group to the solid group.
+    void send_fsi_stress();
+
+    /// Send the solid solution from the solid group to the fluid group.
+    void send_solid_solution();
+
+    /*! \brief Take the smaller of the next time step sizes of the solvers.
+     *
+     *  A solver that does not adapt its time step size keeps the current
+     * one, hence the time step size can only decrease in that case.
+     */
+    void synchronize_time_step();
+
+    /// Print how busy the fluid and solid processes were in run().
+    void print_utilization(const double);
+
+    /// The solid solutions that the fluid is coupled to.
+    std::vector<PETScWrappers::MPI::Vector *> coupled_solid_solutions();
+
+    /*! \brief Advance the solid by one fluid time step.
+     *
+     *  With "Solid steps per fluid step" larger than 1, the solid takes that
+     * many substeps, in which the fluid traction is extrapolated linearly
+     * from the last two fluid time steps.
+     */
+    void run_solid_step(bool);
+
+    /*! \brief Interpolate the solid solutions between synchronization steps.
+     *
+     *  With "Fluid steps per solid step" larger than 1, the solid leads the
+     * fluid by one solid time step. The fluid sees the solid solutions
+     * interpolated linearly in time between the beginning and the end of it,
+     * the argument being the fraction of the solid time step that is
+     * covered.
+     */
+    void interpolate_solid_solution(const double);
+
+    /// The fluid traction on the solid as one vector, and back.
+    Vector<double> gather_fsi_stress() const;
+    void scatter_fsi_stress(const Vector<double> &);
+
+    /// Save the solver states at the beginning of a time step, to which the
+    /// coupling iterations return.
+    void cache_coupling_state();
+
+    /*! \brief Check the convergence of the coupling iterations.
+     *
+     *  The fluid traction of the fluid step just taken is passed to the
+     * coupling accelerator, which updates the traction the solid is loaded
+     * with. Unless the traction has converged or the max number of
+     * iterations is reached, the solvers are reset to the beginning of the
+     * time step. Returns whether to iterate again.
+     */
+    bool iterate_coupling(const unsigned int);
+
+    /// Print the estimated time saved by taking different time step sizes
+    /// in the fluid and the solid, given the numbers of steps taken.
+    void print_multirate_savings(const unsigned int, const unsigned int);
+
     // For MPI FSI, the solid solver uses shared trianulation. i.e.,
     // each process has the entire graph, for the ease of looping.
     Fluid::MPI::FluidSolver<dim> &fluid_solver;
     Solid::MPI::SharedSolidSolver<dim> &solid_solver;
     Parameters::AllParameters parameters;
     MPI_Comm mpi_communicator;
+    // Number of processes in the solid group, 0 if the fluid and solid
+    // share all the processes.
+    unsigned int n_solid_processes;
+    bool is_fluid_process;
+    bool is_solid_process;
     ConditionalOStream pcout;
     Utils::Time time;
     mutable TimerOutput timer;
@@ -138,11 +247,8 @@ namespace MPI
     // searching.
     std::vector<bool> vertices_mask;
 
-    // Cell storage that stores hints of cell searching from last time step.
-    CellDataStorage<
-      typename parallel::distributed::Triangulation<dim>::active_cell_iterator,
-      typename DoFHandler<dim>::active_cell_iterator>
-      cell_hints;
+    // Hints of cell searching from last time step.
+    Utils::CellHints<dim> cell_hints;
 
     // A function that determines if a point is penetrating the fluid domain
     std::shared_ptr<std::function<double(const Point<dim> &)>>
@@ -150,6 +256,24 @@ namespace MPI
     Tensor<1, dim> penetration_direction;
 
     bool use_dirichlet_bc;
+
+    // Map from the solid dofs to the order they are exchanged in.
+    std::vector<types::global_dof_index> solid_dof_permutation;
+
+    // Wall time spent in exchanging the coupling data, including waiting
+    // for the other group.
+    double coupling_wait_time;
+
+    // Solid solutions at the beginning and at the end of the current solid
+    // time step, when the fluid takes several steps in it.
+    std::vector<Vector<double>> solid_solution_begin;
+    std::vector<Vector<double>> solid_solution_end;
+
+    // Fluid traction of the previous fluid time step, when the solid takes
+    // several steps in one fluid time step.
+    std::vector<Vector<double>> previous_fsi_stress_rows;
+
+    Utils::CouplingAccelerator coupling_accelerator;
   };
 } // namespace MPI
 
@@ -160,6 +160,11 @@ namespace Solid
                                    //! first iteration.
       double normalized_error_update; //!< error_update / initial_error_update
 
+      /// Work vectors of run_one_step, kept over the time steps.
+      PETScWrappers::MPI::Vector predicted_displacement;
+      PETScWrappers::MPI::Vector newton_update;
+      PETScWrappers::MPI::Vector scratch_vector;
+
       // Reture the residual in the Newton iteration
       void get_error_residual(double &);
       // Compute the l2 norm of the solution increment
@@ -39,7 +39,7 @@ namespace Fluid
 
     public:
       //! Constructor.
-      InsIM(parallel::distributed::Triangulation<dim> &,
+      InsIM(parallel::DistributedTriangulationBase<dim> &,
             const Parameters::AllParameters &);
       ~InsIM(){};
       //! Run the simulation.
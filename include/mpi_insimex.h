@@ -35,7 +35,7 @@ namespace Fluid
 
     public:
       //! Constructor.
-      InsIMEX(parallel::distributed::Triangulation<dim> &,
+      InsIMEX(parallel::DistributedTriangulationBase<dim> &,
               const Parameters::AllParameters &);
       ~InsIMEX(){};
       //! Run the simulation.
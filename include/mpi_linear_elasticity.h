@@ -83,6 +83,11 @@ namespace Solid
       void run_one_step(bool first_step);
 
       std::vector<LinearElasticMaterial<dim>> material;
+
+      /// Work vectors of run_one_step, kept over the time steps.
+      PETScWrappers::MPI::Vector effective_rhs;
+      PETScWrappers::MPI::Vector predicted_displacement;
+      PETScWrappers::MPI::Vector stiffness_force;
     };
   } // namespace MPI
 } // namespace Solid
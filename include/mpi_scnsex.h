@@ -28,6 +28,14 @@ namespace Fluid
      *
      * CG solver is used for both pressure and velocity matrices as they only
      * consist of the mass and viscosity components.
+     *
+     * On graded meshes the cells can be advanced with local time steps: they
+     * are grouped by their CFL limit into levels, level \f$l\f$ takes
+     * \f$2^l\f$ substeps per time step. The levels are advanced coarse first.
+     * A level solves for its own dofs only, the dofs it shares cells with are
+     * constrained to their values at the end of its substep, interpolated in
+     * time on the coarser levels and frozen on the finer ones. A dof belongs
+     * to the finest level of the cells around it.
      */
     template <int dim>
     class SCnsEX : public FluidSolver<dim>
@@ -36,9 +44,9 @@ namespace Fluid
 
     public:
       //! Constructor.
-      SCnsEX(parallel::distributed::Triangulation<dim> &,
+      SCnsEX(parallel::DistributedTriangulationBase<dim> &,
              const Parameters::AllParameters &);
-      ~SCnsEX(){};
+      ~SCnsEX();
       //! Run the simulation.
       void run();
 
@@ -62,7 +70,10 @@ namespace Fluid
        * used to determine whether assemble velocity or pressure, and whether to
        * assemble the matrix or only the rhs.
        */
-      void assemble(const bool assemble_system, const bool assemble_velocity);
+      void assemble(
+        const bool assemble_system,
+        const bool assemble_velocity,
+        const unsigned int time_level = numbers::invalid_unsigned_int);
 
       /*! \brief Solve the linear system using CG
        *
@@ -70,7 +81,20 @@ namespace Fluid
        * used in assembly must be used again, to set the solution to the right
        * value at the constrained dofs.
        */
-      std::pair<unsigned int, double> solve(const bool solver_for_velocity);
+      std::pair<unsigned int, double>
+      solve(const bool solver_for_velocity,
+            const unsigned int time_level = numbers::invalid_unsigned_int);
+
+      /*! \brief Iterate the velocity and pressure solves until they converge.
+       *
+       *  Without a time level all the cells are advanced by the time step,
+       * starting from present_solution. Otherwise only the dofs of the level
+       * are, starting from level_old_solution. The result is left in
+       * evaluation_point, the number of iterations is returned.
+       */
+      unsigned int
+      iterate(const bool assemble_system,
+              const unsigned int time_level = numbers::invalid_unsigned_int);
 
       /*! \brief Run the simulation for one time step.
        *
@@ -82,6 +106,56 @@ namespace Fluid
       void run_one_step(bool apply_nonzero_constraints,
                         bool assemble_system) override;
 
+      /*! \brief Estimate the stable time step size at CFL = 1.
+       *
+       *  Acoustic waves travel at the sound speed relative to the flow, so
+       * the minimum over the cells of the smallest vertex distance divided by
+       * the velocity degree and \f$|v| + c\f$ is used.
+       */
+      double stable_time_step() const;
+
+      /// The stable time step size of a cell at CFL = 1.
+      double cell_stable_time_step(
+        const typename DoFHandler<dim>::active_cell_iterator &,
+        FEValues<dim> &) const;
+
+      /// The sound speed of the isentropic continuity equation.
+      double sound_speed() const;
+
+      /// The level whose substeps keep a cell with the given stable time step
+      /// size below the target CFL number.
+      unsigned int time_level(const double stable_step) const;
+
+      /// The step size of a time level.
+      double level_time_step(const unsigned int level) const;
+
+      /// Assign the cells and dofs to the time levels.
+      void setup_time_levels();
+
+      /*! \brief Set up the constraints and the old solution of a level step.
+       *
+       *  The dofs of the other levels on the cells of the level become
+       * inhomogeneous constraints, and the cells are marked for the assembly.
+       */
+      void setup_level_step(const unsigned int level,
+                            const unsigned int substep);
+
+      /// Advance all the levels by one time step, return the max number of
+      /// iterations of the level steps.
+      unsigned int advance_time_levels();
+
+      /*! \brief Partition weight of a cell.
+       *
+       *  The work of a cell is proportional to the number of its substeps.
+       * The solution is not available during repartitioning, so the level is
+       * estimated from the sound speed alone.
+       */
+      unsigned int cell_weight(
+        const typename parallel::distributed::Triangulation<dim>::cell_iterator
+          &,
+        const typename parallel::distributed::Triangulation<dim>::CellStatus)
+        const;
+
       /*! The intermiediate solution within every time step, generated from each
        * iteration.
        */
@@ -115,6 +189,38 @@ namespace Fluid
        * some time and does not require to re-calculate the value anymore.
        */
       std::map<unsigned int, double> boundary_condition_time_limits;
+
+      /// The time step size the system matrix was assembled with.
+      double assembled_delta_t;
+
+      /// Number of time levels, 1 without local time stepping.
+      const unsigned int n_time_levels;
+
+      /// The finest time level any cell is on.
+      unsigned int finest_time_level;
+
+      /// Time levels of the locally relevant dofs, in the order of
+      /// locally_relevant_dofs. 0 is the coarsest level.
+      std::vector<unsigned int> dof_time_levels;
+
+      /// Whether a cell has dofs on the level being advanced.
+      std::vector<bool> level_cells;
+
+      /// Locally owned dofs on no cell of the level being advanced, their rows
+      /// of the level system are identities.
+      std::vector<types::global_dof_index> idle_dofs;
+
+      /// Constraints of the level being advanced.
+      AffineConstraints<double> level_constraints;
+
+      /// Solution at the start of the current step of every level.
+      std::vector<PETScWrappers::MPI::BlockVector> level_start_solutions;
+
+      /// Solution at the start of the step of the level being advanced.
+      PETScWrappers::MPI::BlockVector level_old_solution;
+
+      /// Connection to the partition weight signal of the triangulation.
+      boost::signals2::connection weight_connection;
     };
   } // namespace MPI
 } // namespace Fluid
@@ -2,6 +2,7 @@
 #define MPI_SCNSIM
 
 #include "mpi_fluid_solver.h"
+#include "preconditioner_mixed_precision.h"
 #include "preconditioner_pilut.h"
 
 namespace Fluid
@@ -38,7 +39,7 @@ namespace Fluid
 
     public:
       //! Constructor.
-      SCnsIM(parallel::distributed::Triangulation<dim> &,
+      SCnsIM(parallel::DistributedTriangulationBase<dim> &,
              const Parameters::AllParameters &);
       ~SCnsIM(){};
       //! Run the simulation.
@@ -46,6 +47,7 @@ namespace Fluid
 
     private:
       class BlockIncompSchurPreconditioner;
+      class JacobianFreeOperator;
 
       /// Specify the sparsity pattern and reinit matrices and vectors based on
       /// the dofs and constraints.
@@ -53,25 +55,30 @@ namespace Fluid
 
       /*! \brief Assemble the system matrix, mass mass matrix, and the RHS.
        *
-       *  Since backward Euler method is used, the linear system must be
-       * reassembled
-       *  at every Newton iteration. The Dirichlet BCs are applied at the same
-       * time
+       *  The RHS is the negative residual at the evaluation point. The
+       * Dirichlet BCs are applied at the same time
        *  as the cell matrix and rhs are distributed to the global matrix and
        * rhs, which is optimal according to the deal.II documentation. The
-       * boolean argument is used to determine whether nonzero constraints or
-       * zero constraints should be used.
+       * first boolean argument is used to determine whether nonzero
+       * constraints or zero constraints should be used. If the second one is
+       * false, only the RHS is assembled, which requires zero constraints
+       * since the inhomogeneities are applied through the cell matrix.
        */
-      void assemble(const bool use_nonzero_constraints);
+      void assemble(const bool use_nonzero_constraints,
+                    const bool assemble_matrix = true);
 
       /*! \brief Solve the linear system using FGMRES solver plus block
        * preconditioner.
        *
        *  After solving the linear system, the same AffineConstraints<double> as
        * used in assembly must be used again, to set the solution to the right
-       * value at the constrained dofs.
+       * value at the constrained dofs. The preconditioner is only rebuilt if
+       * the second argument is true, otherwise the one of the last assembled
+       * Jacobian is reused. With JFNK, the Jacobian is only used in the
+       * preconditioner.
        */
-      std::pair<unsigned int, double> solve(const bool use_nonzero_constraints);
+      std::pair<unsigned int, double> solve(const bool use_nonzero_constraints,
+                                            const bool update_preconditioner);
 
       /*! \brief Run the simulation for one time step.
        *
@@ -85,6 +92,24 @@ namespace Fluid
       void run_one_step(bool apply_nonzero_constraints,
                         bool assemble_system = true) override;
 
+      /*! \brief Choose the next time step size.
+       *
+       *  The local truncation error of backward Euler,
+       * \f$\frac{\Delta t^2}{2}\ddot{u}\f$, is estimated from the velocity
+       * increments of the current and the last time step. The arguments are
+       * the new solution, its increment (with either sign) and the number of
+       * Newton iterations taken.
+       */
+      void adapt_time_step(const PETScWrappers::MPI::BlockVector &,
+                           const PETScWrappers::MPI::BlockVector &,
+                           const unsigned int);
+
+      /// The step size history of the time step controller is saved too.
+      void save_state() override;
+
+      /// The Jacobian of the repeated step is assembled anew.
+      void restore_state() override;
+
       PETScWrappers::MPI::SparseMatrix Abs_A_matrix;
       PETScWrappers::MPI::SparseMatrix schur_matrix;
       PETScWrappers::MPI::SparseMatrix B2pp_matrix;
@@ -100,6 +125,46 @@ namespace Fluid
       /// The BlockIncompSchurPreconditioner for the entire system.
       std::shared_ptr<BlockIncompSchurPreconditioner> preconditioner;
 
+      /// The time step size of the last step, 0 before the first one.
+      double previous_delta_t;
+      double saved_previous_delta_t;
+
+      /// The time step size the Jacobian was assembled with.
+      double jacobian_delta_t;
+
+      /// Newton iterations since the Jacobian was assembled.
+      unsigned int jacobian_age;
+
+      /// Numbers of assemblies of the Jacobian and of the residual alone.
+      unsigned int n_jacobian_assemblies;
+      unsigned int n_residual_assemblies;
+
+      /// Picks the Hypre ILU settings of the preconditioner.
+      ILUAutoTuner ilu_tuner;
+
+      /*! \brief The Jacobian-vector product by finite differences for JFNK.
+       *
+       *  \f$Jv \approx (R(u + \epsilon v) - R(u)) / \epsilon\f$, where R is
+       * the residual at the evaluation point u, which is assembled for every
+       * product. The constrained dofs have zero residual, they are mapped by
+       * the identity instead.
+       */
+      class JacobianFreeOperator : public Subscriptor
+      {
+      public:
+        /// Linearize around the evaluation point and RHS of the solver.
+        JacobianFreeOperator(SCnsIM<dim> &);
+
+        void vmult(PETScWrappers::MPI::BlockVector &dst,
+                   const PETScWrappers::MPI::BlockVector &src) const;
+
+      private:
+        SCnsIM<dim> &solver;
+        PETScWrappers::MPI::BlockVector point;
+        PETScWrappers::MPI::BlockVector rhs;
+        PETScWrappers::MPI::BlockVector constrained_dofs;
+      };
+
       /** \brief Incomplete Schur Complement Block Preconditioner
        * The format of this preconditioner is as follow:
        *
@@ -127,7 +192,9 @@ namespace Fluid
           const PETScWrappers::MPI::BlockSparseMatrix &system,
           PETScWrappers::MPI::SparseMatrix &absA,
           PETScWrappers::MPI::SparseMatrix &schur,
-          PETScWrappers::MPI::SparseMatrix &B2pp);
+          PETScWrappers::MPI::SparseMatrix &B2pp,
+          const HypreILUSettings &ilu_settings = HypreILUSettings(),
+          const bool mixed_precision = false);
 
         /// The matrix-vector multiplication must be defined.
         void vmult(PETScWrappers::MPI::BlockVector &dst,
@@ -167,8 +234,18 @@ namespace Fluid
         const SmartPointer<PETScWrappers::MPI::SparseMatrix> schur_matrix;
         const SmartPointer<PETScWrappers::MPI::SparseMatrix> B2pp_matrix;
 
-        PreconditionEuclid Pvv_inverse;
-        PreconditionEuclid B2pp_inverse;
+        /// Use the single precision factors instead of Euclid.
+        const bool mixed_precision;
+
+        /// The Hypre ILU factors of Avv and B2pp.
+        std::shared_ptr<PETScWrappers::PreconditionerBase> Pvv_inverse;
+        std::shared_ptr<PETScWrappers::PreconditionerBase> B2pp_inverse;
+        PreconditionMixedPrecision Pvv_inverse_float;
+        PreconditionMixedPrecision B2pp_inverse_float;
+
+        /// Apply Pvv^-1 with the factors in use.
+        void apply_Pvv_inverse(PETScWrappers::MPI::Vector &dst,
+                               const PETScWrappers::MPI::Vector &src) const;
 
         std::shared_ptr<SchurComplementTpp> Tpp;
         // iteration counter for solving Tpp
@@ -180,7 +257,7 @@ namespace Fluid
             TimerOutput &timer2,
             const std::vector<IndexSet> &owned_partitioning,
             const PETScWrappers::MPI::BlockSparseMatrix &system,
-            const PETScWrappers::PreconditionerBase &Pvvinv);
+            const BlockIncompSchurPreconditioner &preconditioner);
           void vmult(PETScWrappers::MPI::Vector &dst,
                      const PETScWrappers::MPI::Vector &src) const;
 
@@ -188,7 +265,7 @@ namespace Fluid
           TimerOutput &timer2;
           const SmartPointer<const PETScWrappers::MPI::BlockSparseMatrix>
             system_matrix;
-          const PETScWrappers::PreconditionerBase *Pvv_inverse;
+          const BlockIncompSchurPreconditioner *preconditioner;
           PETScWrappers::MPI::BlockVector dumb_vector;
         };
       };
@@ -0,0 +1,108 @@
+#ifndef SHARED_EXPLICIT_HYPERELASTIC_SOLVER
+#define SHARED_EXPLICIT_HYPERELASTIC_SOLVER
+
+#include "mpi_shared_hyper_elasticity.h"
+
+namespace Internal
+{
+  extern template class PointHistory<2>;
+  extern template class PointHistory<3>;
+} // namespace Internal
+
+namespace Solid
+{
+  namespace MPI
+  {
+    using namespace dealii;
+
+    extern template class SharedSolidSolver<2>;
+    extern template class SharedSolidSolver<3>;
+
+    /** \brief Explicit parallel solver for hyperelastic materials
+     *
+     * The central difference scheme is used for time-discretization,
+     * written in the velocity Verlet form so that the velocity is available
+     * at the same time levels as the displacement:
+     * \f$ v_{n+1/2} = v_n + \frac{h}{2}a_n \f$,
+     * \f$ u_{n+1} = u_n + h v_{n+1/2} \f$,
+     * \f$ a_{n+1} = M_L^{-1}f(u_{n+1}) \f$,
+     * \f$ v_{n+1} = v_{n+1/2} + \frac{h}{2}a_{n+1} \f$.
+     * \f$ M_L \f$ is the row-sum lumped mass matrix and \f$ f \f$ is the
+     * residual of the internal, body and boundary forces, therefore no
+     * tangent matrix is assembled and no linear system is solved.
+     *
+     * The scheme is only conditionally stable. The critical time step is
+     * estimated from the smallest element size and the dilatational wave
+     * speed, and every time step is subcycled so that the substep does not
+     * exceed a fraction of it. This makes the solver a drop-in replacement
+     * of SharedHyperElasticity in FSI simulations, where the time step is
+     * dictated by the fluid and is usually small.
+     *
+     * The kinematics and the NeoHookean material are cached at the
+     * quadrature points with the same Internal::PointHistory as the implicit
+     * solver. Artificial damping is not supported.
+     */
+    template <int dim>
+    class SharedExplicitHyperElasticity : public SharedSolidSolver<dim>
+    {
+      MPISharedSolidSolverInheritanceMacro();
+
+    public:
+      SharedExplicitHyperElasticity(Triangulation<dim> &,
+                                    const Parameters::AllParameters &,
+                                    MPI_Comm = MPI_COMM_WORLD);
+      ~SharedExplicitHyperElasticity() {}
+
+      /// Return the estimated critical time step.
+      double get_critical_time_step() const { return critical_time_step; }
+
+    private:
+      void initialize_system() override;
+
+      virtual void update_strain_and_stress() override;
+
+      /**
+       * Update the quadrature point history with the current displacement
+       * and assemble the residual force into system_rhs. At the initial
+       * step, the lumped mass matrix is assembled and the critical time step
+       * is estimated as well.
+       */
+      void assemble_system(bool) override;
+
+      /**
+       * Compute the acceleration from the residual force with the inverse
+       * of the lumped mass, and apply the constraints to it.
+       */
+      void compute_acceleration(PETScWrappers::MPI::Vector &);
+
+      /**
+       * Estimate the critical time step as the minimum over the cells of
+       * the smallest vertex distance divided by the polynomial degree and
+       * the dilatational wave speed \f$ \sqrt{(\kappa + 4\mu/3)/\rho} \f$.
+       */
+      void estimate_critical_time_step();
+
+      /** Set up the quadrature point history. */
+      void setup_qph();
+
+      /// Run one time step, which may consist of several substeps.
+      void run_one_step(bool);
+
+      /**
+       * We store a PointHistory structure at every quadrature point,
+       * so that kinematics information like F as well as material properties
+       * can be cached.
+       */
+      CellDataStorage<typename Triangulation<dim>::cell_iterator,
+                      Internal::PointHistory<dim>>
+        quad_point_history;
+
+      /// Inverse of the lumped mass, zero at the constrained dofs.
+      PETScWrappers::MPI::Vector inverse_lumped_mass;
+
+      double critical_time_step; //!< Estimated stable time step.
+    };
+  } // namespace MPI
+} // namespace Solid
+
+#endif
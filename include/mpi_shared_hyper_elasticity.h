@@ -9,6 +9,8 @@
 #include <deal.II/physics/elasticity/kinematics.h>
 #include <deal.II/physics/elasticity/standard_tensors.h>
 
+#include <deque>
+
 #include "mpi_shared_solid_solver.h"
 #include "neo_hookean.h"
 
@@ -95,16 +97,46 @@ namespace Solid
 
     public:
       SharedHyperElasticity(Triangulation<dim> &,
-                            const Parameters::AllParameters &);
+                            const Parameters::AllParameters &,
+                            MPI_Comm = MPI_COMM_WORLD);
       ~SharedHyperElasticity() {}
 
+      /// Contact is enforced by an augmented Lagrangian in the Newton loop.
+      bool assembles_contact() const override { return true; }
+
     private:
       void initialize_system() override;
 
       virtual void update_strain_and_stress() override;
 
       /** Assemble the lhs and rhs at the same time. */
-      void assemble_system(bool);
+      void assemble_system(bool initial_step) override
+      {
+        assemble_system(initial_step, true);
+      }
+
+      /**
+       * Assemble the rhs, and the lhs if the second argument is true.
+       * If not, the previously assembled tangent is kept, which is used by
+       * the modified Newton and L-BFGS solvers.
+       */
+      void assemble_system(bool, bool);
+
+      /**
+       * Add the penalty contact forces and their tangent at the active
+       * contact vertices, given the localized current displacement.
+       * The active set is updated every time this is called, i.e.,
+       * once per Newton iteration. Vertices with an open gap are inactive.
+       */
+      void assemble_contact(const Vector<double> &, bool);
+
+      /**
+       * Augment the contact multipliers with the penalty forces of the
+       * converged displacement, and release those of the vertices whose gap
+       * has opened. Returns true if the penetration still exceeds the
+       * tolerance, in which case the Newton iteration continues.
+       */
+      bool update_contact_multipliers();
 
       /** Set up the quadrature point history. */
       void setup_qph();
@@ -120,6 +152,15 @@ namespace Solid
       /// Run one time step.
       void run_one_step(bool);
 
+      /**
+       * Compute the L-BFGS update from the residual with the two-loop
+       * recursion, using the current tangent as the initial inverse Hessian.
+       * Returns the number of CG iterations and the final residual.
+       */
+      std::pair<unsigned int, double>
+      solve_lbfgs(const PETScWrappers::MPI::Vector &,
+                  PETScWrappers::MPI::Vector &);
+
       /**
        * We store a PointHistory structure at every quadrature point,
        * so that kinematics information like F as well as material properties
@@ -139,6 +180,18 @@ namespace Solid
                                    //! first iteration.
       double normalized_error_update; //!< error_update / initial_error_update
 
+      /// Work vectors of run_one_step, kept over the time steps.
+      PETScWrappers::MPI::Vector predicted_displacement;
+      PETScWrappers::MPI::Vector newton_update;
+      PETScWrappers::MPI::Vector scratch_vector;
+      PETScWrappers::MPI::Vector previous_rhs;
+      PETScWrappers::MPI::Vector step_displacement;
+
+      unsigned int n_active_contacts; //!< Number of active contact vertices.
+
+      /// L-BFGS history of solution increments and residual decrements.
+      std::deque<PETScWrappers::MPI::Vector> lbfgs_s, lbfgs_y;
+
       // Reture the residual in the Newton iteration
       void get_error_residual(double &);
       // Compute the l2 norm of the solution increment
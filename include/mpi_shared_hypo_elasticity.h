@@ -34,7 +34,8 @@ namespace Solid
       SharedHypoElasticity(Triangulation<dim> &,
                            const Parameters::AllParameters &,
                            double dx,
-                           double hdx);
+                           double hdx,
+                           MPI_Comm = MPI_COMM_WORLD);
       ~SharedHypoElasticity() {}
 
     private:
@@ -52,23 +53,89 @@ namespace Solid
 
       virtual bool load_checkpoint() override;
 
+      /// The particles and quadrature points are saved with the solutions.
+      virtual void save_state() override;
+
+      virtual void restore_state() override;
+
+      /**
+       * Call f with every value of the state of the local body that changes
+       * over the time steps: the kinematics, rates and density of the
+       * particles, the stress, pressure and density of the volume quadrature
+       * points and the traction on the face quadrature points.
+       */
+      template <typename Function>
+      void for_each_body_state(Function f);
+
+      /**
+       * The meshfree body of this process, made of the particles and
+       * quadrature points of the locally owned cells and a halo of
+       * surrounding cells. Only the states of the owned cells are kept after
+       * a step, the halo is overwritten by the owners before the next one.
+       */
       std::unique_ptr<body<dim>> m_body;
 
+      /// Map from the vertex index to the particle id in the local body,
+      /// -1 if the vertex is not in the local body.
       std::vector<int> vertex_mapping;
 
+      /// Determine the cells of the local body and the exchange patterns.
+      void setup_local_body();
+
       void construct_particles();
 
+      /**
+       * Copy the states of the owned particles and quadrature points to the
+       * distributed vectors, and apply the fluid traction to the face
+       * quadrature points.
+       */
       void synchronize();
 
+      /// Copy the states of the owned particles and quadrature points to the
+      /// distributed vectors.
+      void store_body_state();
+
+      /**
+       * Overwrite the halo of the local body with the states of the owners,
+       * i.e. everything the particles and quadrature points carry over the
+       * time steps: the kinematics, previous velocity, velocity rate and
+       * density of the particles and the stress, pressure and density of
+       * the quadrature points.
+       */
+      void update_ghosts();
+
       double dx;
 
       double hdx;
 
-      Vector<double> serialized_displacement;
+      /// Whether an active cell belongs to the local body.
+      std::vector<bool> in_local_body;
+
+      /// Position of every active cell in the subdomain-wise numbering,
+      /// which makes the ownership of the quadrature stresses contiguous.
+      std::vector<unsigned int> subdomain_wise_cell_index;
+
+      /// Dofs of the vertices in the local body.
+      IndexSet locally_relevant_body_dofs;
+
+      /// Global dof indices of the particles in the local body, dim per
+      /// particle.
+      std::vector<types::global_dof_index> particle_dofs;
+
+      /// Stress, pressure and density at the quadrature points, dim * dim + 2
+      /// entries per point, owned by the subdomain of the cell.
+      PETScWrappers::MPI::Vector quad_state;
+      IndexSet locally_owned_quad_state;
+      IndexSet locally_relevant_quad_state;
 
-      Vector<double> serialized_velocity;
+      /// Previous velocity, velocity rate and density of the particles, three
+      /// entries per dof at 3 * dof, owned like the dofs.
+      PETScWrappers::MPI::Vector particle_state;
+      IndexSet locally_owned_particle_state;
+      IndexSet locally_relevant_particle_state;
 
-      Vector<double> serialized_acceleration;
+      /// The local body state saved by save_state.
+      std::vector<double> saved_body_state;
     };
   } // namespace MPI
 } // namespace Solid
@@ -46,7 +46,8 @@ namespace Solid
        * Also we use a parameter handler to specify all the input parameters.
        */
       SharedLinearElasticity(Triangulation<dim> &,
-                             const Parameters::AllParameters &);
+                             const Parameters::AllParameters &,
+                             MPI_Comm = MPI_COMM_WORLD);
       /*! \brief Destructor. */
       ~SharedLinearElasticity() {}
 
@@ -66,6 +67,13 @@ namespace Solid
       void run_one_step(bool first_step);
 
       std::vector<LinearElasticMaterial<dim>> material;
+
+      /// Work vectors of run_one_step, kept over the time steps.
+      PETScWrappers::MPI::Vector effective_rhs;
+      PETScWrappers::MPI::Vector predicted_displacement;
+      PETScWrappers::MPI::Vector stiffness_force;
+      PETScWrappers::MPI::Vector predicted_velocity;
+      PETScWrappers::MPI::Vector damping_force;
     };
   } // namespace MPI
 } // namespace Solid
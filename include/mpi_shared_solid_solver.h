@@ -4,6 +4,7 @@
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/function.h>
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/quadrature_point_data.h>
 #include <deal.II/base/tensor.h>
@@ -40,6 +41,7 @@
 #include <deal.II/lac/petsc_vector.h>
 #include <deal.II/lac/precondition.h>
 #include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_gmres.h>
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/sparsity_tools.h>
 #include <deal.II/lac/vector.h>
@@ -61,6 +63,8 @@
 
 #include "inheritance_macros.h"
 #include "parameters.h"
+#include "preconditioner_mixed_precision.h"
+#include "symmetric_storage.h"
 #include "utilities.h"
 
 namespace fs = std::experimental::filesystem;
@@ -86,13 +90,119 @@ namespace Solid
       friend ::MPI::FSI<spacedim>;
 
       SharedSolidSolver(Triangulation<dim, spacedim> &,
-                        const Parameters::AllParameters &);
+                        const Parameters::AllParameters &,
+                        MPI_Comm = MPI_COMM_WORLD);
       ~SharedSolidSolver();
       void run();
       PETScWrappers::MPI::Vector get_current_solution() const;
 
+      /**
+       * Set the penetration criterion and the direction of the contact force.
+       * The criterion returns the penetration distance of a point in the
+       * current configuration, which is positive if the point penetrates.
+       */
+      void set_penetration_criterion(
+        const std::function<double(const Point<spacedim> &)> &,
+        Tensor<1, spacedim>);
+
+      /**
+       * Whether the solver enforces the contact constraint in its own
+       * nonlinear iterations. If not, FSI falls back to the explicit contact
+       * model.
+       */
+      virtual bool assembles_contact() const { return false; }
+
     protected:
       struct CellProperty;
+
+      /**
+       * A boundary vertex that is checked for contact.
+       */
+      struct ContactVertex
+      {
+        unsigned int vertex; //!< Index of the vertex in the triangulation.
+        std::vector<types::global_dof_index> dofs; //!< Displacement dofs.
+        double area;       //!< Lumped boundary area of the vertex.
+        double multiplier; //!< Augmented Lagrangian contact force.
+      };
+
+      /**
+       * Shape function values, gradients and JxW values in the reference
+       * configuration. In total Lagrangian formulations they do not change
+       * until the mesh is refined, so they are computed once instead of at
+       * every iteration. Only the nonzero component of every shape function is
+       * stored. The gradients are laid out cell by cell, quadrature point by
+       * quadrature point and direction by direction, contiguous in the dofs
+       * of the cell.
+       */
+      struct ReferenceCache
+      {
+        unsigned int n_q_points = 0;
+        unsigned int dofs_per_cell = 0;
+        /// Position of an active cell in the cache, invalid if not owned.
+        std::vector<unsigned int> cell_index;
+        std::vector<unsigned int> shape_component; //!< [dof]
+        std::vector<double> shape_values;          //!< [q][dof]
+        std::vector<double> shape_gradients;       //!< [cell][q][d][dof]
+        std::vector<double> JxW;                   //!< [cell][q]
+
+        /// The position of the cell, which must be locally owned.
+        template <typename Iterator>
+        unsigned int index(const Iterator &cell) const
+        {
+          Assert(cell_index[cell->active_cell_index()] !=
+                   numbers::invalid_unsigned_int,
+                 ExcInternalError());
+          return cell_index[cell->active_cell_index()];
+        }
+        /// The vector-valued shape function k at quadrature point q.
+        Tensor<1, spacedim> value(const unsigned int k,
+                                  const unsigned int q) const
+        {
+          Tensor<1, spacedim> phi;
+          phi[shape_component[k]] = shape_values[q * dofs_per_cell + k];
+          return phi;
+        }
+        /// The gradient of the vector-valued shape function k.
+        Tensor<2, spacedim> gradient(const unsigned int c,
+                                     const unsigned int k,
+                                     const unsigned int q) const
+        {
+          Tensor<2, spacedim> grad;
+          const double *g =
+            &shape_gradients[(std::size_t(c) * n_q_points + q) * spacedim *
+                               dofs_per_cell +
+                             k];
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              grad[shape_component[k]][d] = g[d * dofs_per_cell];
+            }
+          return grad;
+        }
+        /// Gradients of the local values u at quadrature point q.
+        Tensor<2, spacedim> function_gradient(const unsigned int c,
+                                              const Vector<double> &u,
+                                              const unsigned int q) const
+        {
+          Tensor<2, spacedim> grad;
+          const double *g =
+            &shape_gradients[(std::size_t(c) * n_q_points + q) * spacedim *
+                             dofs_per_cell];
+          for (unsigned int d = 0; d < spacedim; ++d, g += dofs_per_cell)
+            {
+              for (unsigned int k = 0; k < dofs_per_cell; ++k)
+                {
+                  grad[shape_component[k]][d] += u[k] * g[k];
+                }
+            }
+          return grad;
+        }
+        double get_JxW(const unsigned int c, const unsigned int q) const
+        {
+          return JxW[c * n_q_points + q];
+        }
+        std::size_t memory_consumption() const;
+      };
       /**
        * Set up the DofHandler, reorder the grid, sparsity pattern.
        */
@@ -122,7 +232,8 @@ namespace Solid
 
       /**
        * Solve the linear system. Returns the number of
-       * CG iterations and the final residual.
+       * CG (FGMRES with the mixed precision preconditioner) iterations and
+       * the final residual.
        */
       std::pair<unsigned int, double>
       solve(const PETScWrappers::MPI::SparseMatrix &,
@@ -150,6 +261,45 @@ namespace Solid
        */
       virtual bool load_checkpoint();
 
+      /**
+       * Save the state at the beginning of a time step: the solutions, the
+       * time, the outputs and the contact forces. The solvers that keep more
+       * state over the time steps save it as well.
+       */
+      virtual void save_state();
+
+      /**
+       * Return to the state saved last, so that the time step is repeated,
+       * e.g. by the FSI coupling iterations with a new fluid traction.
+       */
+      virtual void restore_state();
+
+      /**
+       * Collect the boundary vertices whose dofs are locally owned, together
+       * with their lumped boundary areas in the reference configuration.
+       */
+      void setup_contact_vertices();
+
+      /**
+       * Set the contact multipliers of the contact vertices of a refined
+       * mesh, given the positions and the contact pressures (multipliers per
+       * area) of the vertices before the refinement, by vertex index, and
+       * whether they were used. Since coarsening frees vertex indices that the
+       * refinement may reuse, a vertex is only considered to be there before
+       * if it was used at the same position. The new vertices take the mean
+       * pressure of the vertices of the parent face.
+       */
+      void transfer_contact_multipliers(const std::vector<Point<spacedim>> &,
+                                        const std::vector<bool> &,
+                                        const std::vector<double> &);
+
+      /**
+       * Build the reference cache of the locally owned cells if it is enabled
+       * in the parameters, and report its memory consumption. Must be called
+       * again whenever the dofs are redistributed.
+       */
+      void setup_reference_cache();
+
       Triangulation<dim, spacedim> &triangulation;
       Parameters::AllParameters parameters;
       DoFHandler<dim, spacedim> dof_handler;
@@ -207,12 +357,29 @@ namespace Solid
       const unsigned int this_mpi_process;
       ConditionalOStream pcout;
       Utils::Time time;
+      Utils::TimeStepController time_step_controller;
       mutable TimerOutput timer;
       IndexSet locally_owned_dofs;
       IndexSet locally_owned_scalar_dofs;
       IndexSet locally_relevant_dofs;
       mutable std::vector<std::pair<double, std::string>> times_and_names;
 
+      /// A function that determines if a point is penetrating.
+      std::shared_ptr<std::function<double(const Point<spacedim> &)>>
+        penetration_criterion;
+      Tensor<1, spacedim> penetration_direction;
+      /// The boundary vertices to check for contact, built with the dofs.
+      std::vector<ContactVertex> contact_vertices;
+
+      /// Reference shape data, empty unless the solver sets it up.
+      ReferenceCache reference_cache;
+
+      /// The state saved by save_state.
+      std::vector<PETScWrappers::MPI::Vector> saved_solutions;
+      std::vector<double> saved_contact_multipliers;
+      Utils::Time::State saved_time;
+      unsigned int n_saved_outputs;
+
       /**
        * The fluid traction in FSI simulation, which should be set by the FSI.
        */
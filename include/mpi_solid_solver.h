@@ -59,6 +59,7 @@
 #include <iostream>
 
 #include "parameters.h"
+#include "symmetric_storage.h"
 #include "utilities.h"
 
 namespace Solid
@@ -23,6 +23,39 @@ namespace Parameters
     double refinement_interval;
     double save_interval;
     std::vector<double> gravity;
+    unsigned int solid_processes;
+    bool pipelined_coupling;
+    unsigned int fluid_steps_per_solid_step;
+    unsigned int solid_steps_per_fluid_step;
+    static void declareParameters(ParameterHandler &);
+    void parseParameters(ParameterHandler &);
+  };
+
+  struct TimeStepping
+  {
+    bool adaptive_time_stepping; //!< Whether to adapt the time step size.
+    double min_time_step;        //!< Lower bound of the time step size.
+    double max_time_step;        //!< Upper bound of the time step size.
+    double time_step_growth;     //!< Max increase of the step size per step.
+    double time_step_reduction;  //!< Max decrease of the step size per step.
+    double cfl_number;           //!< Target CFL number, explicit solvers only.
+    double truncation_error_tolerance; //!< Relative local truncation error
+                                       //! per step, implicit solvers only.
+    unsigned int target_nonlinear_iterations; //!< Number of nonlinear
+                                              //! iterations to aim at.
+    unsigned int local_time_step_levels; //!< Power-of-two step levels of the
+                                         //! explicit fluid solver.
+    static void declareParameters(ParameterHandler &);
+    void parseParameters(ParameterHandler &);
+  };
+
+  struct FSICoupling
+  {
+    unsigned int max_coupling_iterations; //!< 1 for explicit coupling.
+    double coupling_tolerance;            //!< Relative traction residual.
+    std::string coupling_acceleration;    //!< IQN-ILS, Aitken or Constant.
+    double initial_relaxation;            //!< First relaxation factor.
+    unsigned int reused_time_steps;       //!< Time steps IQN-ILS reuses.
     static void declareParameters(ParameterHandler &);
     void parseParameters(ParameterHandler &);
   };
@@ -48,6 +81,20 @@ namespace Parameters
     double grad_div;
     unsigned int fluid_max_iterations;
     double fluid_tolerance;
+    std::string fluid_nonlinear_solver;
+    unsigned int jacobian_refresh_interval;
+    double jacobian_refresh_ratio;
+    bool fluid_mixed_precision;
+    std::string fluid_linear_solver;
+    std::string field_split_type;
+    std::string fluid_petsc_options;
+    std::string ilu_type;
+    unsigned int euclid_levels;
+    bool euclid_block_jacobi;
+    unsigned int pilut_max_iterations;
+    unsigned int pilut_factor_row_size;
+    double pilut_tolerance;
+    bool ilu_autotuning;
     static void declareParameters(ParameterHandler &);
     void parseParameters(ParameterHandler &);
   };
@@ -112,6 +159,23 @@ namespace Parameters
     double tol_d; //!< Displacement tolerance, hyperelastic only.
     double contact_force_multiplier; //!< Multiplier of the penetration distance
                                      //!< to compute contact force.
+    double contact_penalty; //!< Contact force per unit boundary area and unit
+                            //! penetration, hyperelastic only.
+    std::string nonlinear_solver; //!< Newton, Modified Newton or LBFGS,
+                                  //! hyperelastic only.
+    unsigned int tangent_refresh_interval; //!< Iterations between tangent
+                                           //! updates in modified Newton.
+    double tangent_refresh_ratio; //!< Residual reduction ratio above which
+                                  //! the tangent is updated.
+    unsigned int lbfgs_history; //!< Number of L-BFGS correction pairs.
+    double critical_time_step_fraction; //!< Safety factor of the explicit
+                                        //! solver's stable time step.
+    bool cache_reference_gradients; //!< Whether to cache the reference
+                                    //! shape gradients and JxW values.
+    bool solid_mixed_precision; //!< Whether to precondition FGMRES with
+                                //! single precision ILU(0) factors.
+    bool solid_symmetric_storage; //!< Whether to store only the upper
+                                  //! triangle of the solid matrices.
     static void declareParameters(ParameterHandler &);
     void parseParameters(ParameterHandler &);
   };
@@ -155,6 +219,8 @@ namespace Parameters
   };
 
   struct AllParameters : public Simulation,
+                         public TimeStepping,
+                         public FSICoupling,
                          public FluidFESystem,
                          public FluidMaterial,
                          public FluidSolver,
@@ -0,0 +1,88 @@
+#ifndef PRECONDITIONER_MIXED_PRECISION
+#define PRECONDITIONER_MIXED_PRECISION
+
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/petsc_matrix_base.h>
+#include <deal.II/lac/petsc_vector.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "symmetric_storage.h"
+
+using namespace dealii;
+
+/** \brief Block Jacobi ILU(0) preconditioner stored in single precision.
+ * The locally owned diagonal block of a PETSc matrix is factorized and the
+ * factors are kept in float, which halves the memory and the bandwidth of
+ * applying the preconditioner. The vectors are converted to float before
+ * the triangular solves and back to double afterwards, so the outer Krylov
+ * solver still works in double precision and corrects the rounding errors
+ * like any other inexactness of the preconditioner.
+ * PETSc is built for a single scalar type, therefore the factorization is
+ * done by deal.II rather than Hypre. It can only be used with the deal.II
+ * solvers, not the PETScWrappers ones. Matrices in symmetric storage are
+ * expanded to the full local block.
+ */
+class PreconditionMixedPrecision : public Subscriptor
+{
+public:
+  /**
+   * Standardized data struct to pipe additional flags to the
+   * preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double strengthen_diagonal = 0);
+
+    /**
+     * The diagonal is strengthened by this factor times the sum of the
+     * absolute values of the row before factorizing.
+     */
+    double strengthen_diagonal;
+  };
+
+  /**
+   * Empty Constructor. You need to call initialize() before using this
+   * object.
+   */
+  PreconditionMixedPrecision() = default;
+
+  /**
+   * Compute the single precision factors of the locally owned diagonal block
+   * of the matrix. The matrix is not referenced afterwards.
+   */
+  void initialize(const PETScWrappers::MatrixBase &matrix,
+                  const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Apply the preconditioner, dst and src must have the parallel layout of
+   * the matrix rows.
+   */
+  void vmult(PETScWrappers::VectorBase &dst,
+             const PETScWrappers::VectorBase &src) const;
+
+  /**
+   * Memory used by the factors and the buffers, in bytes.
+   */
+  std::size_t memory_consumption() const;
+
+private:
+  /// The sparsity pattern of the local block, referenced by the factors.
+  SparsityPattern sparsity_pattern;
+
+  /// The ILU(0) factors in single precision.
+  SparseILU<float> ilu;
+
+  /// Single precision copies of the local parts of the vectors.
+  mutable Vector<float> src_buffer;
+  mutable Vector<float> dst_buffer;
+};
+
+#endif
@@ -9,8 +9,11 @@
 #include <deal.II/lac/petsc_precondition.h>
 #include <deal.II/lac/petsc_solver.h>
 #include <deal.II/lac/petsc_vector_base.h>
+#include <memory>
 #include <petscconf.h>
 #include <petscpc.h>
+#include <string>
+#include <vector>
 
 using namespace dealii;
 
@@ -77,6 +80,29 @@ private:
 class PreconditionEuclid : public PETScWrappers::PreconditionerBase
 {
 public:
+  /**
+   * Standardized data struct to pipe additional flags to the
+   * preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const unsigned int levels = 0,
+                   const bool block_jacobi = false);
+
+    /**
+     * Number of levels of fill of ILU(k).
+     */
+    unsigned int levels;
+
+    /**
+     * Use block Jacobi ILU(k) instead of parallel ILU(k).
+     */
+    bool block_jacobi;
+  };
+
   /**
    * Empty Constructor. You need to call initialize() before using this
    * object.
@@ -87,7 +113,8 @@ public:
    * Constructor. Take the matrix which is used to form the preconditioner,
    * and additional flags if there are any.
    */
-  PreconditionEuclid(const PETScWrappers::MatrixBase &matrix);
+  PreconditionEuclid(const PETScWrappers::MatrixBase &matrix,
+                     const AdditionalData &additional_data = AdditionalData());
 
   /**
    * Initialize the preconditioner object and calculate all data that is
@@ -95,9 +122,92 @@ public:
    * called when calling the constructor with the same arguments and is only
    * used if you create the preconditioner without arguments.
    */
-  void initialize(const PETScWrappers::MatrixBase &matrix);
+  void initialize(const PETScWrappers::MatrixBase &matrix,
+                  const AdditionalData &additional_data = AdditionalData());
 
   friend PETScWrappers::MatrixBase;
+
+private:
+  /**
+   * Store a copy of the flags for this particular preconditioner.
+   */
+  AdditionalData additional_data;
+};
+
+/**
+ * The Hypre ILU preconditioner to use and its flags.
+ */
+struct HypreILUSettings
+{
+  /**
+   * Constructor.
+   */
+  HypreILUSettings(const std::string &type = "Euclid",
+                   const PreconditionEuclid::AdditionalData &euclid_data =
+                     PreconditionEuclid::AdditionalData(),
+                   const PreconditionPilut::AdditionalData &pilut_data =
+                     PreconditionPilut::AdditionalData());
+
+  /**
+   * Create the preconditioner for a matrix.
+   */
+  std::shared_ptr<PETScWrappers::PreconditionerBase>
+  create(const PETScWrappers::MatrixBase &matrix) const;
+
+  /**
+   * A short description for logging.
+   */
+  std::string description() const;
+
+  bool operator==(const HypreILUSettings &other) const;
+
+  /**
+   * Euclid or PILUT.
+   */
+  std::string type;
+
+  PreconditionEuclid::AdditionalData euclid_data;
+
+  PreconditionPilut::AdditionalData pilut_data;
+};
+
+/** \brief Auto-tuner of the Hypre ILU settings.
+ * The best ILU settings depend on the problem and the number of processes,
+ * so a few candidates are tried in turn: the configured ones, Euclid ILU(0)
+ * and ILU(1) both parallel and block Jacobi, and PILUT. The solver reports
+ * the cost of each candidate, normally the setup and solve time per
+ * nonlinear iteration, and the cheapest one is kept afterwards.
+ */
+class ILUAutoTuner
+{
+public:
+  /**
+   * Constructor. If not enabled, the configured settings are always used.
+   */
+  ILUAutoTuner(const HypreILUSettings &configured, const bool enabled);
+
+  /**
+   * The settings to use now.
+   */
+  const HypreILUSettings &current() const;
+
+  /**
+   * Whether candidates are still being tried.
+   */
+  bool tuning() const;
+
+  /**
+   * Record the cost of the current candidate and move on to the next one,
+   * or to the cheapest one after all of them have been tried.
+   */
+  void record(const double cost);
+
+private:
+  std::vector<HypreILUSettings> candidates;
+
+  std::vector<double> costs;
+
+  unsigned int index;
 };
 
 #endif
@@ -65,6 +65,9 @@ namespace Solid
 
     void setup_dofs();
 
+    /// Build the maps between the libMesh nodes and the deal.II dofs.
+    void setup_index_maps();
+
     virtual void update_strain_and_stress() override;
 
     /** Assemble the lhs and rhs at the same time. */
@@ -96,6 +99,17 @@ namespace Solid
     Vector<double> current_drilling;
 
     std::unique_ptr<ShellSolid::shellsolid> m_shell;
+
+    /// A deal.II dof and the libMesh node it lives on.
+    struct NodeDof
+    {
+      unsigned int node;
+      unsigned int component;
+      types::global_dof_index dof;
+    };
+
+    /// The dofs of dof_handler and scalar_dof_handler, one entry per dof.
+    std::vector<NodeDof> vector_node_dofs, scalar_node_dofs;
   };
 } // namespace Solid
 #endif
\ No newline at end of file
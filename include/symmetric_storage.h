@@ -0,0 +1,53 @@
+#ifndef SYMMETRIC_STORAGE
+#define SYMMETRIC_STORAGE
+
+#include <deal.II/base/index_set.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/petsc_matrix_base.h>
+#include <deal.II/lac/petsc_precondition.h>
+#include <deal.II/lac/petsc_sparse_matrix.h>
+#include <petscksp.h>
+
+using namespace dealii;
+
+/** \brief Store symmetric PETSc matrices in SBAIJ format.
+ * Only the upper triangle of an SBAIJ matrix is stored, which roughly halves
+ * the memory of the matrix and the bandwidth of a product with it. The
+ * matrix is created directly in SBAIJ format behind the deal.II wrapper, so
+ * the wrapper keeps working: the full local matrices can still be
+ * distributed into it, the lower triangle is dropped by PETSc. Routines that
+ * read the matrix row by row only see the upper triangle.
+ */
+namespace SymmetricStorage
+{
+  /**
+   * Reinitialize a matrix as SBAIJ with the given sparsity pattern, which
+   * must be symmetric. Blocks of block_size consecutive dofs are stored
+   * together, so the locally owned dofs must be contiguous and aligned to it.
+   * The blocks pay off when the dofs of a block couple to the same dofs, as
+   * the components of a support point do. No AIJ copy of the pattern is
+   * allocated on the way.
+   */
+  void reinit(PETScWrappers::MPI::SparseMatrix &matrix,
+              const IndexSet &locally_owned_dofs,
+              const DynamicSparsityPattern &dsp,
+              const MPI_Comm &mpi_communicator,
+              const unsigned int block_size);
+
+  /**
+   * Whether the matrix is stored in SBAIJ format.
+   */
+  bool is_symmetric(const PETScWrappers::MatrixBase &matrix);
+
+  /**
+   * PETSc has no ILU for SBAIJ matrices. Factorize the blocks of a block
+   * Jacobi preconditioner by incomplete Cholesky instead, which must be done
+   * before the first application.
+   */
+  void use_cholesky_blocks(
+    const PETScWrappers::PreconditionBlockJacobi &preconditioner);
+} // namespace SymmetricStorage
+
+#endif
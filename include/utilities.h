@@ -1,6 +1,10 @@
 #ifndef UTILITIES
 #define UTILITIES
 
+#include <deal.II/base/quadrature_point_data.h>
+#include <deal.II/distributed/fully_distributed_tria.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/dofs/dof_handler.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_refinement.h>
@@ -8,14 +12,24 @@
 #include <deal.II/grid/manifold_lib.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_description.h>
 #include <deal.II/grid/tria_iterator.h>
 #include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/petsc_block_vector.h>
+#include <deal.II/lac/petsc_vector.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <array>
+#include <deque>
+#include <limits>
+#include <map>
 #include <queue>
+#include <string>
 #include <unordered_set>
 
+#include "parameters.h"
+
 namespace Utils
 {
   using namespace dealii;
@@ -31,6 +45,7 @@ namespace Utils
          const double save_interval)
       : timestep(0),
         time_current(0.0),
+        time_previous(0.0),
         delta_t(delta_t),
         time_end(time_end),
         output_interval(output_interval),
@@ -42,6 +57,11 @@ namespace Utils
     double end() const { return time_end; }
     double get_delta_t() const { return delta_t; }
     unsigned int get_timestep() const { return timestep; }
+    /**
+     * The output, refinement and checkpoints are triggered when the last
+     * step has passed a multiple of their intervals, so that they keep their
+     * cadence in time if the time step size changes.
+     */
     bool time_to_output() const;
     bool time_to_refine() const;
     bool time_to_save() const;
@@ -49,9 +69,35 @@ namespace Utils
     void decrement();
     void set_delta_t(double delta);
 
+    /// The step counter, the times and the step size.
+    struct State
+    {
+      unsigned int timestep;
+      double current;
+      double previous;
+      double delta_t;
+    };
+    /// Return to a state taken before, e.g. to repeat time steps.
+    State get_state() const;
+    void set_state(const State &);
+
+    /**
+     * Write the state and the output records of a solver to a checkpoint
+     * file, and read them back on restart, so that the time is restored
+     * exactly even if the step size has changed.
+     */
+    void save(const std::string &,
+              const std::vector<std::pair<double, std::string>> &) const;
+    void load(const std::string &,
+              std::vector<std::pair<double, std::string>> &);
+
   private:
+    /// Whether a multiple of the interval is in (time_previous, time_current].
+    bool passed_multiple_of(const double interval) const;
+
     unsigned int timestep;
     double time_current;
+    double time_previous; //!< Time before the last increment.
     double delta_t;
     const double time_end;
     const double output_interval;
@@ -59,6 +105,182 @@ namespace Utils
     const double save_interval;
   };
 
+  /*! \brief Adaptive time step size controller.
+   *
+   *  The solvers compute a factor for their next time step size from a
+   * stability limit (CFL) or a local truncation error estimate, and from the
+   * number of nonlinear iterations of the last step. The controller applies
+   * the most restrictive factor to the time step size, within the growth and
+   * reduction factors and the minimum and maximum sizes of the parameter
+   * file. A stability limit is a hard cap outside of these bounds. Nothing
+   * changes if adaptive time stepping is off.
+   */
+  class TimeStepController
+  {
+  public:
+    TimeStepController(const Parameters::AllParameters &);
+
+    /// Whether the time step size is adapted at all.
+    bool enabled() const { return adaptive; }
+
+    /// Factor to reach the CFL number, given the step size at CFL = 1.
+    double cfl_factor(const double delta_t, const double stable_delta_t) const;
+
+    /**
+     * Factor to reach the error tolerance, given the local truncation error
+     * of the last step relative to the solution, and the order of the scheme.
+     */
+    double error_factor(const double error, const unsigned int order) const;
+
+    /// Factor to reach the target number of nonlinear iterations.
+    double iteration_factor(const unsigned int n_iterations) const;
+
+    /**
+     * Scale the time step size, without stepping past the end time. The
+     * factor is bounded by the growth and reduction factors and the step size
+     * by its minimum and maximum. The limit is a hard cap on the factor
+     * applied after those bounds, such as the CFL factor of an explicit
+     * scheme, which must not be relaxed to keep the step stable.
+     */
+    void update(Time &time,
+                const double factor,
+                const double limit = std::numeric_limits<double>::max()) const;
+
+  private:
+    bool adaptive;
+    double min_delta_t;
+    double max_delta_t;
+    double growth;
+    double reduction;
+    double cfl_number;
+    double tolerance;
+    unsigned int target_iterations;
+  };
+
+  /*! \brief Acceleration of the fixed-point iterations of a partitioned
+   * coupling.
+   *
+   *  The coupling iterations map an interface quantity x, such as the fluid
+   * traction on the solid, to an updated one x~ = H(x), by running the
+   * solvers. Given x~, this class proposes the next x: IQN-ILS, the
+   * interface quasi-Newton method with the inverse Jacobian approximated by
+   * least squares, uses the differences of the previous iterations of the
+   * current and the last few time steps. Aitken relaxes dynamically. The
+   * first iteration of IQN-ILS without past information and Constant use
+   * the initial relaxation factor.
+   */
+  class CouplingAccelerator
+  {
+  public:
+    CouplingAccelerator(const Parameters::AllParameters &);
+
+    /// Start a new time step with x as the initial guess.
+    void new_time_step(const Vector<double> &x);
+
+    /**
+     * Take x~ = H(x) of the current x, and update x. Return the residual
+     * |x~ - x| relative to |x~|.
+     */
+    double update(const Vector<double> &x_tilde);
+
+    /// The current x, to be passed to the next iteration.
+    const Vector<double> &current() const { return x; }
+
+  private:
+    std::string method;
+    double initial_relaxation;
+    unsigned int reused_time_steps;
+    double relaxation;
+    Vector<double> x;
+    Vector<double> previous_residual;
+    Vector<double> previous_x_tilde;
+    /// Differences of the residuals and of x~, latest first.
+    std::deque<Vector<double>> residual_differences;
+    std::deque<Vector<double>> x_tilde_differences;
+    /// Number of differences each of the stored time steps, latest first.
+    std::deque<unsigned int> differences_per_step;
+  };
+
+  /*! \brief Fused Newmark-beta updates of distributed PETSc vectors.
+   *
+   *  The update of a time step written as copies and adds is a chain of
+   * passes over memory, one function call each. Here every update is a
+   * single sweep over the locally owned entries. The vectors must have the
+   * same layout and must not be ghosted. The suffix _n denotes the state of
+   * the previous time step.
+   */
+  class NewmarkUpdate
+  {
+  public:
+    using VectorType = PETScWrappers::MPI::Vector;
+
+    NewmarkUpdate(const double beta, const double gamma);
+
+    /**
+     * Reinitialize a work vector only if its layout has changed, so that it
+     * can persist over the time steps and through mesh refinement.
+     */
+    static void
+    reinit(VectorType &x, const IndexSet &locally_owned, MPI_Comm comm);
+
+    /// x = y + c_z z.
+    static void combine(VectorType &x,
+                        const VectorType &y,
+                        const double c_z,
+                        const VectorType &z);
+
+    /// x = y + c_z z + c_w w.
+    static void combine(VectorType &x,
+                        const VectorType &y,
+                        const double c_z,
+                        const VectorType &z,
+                        const double c_w,
+                        const VectorType &w);
+
+    /// The displacement predictor d_n + dt v_n + (1/2 - beta) dt^2 a_n.
+    void predict(VectorType &predicted,
+                 const double dt,
+                 const VectorType &d_n,
+                 const VectorType &v_n,
+                 const VectorType &a_n) const;
+
+    /**
+     * The acceleration a = (d - predicted) / (beta dt^2) and the velocity
+     * v = v_n + dt ((1 - gamma) a_n + gamma a) of a displacement d.
+     */
+    void correct(VectorType &a,
+                 VectorType &v,
+                 const double dt,
+                 const VectorType &d,
+                 const VectorType &predicted,
+                 const VectorType &v_n,
+                 const VectorType &a_n) const;
+
+    /**
+     * Given the acceleration a, compute the velocity and the displacement of
+     * the new time step, and store the new state as the previous one.
+     */
+    void advance(const VectorType &a,
+                 VectorType &v,
+                 VectorType &d,
+                 const double dt,
+                 VectorType &a_n,
+                 VectorType &v_n,
+                 VectorType &d_n) const;
+
+    /// Store the new state as the previous one.
+    static void store(const VectorType &a,
+                      const VectorType &v,
+                      const VectorType &d,
+                      VectorType &a_n,
+                      VectorType &v_n,
+                      VectorType &d_n);
+
+  private:
+    const double beta;
+    const double gamma;
+  };
+
   /*! \brief A helper class to generate triangulations and specify boundary ids.
    *
    *  dealii::GridGenerator can be used to generate a few standard grids such as
@@ -97,6 +319,27 @@ namespace Utils
                          const double radius,
                          const double length);
 
+    /*! \brief Partition a mesh and write one file per partition.
+     *
+     * This is the preprocessing step for a
+     * parallel::fullydistributed::Triangulation. It runs on a single process
+     * with the full mesh, refined as it is going to be used, and writes
+     * "basename.RRRR" for each of the processes, which only contains the
+     * cells of that process and its ghost layer. Boundary and manifold ids
+     * are kept, the manifolds themselves are not.
+     */
+    static void write_partitioned(Triangulation<dim> &tria,
+                                  const unsigned int n_partitions,
+                                  const std::string &basename);
+
+    /*! \brief Read the partition of this process from the files written by
+     * write_partitioned. The number of processes must be the number of
+     * partitions, and the manifolds need to be attached again.
+     */
+    static void
+    read_partitioned(parallel::fullydistributed::Triangulation<dim> &tria,
+                     const std::string &basename);
+
   private:
     /// A helper function used by flow_around_cylinder.
     static void flow_around_cylinder_2d(Triangulation<2> &,
@@ -115,59 +358,166 @@ namespace Utils
    * in parallel applications, it can only be owned by one processor. In those
    * situations
    * zero is returned.
+   *
+   * If the cell is affine (a parallelogram or parallelepiped), the unit point
+   * is computed in closed form instead of the Newton iteration in
+   * MappingQ1::transform_real_to_unit_cell. The shape functions and their
+   * gradients are evaluated directly at the unit point once and cached, so
+   * that interpolating several vectors costs one dot product per component
+   * rather than an FEValues reinit.
    */
   template <int dim, typename VectorType>
   class GridInterpolator
   {
   public:
+    typedef typename VectorType::value_type Number;
+
     GridInterpolator(const DoFHandler<dim> &,
                      const Point<dim> &,
                      const std::vector<bool> &mask = {},
                      const typename DoFHandler<dim>::active_cell_iterator &
                        cell = typename DoFHandler<dim>::active_cell_iterator());
-    void point_value(const VectorType &,
-                     Vector<typename VectorType::value_type> &);
-    void point_gradient(
-      const VectorType &,
-      std::vector<Tensor<1, dim, typename VectorType::value_type>> &);
+    void point_value(const VectorType &, Vector<Number> &);
+    void point_gradient(const VectorType &,
+                        std::vector<Tensor<1, dim, Number>> &);
+    /// Interpolate the values of several vectors in one call.
+    void point_values(const std::vector<const VectorType *> &,
+                      std::vector<Vector<Number>> &);
+    /// Interpolate the gradients of several vectors in one call.
+    void point_gradients(const std::vector<const VectorType *> &,
+                         std::vector<std::vector<Tensor<1, dim, Number>>> &);
 
     bool found_cell() const { return cell_found; };
     const typename DoFHandler<dim>::active_cell_iterator get_cell() const;
+    /// Whether the closed-form inverse mapping was used.
+    bool is_affine() const { return affine; }
+
+    /**
+     * Compute the unit point of an affine cell in closed form. Returns false
+     * if the cell is not affine, in which case the unit point is untouched.
+     */
+    static bool
+    affine_real_to_unit_cell(const typename DoFHandler<dim>::cell_iterator &,
+                             const Point<dim> &,
+                             Point<dim> &);
 
   private:
+    /// Whether the point is in a locally owned cell we can evaluate on.
+    bool evaluable() const;
+    /// Evaluate and cache the shape values at the unit point.
+    void compute_shape_values();
+    /// Evaluate and cache the real-space shape gradients at the unit point.
+    void compute_shape_gradients();
+
     const DoFHandler<dim> &dof_handler;
     const Point<dim> &point;
     bool cell_found;
+    bool affine;
     MappingQ1<dim> mapping;
     std::pair<typename DoFHandler<dim>::active_cell_iterator, Point<dim>>
       cell_point;
+    /// Cached shape values and real-space gradients at the unit point.
+    std::vector<double> shape_values;
+    std::vector<Tensor<1, dim>> shape_gradients;
+    /// Scratch storage for the dof values of the cell.
+    Vector<Number> local_dof_values;
+  };
+
+  /**
+   * A uniform-grid (cell-list) index of the centers of the locally owned
+   * active cells of a DoFHandler. The bin size is the largest SPH support
+   * radius (twice the largest cell diameter), so that a support query only
+   * visits the neighboring bins. The index is built once per mesh and must be
+   * rebuilt by calling reinit() after the mesh is refined or moved.
+   */
+  template <int dim>
+  class CellCenterIndex
+  {
+  public:
+    /// Data cached for every indexed cell.
+    struct Entry
+    {
+      typename DoFHandler<dim>::active_cell_iterator cell;
+      Point<dim> center;
+      double diameter;
+      double measure;
+    };
+
+    CellCenterIndex(const DoFHandler<dim> &);
+
+    /// Rebuild the index from the current mesh.
+    void reinit();
+
+    /// Indices of the entries whose centers are within the radius of a point.
+    void query(const Point<dim> &, double, std::vector<unsigned int> &) const;
+
+    const DoFHandler<dim> &get_dof_handler() const { return dof_handler; }
+    const Entry &entry(unsigned int i) const { return entries[i]; }
+    unsigned int size() const { return entries.size(); }
+    double get_max_diameter() const { return max_diameter; }
+
+  private:
+    /// Flattened bin index of a bin coordinate.
+    unsigned int bin_index(const std::array<int, dim> &) const;
+
+    const DoFHandler<dim> &dof_handler;
+    std::vector<Entry> entries;
+    double max_diameter;
+    double bin_size;
+    Point<dim> origin;
+    std::array<int, dim> n_bins;
+    /// Entry indices stored in each bin.
+    std::vector<std::vector<unsigned int>> bins;
   };
 
+  /**
+   * Interpolate a finite element field to target points with a cubic-spline
+   * SPH kernel, using the cell centers as source nodes. With the
+   * CellCenterIndex constructor only the cells within the kernel support are
+   * visited, and several target points can be handled in one batch so that
+   * every source cell is evaluated only once.
+   */
   template <int dim, typename VectorType>
   class SPHInterpolator
   {
   public:
+    typedef typename VectorType::value_type Number;
+
+    /// Search every locally owned cell for the sources of a single point.
     SPHInterpolator(const DoFHandler<dim> &, const Point<dim> &);
-    void point_value(const VectorType &,
-                     Vector<typename VectorType::value_type> &);
-    void point_gradient(
-      const VectorType &,
-      std::vector<Tensor<1, dim, typename VectorType::value_type>> &);
+    /// Look up the sources of a batch of points in a prebuilt index.
+    SPHInterpolator(const CellCenterIndex<dim> &,
+                    const std::vector<Point<dim>> &);
+    /// Interpolate the value at the first (or only) target point.
+    void point_value(const VectorType &, Vector<Number> &);
+    /// Interpolate the gradient at the first (or only) target point.
+    void point_gradient(const VectorType &,
+                        std::vector<Tensor<1, dim, Number>> &);
+    /// Interpolate the values at all target points.
+    void point_values(const VectorType &, std::vector<Vector<Number>> &);
+    /// Interpolate the gradients at all target points.
+    void point_gradients(const VectorType &,
+                         std::vector<std::vector<Tensor<1, dim, Number>>> &);
 
   private:
     /// Source DoFHandler
     const DoFHandler<dim> &dof_handler;
-    /// Target point to interpolate to
-    const Point<dim> target;
+    /// Target points to interpolate to
+    const std::vector<Point<dim>> targets;
     /**
-     * Source nodes that contribute to the target point,
-     * denoted as pairs of cell iterator, kernel value,
-     * and kernel gradient.
+     * Source nodes that contribute to the target points, denoted as pairs of
+     * cell iterator and the (target index, kernel value times cell measure)
+     * pairs of the targets it contributes to.
      */
     std::vector<
-      std::pair<typename DoFHandler<dim>::active_cell_iterator, double>>
+      std::pair<typename DoFHandler<dim>::active_cell_iterator,
+                std::vector<std::pair<unsigned int, double>>>>
       sources;
+    /// Single FEValues evaluating at the cell center, reused for all sources.
+    MappingQGeneric<dim> mapping;
+    FEValues<dim> fe_values;
 
+    static Quadrature<dim> cell_center_quadrature();
     double cubic_spline(const Point<dim> &, const Point<dim> &, double);
   };
 
@@ -189,6 +539,71 @@ namespace Utils
     const typename MeshType::active_cell_iterator hint;
     bool cell_found;
   };
+
+  /**
+   * The solid cells to start the search for the support points of every
+   * fluid cell from. The solid mesh is replicated and never refined, so a
+   * solid cell is identified by its level and index on every process. The
+   * hints are carried over the refinement of a p4est fluid mesh: the
+   * children of a refined cell start from its hints and a coarsened cell
+   * starts from the ones of its first child. They can also be saved along
+   * with a checkpoint.
+   */
+  template <int dim>
+  class CellHints
+  {
+  public:
+    using SolidCell = typename DoFHandler<dim>::active_cell_iterator;
+
+    /**
+     * Allocate n_points hints for every non-artificial fluid cell. They
+     * point to the stored solid cells where there are any, and to the first
+     * solid cell otherwise, which makes the first search a global one.
+     */
+    void setup(const Triangulation<dim> &fluid_tria,
+               const DoFHandler<dim> &solid_dof_handler,
+               const unsigned int n_points);
+
+    /// The hints of a fluid cell, one per support point.
+    std::vector<std::shared_ptr<SolidCell>>
+    get(const typename Triangulation<dim>::active_cell_iterator &);
+
+    /**
+     * Attach the hints to the fluid mesh before its refinement. Returns the
+     * handle to unpack them with.
+     */
+    unsigned int prepare_for_coarsening_and_refinement(
+      parallel::distributed::Triangulation<dim> &);
+
+    /// Store the hints of the refined fluid mesh for the next setup.
+    void unpack(parallel::distributed::Triangulation<dim> &,
+                const unsigned int handle);
+
+    /**
+     * Write the hints of the locally owned fluid cells to a file, one line
+     * per cell: its id followed by the level and index of every hint.
+     */
+    void save(const std::string &filename,
+              const parallel::DistributedTriangulationBase<dim> &) const;
+
+    /**
+     * Read the hints of the fluid cells this process sees for the next
+     * setup. Returns false if the file does not exist.
+     */
+    bool load(const std::string &filename,
+              const Triangulation<dim> &fluid_tria,
+              const unsigned int n_points);
+
+  private:
+    using StoredHints = std::vector<std::pair<unsigned int, unsigned int>>;
+
+    CellDataStorage<typename Triangulation<dim>::active_cell_iterator,
+                    SolidCell>
+      hints;
+
+    /// The hints of new or reloaded fluid cells, consumed by setup.
+    std::map<CellId, StoredHints> stored_hints;
+  };
 } // namespace Utils
 
 #endif
@@ -0,0 +1,226 @@
+#include "ensemble.h"
+
+#include <algorithm>
+#include <experimental/filesystem>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::experimental::filesystem;
+
+namespace MPI
+{
+  namespace
+  {
+    /// Run in a directory and change back to the current one on scope exit,
+    /// also when an exception leaves the scope.
+    class WorkingDirectory
+    {
+    public:
+      explicit WorkingDirectory(const fs::path &path)
+        : previous(fs::current_path())
+      {
+        fs::current_path(path);
+      }
+
+      ~WorkingDirectory()
+      {
+        // The overload with an error code does not throw
+        std::error_code error;
+        fs::current_path(previous, error);
+      }
+
+      WorkingDirectory(const WorkingDirectory &) = delete;
+      WorkingDirectory &operator=(const WorkingDirectory &) = delete;
+
+    private:
+      const fs::path previous;
+    };
+  } // namespace
+
+  template <int dim>
+  Ensemble<dim>::Ensemble(
+    const std::vector<Parameters::AllParameters> &member_parameters,
+    const unsigned int n_groups,
+    const Signature &signature)
+    : members(member_parameters),
+      n_groups(n_groups),
+      signature(signature),
+      group(0),
+      group_communicator(MPI_COMM_NULL),
+      wall_time(0)
+  {
+    const unsigned int n_processes =
+      Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+    const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    AssertThrow(n_groups > 0 && n_groups <= n_processes,
+                ExcMessage("Every ensemble group needs a process!"));
+    // Consecutive ranks form a group, so that a group stays on few nodes
+    group = rank * n_groups / n_processes;
+    MPI_Comm_split(
+      MPI_COMM_WORLD, static_cast<int>(group), rank, &group_communicator);
+    for (unsigned int m = group; m < members.size(); m += n_groups)
+      {
+        group_members.push_back(m);
+      }
+    // Members on the same meshes run one after the other
+    std::stable_sort(group_members.begin(),
+                     group_members.end(),
+                     [this](const unsigned int a, const unsigned int b) {
+                       return this->signature(members[a]) <
+                              this->signature(members[b]);
+                     });
+  }
+
+  template <int dim>
+  Ensemble<dim>::~Ensemble()
+  {
+    if (group_communicator != MPI_COMM_NULL)
+      {
+        MPI_Comm_free(&group_communicator);
+      }
+  }
+
+  template <int dim>
+  std::string
+  Ensemble<dim>::mesh_signature(const Parameters::AllParameters &parameters)
+  {
+    std::ostringstream key;
+    key << parameters.dimension;
+    for (const int refinements : parameters.global_refinements)
+      {
+        key << " " << refinements;
+      }
+    if (parameters.refinement_interval < parameters.end_time)
+      {
+        key << " adaptive";
+      }
+    return key.str();
+  }
+
+  template <int dim>
+  void Ensemble<dim>::run(const MeshCreator &create_meshes,
+                          const MemberRunner &run_member)
+  {
+    Timer ensemble_timer;
+    SharedMeshes meshes;
+    std::string current_signature;
+    bool has_meshes = false;
+    records.clear();
+    for (const unsigned int m : group_members)
+      {
+        const Parameters::AllParameters &parameters = members[m];
+        const std::string key = signature(parameters);
+        const bool reuse = has_meshes && key == current_signature;
+        Timer setup_timer;
+        if (!reuse)
+          {
+            meshes.fluid.reset();
+            meshes.solid.reset();
+            create_meshes(group_communicator, parameters, meshes);
+            current_signature = key;
+            has_meshes = true;
+          }
+        setup_timer.stop();
+
+        // The shared meshes are already refined
+        Parameters::AllParameters member_parameters = parameters;
+        std::fill(member_parameters.global_refinements.begin(),
+                  member_parameters.global_refinements.end(),
+                  0);
+        const fs::path ensemble_path = fs::current_path();
+        const fs::path member_path =
+          ensemble_path / ("member_" + Utilities::int_to_string(m, 4));
+        std::error_code error;
+        fs::create_directories(member_path, error);
+        AssertThrow(fs::is_directory(member_path),
+                    ExcMessage("Cannot create " + member_path.string()));
+        Timer run_timer;
+        {
+          WorkingDirectory member_directory(member_path);
+          run_member(group_communicator, m, member_parameters, meshes);
+        }
+        run_timer.stop();
+        // An adapted mesh is no longer the one its signature describes
+        if (parameters.refinement_interval < parameters.end_time)
+          {
+            has_meshes = false;
+          }
+        records.push_back(
+          {m, setup_timer.wall_time(), run_timer.wall_time(), reuse});
+      }
+    wall_time = Utilities::MPI::max(ensemble_timer.wall_time(), MPI_COMM_WORLD);
+  }
+
+  template <int dim>
+  bool Ensemble<dim>::reused_meshes(const unsigned int member) const
+  {
+    for (const auto &record : records)
+      {
+        if (record.member == member)
+          {
+            return record.reused;
+          }
+      }
+    return false;
+  }
+
+  template <int dim>
+  void Ensemble<dim>::print_summary() const
+  {
+    // The first process of every group reports the members it ran
+    std::vector<double> local_records;
+    if (Utilities::MPI::this_mpi_process(group_communicator) == 0)
+      {
+        for (const auto &record : records)
+          {
+            local_records.insert(local_records.end(),
+                                 {static_cast<double>(record.member),
+                                  static_cast<double>(group),
+                                  record.setup_time,
+                                  record.run_time,
+                                  record.reused ? 1.0 : 0.0});
+          }
+      }
+    const std::vector<std::vector<double>> all_records =
+      Utilities::MPI::gather(MPI_COMM_WORLD, local_records, 0);
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) != 0)
+      {
+        return;
+      }
+
+    std::vector<std::vector<double>> rows;
+    for (const auto &group_records : all_records)
+      {
+        for (unsigned int i = 0; i + 4 < group_records.size(); i += 5)
+          {
+            rows.emplace_back(group_records.begin() + i,
+                              group_records.begin() + i + 5);
+          }
+      }
+    std::sort(rows.begin(), rows.end());
+
+    double total_setup = 0, total_run = 0;
+    unsigned int n_reused = 0;
+    std::cout << "Ensemble of " << rows.size() << " members in " << n_groups
+              << " group(s):" << std::endl;
+    for (const auto &row : rows)
+      {
+        std::cout << "  Member " << static_cast<unsigned int>(row[0])
+                  << " (group " << static_cast<unsigned int>(row[1])
+                  << "): setup " << row[2] << " s, run " << row[3] << " s"
+                  << (row[4] > 0 ? ", reused meshes" : "") << std::endl;
+        total_setup += row[2];
+        total_run += row[3];
+        n_reused += row[4] > 0 ? 1 : 0;
+      }
+    std::cout << "Wall time " << wall_time << " s, sum of the member times "
+              << total_setup + total_run << " s (setup " << total_setup
+              << " s), " << n_reused << " member(s) reused the meshes"
+              << std::endl
+              << "Throughput: " << 3600 * rows.size() / wall_time
+              << " members per hour" << std::endl;
+  }
+
+  template class Ensemble<2>;
+  template class Ensemble<3>;
+} // namespace MPI
@@ -0,0 +1,195 @@
+#include "fieldsplit_solver.h"
+
+FieldSplitSolver::AdditionalData::AdditionalData(const std::string &split_type,
+                                                 const std::string &options)
+  : split_type(split_type), options(options)
+{
+}
+
+FieldSplitSolver::FieldSplitSolver(const AdditionalData &additional_data)
+  : additional_data(additional_data),
+    nested_matrix(nullptr),
+    solution(nullptr),
+    rhs(nullptr),
+    ksp(nullptr)
+{
+  AssertThrow(additional_data.split_type == "Schur" ||
+                additional_data.split_type == "Multiplicative" ||
+                additional_data.split_type == "Additive",
+              ExcMessage("Unknown field split type!"));
+}
+
+FieldSplitSolver::~FieldSplitSolver()
+{
+  // Same as clear, but a destructor must not throw. The PETSc destroy
+  // functions do nothing with null objects.
+  PetscErrorCode ierr = KSPDestroy(&ksp);
+  AssertNothrow(ierr == 0, ExcPETScError(ierr));
+  ierr = VecDestroy(&solution);
+  AssertNothrow(ierr == 0, ExcPETScError(ierr));
+  ierr = VecDestroy(&rhs);
+  AssertNothrow(ierr == 0, ExcPETScError(ierr));
+  ierr = MatDestroy(&nested_matrix);
+  AssertNothrow(ierr == 0, ExcPETScError(ierr));
+  (void)ierr;
+}
+
+void FieldSplitSolver::clear()
+{
+  PetscErrorCode ierr;
+  if (ksp)
+    {
+      ierr = KSPDestroy(&ksp);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+  if (solution)
+    {
+      ierr = VecDestroy(&solution);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+  if (rhs)
+    {
+      ierr = VecDestroy(&rhs);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+  if (nested_matrix)
+    {
+      ierr = MatDestroy(&nested_matrix);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+}
+
+bool FieldSplitSolver::empty() const { return ksp == nullptr; }
+
+void FieldSplitSolver::setup(const PETScWrappers::MPI::BlockSparseMatrix &A)
+{
+  AssertThrow(A.n_block_rows() == 2 && A.n_block_cols() == 2,
+              ExcMessage("Field split needs a velocity-pressure system!"));
+  clear();
+
+  MPI_Comm comm = A.get_mpi_communicator();
+
+  // The nested matrix references the blocks, nothing is copied
+  Mat blocks[4] = {A.block(0, 0), A.block(0, 1), A.block(1, 0), A.block(1, 1)};
+  PetscErrorCode ierr =
+    MatCreateNest(comm, 2, nullptr, 2, nullptr, blocks, &nested_matrix);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = MatCreateVecs(nested_matrix, &solution, &rhs);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+  ierr = KSPCreate(comm, &ksp);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = KSPSetOperators(ksp, nested_matrix, nested_matrix);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = KSPSetOptionsPrefix(ksp, "fluid_");
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  // The preconditioner may contain inner Krylov solves
+  ierr = KSPSetType(ksp, KSPFGMRES);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = KSPSetInitialGuessNonzero(ksp, PETSC_TRUE);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  // Convergence is checked against the absolute tolerance of the solver
+  // control, as the deal.II solvers do.
+  ierr =
+    KSPSetTolerances(ksp, 1e-50, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+  PC pc;
+  ierr = KSPGetPC(ksp, &pc);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = PCSetType(pc, PCFIELDSPLIT);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  IS fields[2];
+  ierr = MatNestGetISs(nested_matrix, fields, nullptr);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = PCFieldSplitSetIS(pc, "u", fields[0]);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = PCFieldSplitSetIS(pc, "p", fields[1]);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  if (additional_data.split_type == "Schur")
+    {
+      ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_SCHUR);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+      // Precondition the Schur complement with
+      // App - Apv * diag(Avv)^-1 * Avp, which is assembled explicitly.
+      ierr =
+        PCFieldSplitSetSchurPre(pc, PC_FIELDSPLIT_SCHUR_PRE_SELFP, nullptr);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+  else if (additional_data.split_type == "Multiplicative")
+    {
+      ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_MULTIPLICATIVE);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+  else
+    {
+      ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_ADDITIVE);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+
+  // Options from the parameter file are added to the ones from the command
+  // line.
+  ierr = PetscOptionsInsertString(nullptr, additional_data.options.c_str());
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = KSPSetFromOptions(ksp);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = KSPSetUp(ksp);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+}
+
+void FieldSplitSolver::solve(const PETScWrappers::MPI::BlockSparseMatrix &A,
+                             PETScWrappers::MPI::BlockVector &x,
+                             const PETScWrappers::MPI::BlockVector &b,
+                             SolverControl &solver_control,
+                             const bool update_preconditioner)
+{
+  if (update_preconditioner || empty())
+    {
+      setup(A);
+    }
+
+  PetscReal rtol, dtol;
+  PetscErrorCode ierr = KSPGetTolerances(ksp, &rtol, nullptr, &dtol, nullptr);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = KSPSetTolerances(
+    ksp, rtol, solver_control.tolerance(), dtol, solver_control.max_steps());
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      Vec sub_vector;
+      ierr = VecNestGetSubVec(rhs, i, &sub_vector);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+      ierr = VecCopy(b.block(i), sub_vector);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+      ierr = VecNestGetSubVec(solution, i, &sub_vector);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+      ierr = VecCopy(x.block(i), sub_vector);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+
+  ierr = KSPSolve(ksp, rhs, solution);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      Vec sub_vector;
+      ierr = VecNestGetSubVec(solution, i, &sub_vector);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+      ierr = VecCopy(sub_vector, x.block(i));
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+
+  PetscInt n_iterations;
+  PetscReal residual;
+  KSPConvergedReason reason;
+  ierr = KSPGetIterationNumber(ksp, &n_iterations);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = KSPGetResidualNorm(ksp, &residual);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  ierr = KSPGetConvergedReason(ksp, &reason);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  solver_control.check(n_iterations, residual);
+  AssertThrow(reason > 0,
+              SolverControl::NoConvergence(n_iterations, residual));
+}
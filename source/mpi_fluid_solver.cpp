@@ -20,9 +20,12 @@ namespace Fluid
 
     template <int dim>
     FluidSolver<dim>::FluidSolver(
-      parallel::distributed::Triangulation<dim> &tria,
+      parallel::DistributedTriangulationBase<dim> &tria,
       const Parameters::AllParameters &parameters)
       : triangulation(tria),
+        fully_distributed(
+          dynamic_cast<parallel::fullydistributed::Triangulation<dim> *>(
+            &tria) != nullptr),
         fe(FE_Q<dim>(parameters.fluid_velocity_degree),
            dim,
            FE_Q<dim>(parameters.fluid_pressure_degree),
@@ -33,7 +36,7 @@ namespace Fluid
         volume_quad_formula(parameters.fluid_velocity_degree + 1),
         face_quad_formula(parameters.fluid_velocity_degree + 1),
         parameters(parameters),
-        mpi_communicator(MPI_COMM_WORLD),
+        mpi_communicator(tria.get_communicator()),
         pcout(std::cout,
               Utilities::MPI::this_mpi_process(mpi_communicator) == 0),
         time(parameters.end_time,
@@ -41,11 +44,19 @@ namespace Fluid
              parameters.output_interval,
              parameters.refinement_interval,
              parameters.save_interval),
+        time_step_controller(parameters),
         timer(
           mpi_communicator, pcout, TimerOutput::never, TimerOutput::wall_times),
         timer2(
-          mpi_communicator, pcout, TimerOutput::never, TimerOutput::wall_times)
+          mpi_communicator, pcout, TimerOutput::never, TimerOutput::wall_times),
+        field_split_solver(FieldSplitSolver::AdditionalData(
+          parameters.field_split_type, parameters.fluid_petsc_options))
     {
+      AssertThrow(!fully_distributed ||
+                    (parameters.global_refinements[0] == 0 &&
+                     parameters.refinement_interval >= parameters.end_time),
+                  ExcMessage("A fully distributed fluid mesh can not be "
+                             "refined, partition the refined mesh instead!"));
     }
 
     template <int dim>
@@ -285,6 +296,7 @@ namespace Fluid
     template <int dim>
     void FluidSolver<dim>::initialize_system()
     {
+      field_split_solver.clear();
       system_matrix.clear();
       mass_matrix.clear();
       mass_schur.clear();
@@ -401,8 +413,13 @@ namespace Fluid
                                          present_solution,
                                          estimated_error_per_cell,
                                          fe.component_mask(velocity));
+      // The constructor makes sure the mesh is not fully distributed
       parallel::distributed::GridRefinement::refine_and_coarsen_fixed_fraction(
-        triangulation, estimated_error_per_cell, 0.6, 0.4);
+        dynamic_cast<parallel::distributed::Triangulation<dim> &>(
+          triangulation),
+        estimated_error_per_cell,
+        0.6,
+        0.4);
       if (triangulation.n_levels() > max_grid_level)
         {
           for (auto cell = triangulation.begin_active(max_grid_level);
@@ -569,6 +586,15 @@ namespace Fluid
               pcout << "Removing " << *checkpoints.begin() << std::endl;
               fs::path to_be_removed(*checkpoints.begin());
               fs::remove(to_be_removed);
+              for (unsigned int i = 0;
+                   fully_distributed &&
+                   i < Utilities::MPI::n_mpi_processes(mpi_communicator);
+                   ++i)
+                {
+                  fs::remove(to_be_removed.string() + "_" +
+                             Utilities::int_to_string(i, 4));
+                }
+              fs::remove(to_be_removed.string() + "_time");
               to_be_removed.replace_extension(".fluid_checkpoint.info");
               fs::remove(to_be_removed);
               checkpoints.erase(checkpoints.begin());
@@ -577,12 +603,53 @@ namespace Fluid
       // Name the checkpoint file
       std::string checkpoint_file = Utilities::int_to_string(output_index, 6);
       checkpoint_file.append(".fluid_checkpoint");
-      // Save the solution
-      parallel::distributed::SolutionTransfer<dim,
-                                              PETScWrappers::MPI::BlockVector>
-        sol_trans(dof_handler);
-      sol_trans.prepare_for_serialization(present_solution);
-      triangulation.save(checkpoint_file.c_str());
+      if (fully_distributed)
+        {
+          // p4est can not store a fully distributed mesh, which is read from
+          // the same partitions on restart anyway. So every process writes
+          // its locally owned part of the solution, and the checkpoint file
+          // only marks the time step.
+          std::ofstream local_file(
+            checkpoint_file + "_" +
+              Utilities::int_to_string(triangulation.locally_owned_subdomain(),
+                                       4),
+            std::ios::binary);
+          for (unsigned int b = 0; b < present_solution.n_blocks(); ++b)
+            {
+              const types::global_dof_index n_owned =
+                owned_partitioning[b].n_elements();
+              local_file.write(reinterpret_cast<const char *>(&n_owned),
+                               sizeof(n_owned));
+              for (const auto i : owned_partitioning[b])
+                {
+                  const double value = present_solution.block(b)(i);
+                  local_file.write(reinterpret_cast<const char *>(&value),
+                                   sizeof(value));
+                }
+            }
+          if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+            {
+              std::ofstream marker(checkpoint_file);
+              marker << Utilities::MPI::n_mpi_processes(mpi_communicator)
+                     << std::endl;
+            }
+        }
+      else
+        {
+          // Save the solution
+          parallel::distributed::SolutionTransfer<
+            dim,
+            PETScWrappers::MPI::BlockVector>
+            sol_trans(dof_handler);
+          sol_trans.prepare_for_serialization(present_solution);
+          dynamic_cast<parallel::distributed::Triangulation<dim> &>(
+            triangulation)
+            .save(checkpoint_file.c_str());
+        }
+      if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+        {
+          time.save(checkpoint_file + "_time", times_and_names);
+        }
       pcout << "Checkpoint file successfully saved at time step "
             << output_index << "!" << std::endl;
     }
@@ -615,47 +682,106 @@ namespace Fluid
       // set time step load the checkpoint file
       pcout << "Loading checkpoint file " << checkpoint_file.filename().c_str()
             << "!" << std::endl;
-      triangulation.load(checkpoint_file.filename().c_str());
+      if (!fully_distributed)
+        {
+          dynamic_cast<parallel::distributed::Triangulation<dim> &>(
+            triangulation)
+            .load(checkpoint_file.filename().c_str());
+        }
       setup_dofs();
       make_constraints();
       initialize_system();
-      parallel::distributed::SolutionTransfer<dim,
-                                              PETScWrappers::MPI::BlockVector>
-        sol_trans(dof_handler);
       PETScWrappers::MPI::BlockVector tmp;
       tmp.reinit(owned_partitioning, mpi_communicator);
-      sol_trans.deserialize(tmp);
-      present_solution = tmp;
-      // Update the time and names to set the current time and write
-      // correct .pvd file.
-
-      for (int i = 0; i <= Utilities::string_to_int(checkpoint_file.stem());
-           ++i)
+      if (fully_distributed)
         {
-          if ((time.current() == 0 || time.time_to_output()) &&
-              Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+          // The mesh is already there, read the local part of the solution
+          const std::string local_name =
+            checkpoint_file.filename().string() + "_" +
+            Utilities::int_to_string(triangulation.locally_owned_subdomain(),
+                                     4);
+          std::ifstream local_file(local_name, std::ios::binary);
+          AssertThrow(local_file,
+                      ExcMessage("Cannot open checkpoint file " + local_name));
+          for (unsigned int b = 0; b < tmp.n_blocks(); ++b)
             {
-              std::string basename =
-                "fluid" + Utilities::int_to_string(time.get_timestep(), 6) +
-                "-";
-              for (unsigned int j = 0;
-                   j < Utilities::MPI::n_mpi_processes(mpi_communicator);
-                   ++j)
+              types::global_dof_index n_owned = 0;
+              local_file.read(reinterpret_cast<char *>(&n_owned),
+                              sizeof(n_owned));
+              AssertThrow(local_file &&
+                            n_owned == owned_partitioning[b].n_elements(),
+                          ExcMessage("The fluid checkpoint was written with "
+                                     "different partitions!"));
+              std::vector<types::global_dof_index> indices;
+              std::vector<PetscScalar> values(n_owned);
+              for (const auto i : owned_partitioning[b])
                 {
-                  times_and_names.push_back(
-                    {time.current(),
-                     basename + Utilities::int_to_string(j, 4) + ".vtu"});
+                  indices.push_back(i);
                 }
+              local_file.read(reinterpret_cast<char *>(values.data()),
+                              n_owned * sizeof(PetscScalar));
+              AssertThrow(local_file,
+                          ExcMessage("Incomplete checkpoint file " +
+                                     local_name));
+              tmp.block(b).set(indices, values);
             }
-          if (i == Utilities::string_to_int(checkpoint_file.stem()))
-            break;
-          time.increment();
-          // Update the time for hard coded boundary conditions
-          if (!this->hard_coded_boundary_values.empty())
+          tmp.compress(VectorOperation::insert);
+        }
+      else
+        {
+          parallel::distributed::SolutionTransfer<
+            dim,
+            PETScWrappers::MPI::BlockVector>
+            sol_trans(dof_handler);
+          sol_trans.deserialize(tmp);
+        }
+      present_solution = tmp;
+      // Restore the time and the names to write the correct .pvd file.
+      const std::string time_file =
+        checkpoint_file.filename().string() + "_time";
+      if (fs::exists(time_file))
+        {
+          time.load(time_file, times_and_names);
+          for (auto &bc : hard_coded_boundary_values)
             {
-              for (auto &bc : hard_coded_boundary_values)
+              bc.second.set_time(time.current());
+            }
+        }
+      else
+        {
+          // Older checkpoints only have the number of the time step, from
+          // which the time is rebuilt with the current step size.
+          AssertThrow(!parameters.adaptive_time_stepping,
+                      ExcMessage("The checkpoint has no time to restart "
+                                 "with adaptive time steps!"));
+          for (int i = 0; i <= Utilities::string_to_int(checkpoint_file.stem());
+               ++i)
+            {
+              if ((time.current() == 0 || time.time_to_output()) &&
+                  Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
                 {
-                  bc.second.advance_time(time.get_delta_t());
+                  std::string basename =
+                    "fluid" + Utilities::int_to_string(time.get_timestep(), 6) +
+                    "-";
+                  for (unsigned int j = 0;
+                       j < Utilities::MPI::n_mpi_processes(mpi_communicator);
+                       ++j)
+                    {
+                      times_and_names.push_back(
+                        {time.current(),
+                         basename + Utilities::int_to_string(j, 4) + ".vtu"});
+                    }
+                }
+              if (i == Utilities::string_to_int(checkpoint_file.stem()))
+                break;
+              time.increment();
+              // Update the time for hard coded boundary conditions
+              if (!this->hard_coded_boundary_values.empty())
+                {
+                  for (auto &bc : hard_coded_boundary_values)
+                    {
+                      bc.second.advance_time(time.get_delta_t());
+                    }
                 }
             }
         }
@@ -665,6 +791,26 @@ namespace Fluid
       return true;
     }
 
+    template <int dim>
+    void FluidSolver<dim>::save_state()
+    {
+      saved_solution = present_solution;
+      saved_increment = solution_increment;
+      saved_time = time.get_state();
+      n_saved_outputs = times_and_names.size();
+    }
+
+    template <int dim>
+    void FluidSolver<dim>::restore_state()
+    {
+      AssertThrow(saved_solution.size() == present_solution.size(),
+                  ExcMessage("No state of this mesh was saved!"));
+      present_solution = saved_solution;
+      solution_increment = saved_increment;
+      time.set_state(saved_time);
+      times_and_names.resize(n_saved_outputs);
+    }
+
     template <int dim>
     void FluidSolver<dim>::update_stress()
     {
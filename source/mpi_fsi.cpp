@@ -1,8 +1,46 @@
 #include "mpi_fsi.h"
+#include <deal.II/base/parallel.h>
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <set>
+#include <sstream>
 
 namespace MPI
 {
+  namespace
+  {
+    /// Number of cells or points a thread works on at once in the coupling.
+    const unsigned int coupling_grainsize = 32;
+  } // namespace
+
+  SplitCommunicators::SplitCommunicators(const Parameters::AllParameters &p)
+    : fluid(MPI_COMM_WORLD), solid(MPI_COMM_WORLD), group(MPI_COMM_NULL)
+  {
+    if (p.solid_processes == 0)
+      {
+        return;
+      }
+    const unsigned int n_processes =
+      Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+    const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    AssertThrow(p.solid_processes < n_processes,
+                ExcMessage("No process is left for the fluid!"));
+    const bool is_solid_process = rank + p.solid_processes >= n_processes;
+    MPI_Comm_split(
+      MPI_COMM_WORLD, static_cast<int>(is_solid_process), rank, &group);
+    fluid = is_solid_process ? MPI_COMM_SELF : group;
+    solid = is_solid_process ? group : MPI_COMM_SELF;
+  }
+
+  SplitCommunicators::~SplitCommunicators()
+  {
+    if (group != MPI_COMM_NULL)
+      {
+        MPI_Comm_free(&group);
+      }
+  }
+
   template <int dim>
   FSI<dim>::~FSI()
   {
@@ -18,18 +56,65 @@ namespace MPI
       solid_solver(s),
       parameters(p),
       mpi_communicator(MPI_COMM_WORLD),
+      n_solid_processes(parameters.solid_processes),
+      is_fluid_process(Utilities::MPI::this_mpi_process(mpi_communicator) +
+                         n_solid_processes <
+                       Utilities::MPI::n_mpi_processes(mpi_communicator)),
+      is_solid_process(n_solid_processes == 0 || !is_fluid_process),
       pcout(std::cout, Utilities::MPI::this_mpi_process(mpi_communicator) == 0),
       time(parameters.end_time,
            parameters.time_step,
            parameters.output_interval,
            parameters.refinement_interval,
            parameters.save_interval),
-      timer(
-        mpi_communicator, pcout, TimerOutput::never, TimerOutput::wall_times),
+      // The timer sections are synchronized within the own group only
+      timer(is_fluid_process ? fluid_solver.mpi_communicator
+                             : solid_solver.mpi_communicator,
+            pcout,
+            TimerOutput::never,
+            TimerOutput::wall_times),
       penetration_criterion(nullptr),
-      use_dirichlet_bc(use_dirichlet_bc)
+      use_dirichlet_bc(use_dirichlet_bc),
+      coupling_wait_time(0),
+      coupling_accelerator(parameters)
   {
     solid_box.reinit(2 * dim);
+    AssertThrow(!parameters.adaptive_time_stepping ||
+                  (parameters.fluid_steps_per_solid_step == 1 &&
+                   parameters.solid_steps_per_fluid_step == 1),
+                ExcMessage("Adaptive time stepping requires the fluid and "
+                           "the solid to take the same time steps!"));
+    AssertThrow(parameters.max_coupling_iterations == 1 ||
+                  (!parameters.pipelined_coupling &&
+                   parameters.fluid_steps_per_solid_step == 1 &&
+                   parameters.solid_steps_per_fluid_step == 1),
+                ExcMessage("Coupling iterations can not be pipelined or "
+                           "multirate!"));
+    if (n_solid_processes > 0)
+      {
+        const unsigned int n_fluid_processes =
+          Utilities::MPI::n_mpi_processes(mpi_communicator) -
+          n_solid_processes;
+        AssertThrow(
+          Utilities::MPI::n_mpi_processes(fluid_solver.mpi_communicator) ==
+              (is_fluid_process ? n_fluid_processes : 1) &&
+            Utilities::MPI::n_mpi_processes(solid_solver.mpi_communicator) ==
+              (is_solid_process ? n_solid_processes : 1),
+          ExcMessage("Construct the solvers with the communicators of "
+                     "MPI::SplitCommunicators!"));
+        // The solver copies that are not run keep quiet
+        if (!is_fluid_process)
+          {
+            fluid_solver.pcout.set_condition(false);
+            fluid_solver.timer.disable_output();
+            fluid_solver.timer2.disable_output();
+          }
+        if (!is_solid_process)
+          {
+            solid_solver.pcout.set_condition(false);
+            solid_solver.timer.disable_output();
+          }
+      }
   }
 
   template <int dim>
@@ -223,26 +308,46 @@ namespace MPI
   template <int dim>
   void FSI<dim>::setup_cell_hints()
   {
-    unsigned int n_unit_points =
-      fluid_solver.fe.get_unit_support_points().size();
-    for (auto cell = fluid_solver.triangulation.begin_active();
-         cell != fluid_solver.triangulation.end();
-         ++cell)
+    cell_hints.setup(fluid_solver.triangulation,
+                     solid_solver.dof_handler,
+                     fluid_solver.fe.get_unit_support_points().size());
+  }
+
+  template <int dim>
+  void FSI<dim>::save_cell_hints(const int output_index) const
+  {
+    if (Utilities::MPI::this_mpi_process(fluid_solver.mpi_communicator) == 0)
       {
-        if (!cell->is_artificial())
+        // Keep the hints of the same checkpoints as the fluid solver does
+        std::set<fs::path> hint_files;
+        for (const auto &p : fs::directory_iterator(fs::current_path()))
           {
-            cell_hints.initialize(cell, n_unit_points);
-            const std::vector<
-              std::shared_ptr<typename DoFHandler<dim>::active_cell_iterator>>
-              hints = cell_hints.get_data(cell);
-            Assert(hints.size() == n_unit_points,
-                   ExcMessage("Wrong number of cell hints!"));
-            for (unsigned int v = 0; v < n_unit_points; ++v)
+            if (p.path().extension() == ".fsi_hints")
               {
-                // Initialize the hints with the begin iterators!
-                *(hints[v]) = solid_solver.dof_handler.begin_active();
+                hint_files.insert(p.path());
               }
           }
+        while (hint_files.size() > 1)
+          {
+            fs::remove(*hint_files.begin());
+            hint_files.erase(hint_files.begin());
+          }
+      }
+    cell_hints.save(Utilities::int_to_string(output_index, 6) + ".fsi_hints",
+                    fluid_solver.triangulation);
+  }
+
+  template <int dim>
+  void FSI<dim>::load_cell_hints()
+  {
+    const std::string hints_file =
+      Utilities::int_to_string(time.get_timestep(), 6) + ".fsi_hints";
+    if (!cell_hints.load(hints_file,
+                         fluid_solver.triangulation,
+                         fluid_solver.fe.get_unit_support_points().size()))
+      {
+        pcout << "Did not find " << hints_file
+              << ", searching for the solid cells from scratch." << std::endl;
       }
   }
 
@@ -252,7 +357,11 @@ namespace MPI
     move_solid_mesh(true);
     Vector<double> localized_solid_displacement(
       solid_solver.current_displacement);
+    // Collect the solid vertices to update
     std::vector<bool> vertex_touched(solid_solver.dof_handler.n_dofs(), false);
+    std::vector<
+      std::pair<typename DoFHandler<dim>::active_cell_iterator, unsigned int>>
+      vertices;
     for (auto cell : solid_solver.dof_handler.active_cell_iterators())
       {
         for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
@@ -261,20 +370,48 @@ namespace MPI
                 !solid_solver.constraints.is_constrained(cell->vertex_index(v)))
               {
                 vertex_touched[cell->vertex_index(v)] = true;
-                Point<dim> point = cell->vertex(v);
-                Vector<double> tmp(dim + 1);
-                VectorTools::point_value(fluid_solver.dof_handler,
-                                         fluid_solver.present_solution,
-                                         point,
-                                         tmp);
-                for (unsigned int d = 0; d < dim; ++d)
-                  {
-                    localized_solid_displacement[cell->vertex_dof_index(
-                      v, d)] += tmp[d] * time.get_delta_t();
-                  }
+                vertices.push_back({cell, v});
               }
           }
       }
+    // Locating the vertices in the fluid mesh is done on multiple threads.
+    // PETSc vectors are not thread-safe, so the fluid velocity is evaluated
+    // afterwards, in the same way as VectorTools::point_value.
+    std::vector<
+      std::pair<typename DoFHandler<dim>::active_cell_iterator, Point<dim>>>
+      cell_points(vertices.size());
+    parallel::apply_to_subranges(
+      0u,
+      static_cast<unsigned int>(vertices.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            cell_points[i] = GridTools::find_active_cell_around_point(
+              StaticMappingQ1<dim>::mapping,
+              fluid_solver.dof_handler,
+              vertices[i].first->vertex(vertices[i].second));
+          }
+      },
+      coupling_grainsize);
+    for (unsigned int i = 0; i < vertices.size(); ++i)
+      {
+        AssertThrow(cell_points[i].first->is_locally_owned(),
+                    VectorTools::ExcPointNotAvailableHere());
+        const Quadrature<dim> quadrature(
+          GeometryInfo<dim>::project_to_unit_cell(cell_points[i].second));
+        FEValues<dim> fe_values(StaticMappingQ1<dim>::mapping,
+                                fluid_solver.fe,
+                                quadrature,
+                                update_values);
+        fe_values.reinit(cell_points[i].first);
+        std::vector<Vector<double>> tmp(1, Vector<double>(dim + 1));
+        fe_values.get_function_values(fluid_solver.present_solution, tmp);
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            localized_solid_displacement[vertices[i].first->vertex_dof_index(
+              vertices[i].second, d)] += tmp[0][d] * time.get_delta_t();
+          }
+      }
     move_solid_mesh(false);
     solid_solver.current_displacement = localized_solid_displacement;
   }
@@ -290,27 +427,41 @@ namespace MPI
   {
     TimerOutput::Scope timer_section(timer, "Update indicator");
     move_solid_mesh(true);
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
     for (auto f_cell = fluid_solver.dof_handler.begin_active();
          f_cell != fluid_solver.dof_handler.end();
          ++f_cell)
       {
-        if (!f_cell->is_locally_owned())
+        if (f_cell->is_locally_owned())
           {
-            continue;
+            cells.push_back(f_cell);
           }
-        auto p = fluid_solver.cell_property.get_data(f_cell);
-        int inside_count = 0;
-        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      }
+    // Every cell only writes its own indicator, so the cells are handled
+    // on multiple threads.
+    parallel::apply_to_subranges(
+      0u,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int c = begin; c < end; ++c)
           {
-            if (!point_in_solid(solid_solver.dof_handler, f_cell->vertex(v)))
+            auto p = fluid_solver.cell_property.get_data(cells[c]);
+            int inside_count = 0;
+            for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                 ++v)
               {
-                break;
+                if (!point_in_solid(solid_solver.dof_handler,
+                                    cells[c]->vertex(v)))
+                  {
+                    break;
+                  }
+                ++inside_count;
               }
-            ++inside_count;
+            p[0]->indicator =
+              (inside_count == GeometryInfo<dim>::vertices_per_cell ? 1 : 0);
           }
-        p[0]->indicator =
-          (inside_count == GeometryInfo<dim>::vertices_per_cell ? 1 : 0);
-      }
+      },
+      coupling_grainsize);
     move_solid_mesh(false);
   }
 
@@ -367,6 +518,24 @@ namespace MPI
       fluid_solver.fe.dofs_per_cell);
     std::vector<unsigned int> dof_touched(fluid_solver.dof_handler.n_dofs(), 0);
 
+    // A fluid support point to interpolate the solid velocity to. The
+    // fluid values are evaluated beforehand since PETSc vectors are not
+    // thread-safe.
+    struct SupportPoint
+    {
+      Point<dim> point;
+      types::global_dof_index line;
+      unsigned int index; //!< The vector component of the dof.
+      typename DoFHandler<dim>::active_cell_iterator *hint;
+      Tensor<1, dim> v;        //!< Fluid velocity.
+      Tensor<1, dim> grad_v_v; //!< Fluid convective acceleration.
+      double fluid_value;      //!< Current value of the dof.
+      bool in_solid;
+      //! The solid cell the point is in.
+      typename DoFHandler<dim>::active_cell_iterator solid_cell;
+    };
+    std::vector<SupportPoint> support_points;
+
     for (auto f_cell = fluid_solver.dof_handler.begin_active();
          f_cell != fluid_solver.dof_handler.end();
          ++f_cell)
@@ -383,11 +552,17 @@ namespace MPI
             auto ptr = fluid_solver.cell_property.get_data(f_cell);
             if (ptr[0]->indicator == 0)
               continue;
+          }
+        else if (!use_dirichlet_bc)
+          {
+            continue;
+          }
 
-            auto hints = cell_hints.get_data(f_cell);
-            dummy_fe_values.reinit(f_cell);
-            f_cell->get_dof_indices(dof_indices);
-            auto support_points = dummy_fe_values.get_quadrature_points();
+        auto hints = cell_hints.get(f_cell);
+        dummy_fe_values.reinit(f_cell);
+        f_cell->get_dof_indices(dof_indices);
+        if (!use_dirichlet_bc)
+          {
             // Fluid velocity at support points
             dummy_fe_values[velocities].get_function_values(
               fluid_solver.present_solution, v);
@@ -400,138 +575,161 @@ namespace MPI
             // Fluid pressure at support points
             dummy_fe_values[pressure].get_function_values(
               fluid_solver.present_solution, p);
-            // Loop over the support points to calculate fsi acceleration.
-            for (unsigned int i = 0; i < unit_points.size(); ++i)
+          }
+        // Loop over the support points to collect the unset dofs.
+        for (unsigned int i = 0; i < unit_points.size(); ++i)
+          {
+            // Skip the already-set dofs.
+            if (dof_touched[dof_indices[i]] != 0)
+              continue;
+            auto base_index = fluid_solver.fe.system_to_base_index(i);
+            const unsigned int i_group = base_index.first.first;
+            Assert(
+              i_group < 2,
+              ExcMessage("There should be only 2 groups of finite element!"));
+            if (i_group == 1)
+              continue; // skip the pressure dofs
+            bool inside = true;
+            for (unsigned int d = 0; d < dim; ++d)
+              if (std::abs(unit_points[i][d]) < 1e-5)
+                {
+                  inside = false;
+                  break;
+                }
+            if (inside)
+              continue; // skip the in-cell support point
+            // Same as fluid_solver.fe.system_to_base_index(i).first.second;
+            const unsigned int index =
+              fluid_solver.fe.system_to_component_index(i).first;
+            Assert(index < dim,
+                   ExcMessage("Vector component should be less than dim!"));
+            dof_touched[dof_indices[i]] = 1;
+            SupportPoint support_point;
+            support_point.point = dummy_fe_values.quadrature_point(i);
+            support_point.line = dof_indices[i];
+            support_point.index = index;
+            support_point.hint = hints[i].get();
+            if (use_dirichlet_bc)
               {
-                // Skip the already-set dofs.
-                if (dof_touched[dof_indices[i]] != 0)
-                  continue;
-                auto base_index = fluid_solver.fe.system_to_base_index(i);
-                const unsigned int i_group = base_index.first.first;
-                Assert(i_group < 2,
-                       ExcMessage(
-                         "There should be only 2 groups of finite element!"));
-                if (i_group == 1)
-                  continue; // skip the pressure dofs
-                bool inside = true;
-                for (unsigned int d = 0; d < dim; ++d)
-                  if (std::abs(unit_points[i][d]) < 1e-5)
-                    {
-                      inside = false;
-                      break;
-                    }
-                if (inside)
-                  continue; // skip the in-cell support point
-                // Same as fluid_solver.fe.system_to_base_index(i).first.second;
-                const unsigned int index =
-                  fluid_solver.fe.system_to_component_index(i).first;
-                Assert(index < dim,
-                       ExcMessage("Vector component should be less than dim!"));
-                dof_touched[dof_indices[i]] = 1;
-                if (!point_in_solid(solid_solver.dof_handler,
-                                    support_points[i]))
-                  continue;
-                Utils::CellLocator<dim, DoFHandler<dim>> locator(
-                  solid_solver.dof_handler, support_points[i], *(hints[i]));
-                *(hints[i]) = locator.search();
-                Utils::GridInterpolator<dim, Vector<double>> interpolator(
-                  solid_solver.dof_handler, support_points[i], {}, *(hints[i]));
-                if (!interpolator.found_cell())
-                  {
-                    std::stringstream message;
-                    message
-                      << "Cannot find point in solid: " << support_points[i]
-                      << std::endl;
-                    AssertThrow(interpolator.found_cell(),
-                                ExcMessage(message.str()));
-                  }
-                // Solid acceleration at fluid unit point
-                Vector<double> solid_acc(dim);
-                Vector<double> solid_vel(dim);
-                interpolator.point_value(localized_solid_acceleration,
-                                         solid_acc);
-                interpolator.point_value(localized_solid_velocity, solid_vel);
-                Tensor<1, dim> vs;
-                for (int j = 0; j < dim; ++j)
-                  {
-                    vs[j] = solid_vel[j];
-                  }
-                // Fluid total acceleration at support points
-                Tensor<1, dim> fluid_acc =
-                  (vs - v[i]) / time.get_delta_t() + grad_v[i] * v[i];
-                auto line = dof_indices[i];
-                // Note that we are setting the value of the constraint to the
-                // velocity delta!
-                tmp_fsi_acceleration(line) =
-                  fluid_acc[index] - solid_acc[index];
+                support_point.fluid_value =
+                  fluid_solver.present_solution(dof_indices[i]);
+              }
+            else
+              {
+                support_point.v = v[i];
+                support_point.grad_v_v = grad_v[i] * v[i];
               }
+            support_point.in_solid = false;
+            support_points.push_back(support_point);
           }
-        // Dirichlet BCs
-        if (use_dirichlet_bc)
-          {
-            dummy_fe_values.reinit(f_cell);
-            f_cell->get_dof_indices(dof_indices);
-            auto support_points = dummy_fe_values.get_quadrature_points();
-            auto hints = cell_hints.get_data(f_cell);
-            // Declare the fluid velocity for interpolating BC
-            Vector<double> fluid_velocity(dim);
-            // Loop over the support points to set Dirichlet BCs.
-            for (unsigned int i = 0; i < unit_points.size(); ++i)
+      }
+
+    // Searching the solid mesh is the expensive part, which is done on
+    // multiple threads. Every support point has its own hint and result,
+    // so there is no conflict.
+    parallel::apply_to_subranges(
+      0u,
+      static_cast<unsigned int>(support_points.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int k = begin; k < end; ++k)
+          {
+            SupportPoint &support_point = support_points[k];
+            if (!point_in_solid(solid_solver.dof_handler, support_point.point))
+              continue;
+            support_point.in_solid = true;
+            Utils::CellLocator<dim, DoFHandler<dim>> locator(
+              solid_solver.dof_handler,
+              support_point.point,
+              *support_point.hint);
+            support_point.solid_cell = locator.search();
+            if (!locator.found_cell())
               {
-                // Skip the already-set dofs.
-                if (dof_touched[dof_indices[i]] != 0)
-                  continue;
-                auto base_index = fluid_solver.fe.system_to_base_index(i);
-                const unsigned int i_group = base_index.first.first;
-                Assert(i_group < 2,
-                       ExcMessage(
-                         "There should be only 2 groups of finite element!"));
-                if (i_group == 1)
-                  continue; // skip the pressure dofs
-                bool inside = true;
-                for (unsigned int d = 0; d < dim; ++d)
-                  if (std::abs(unit_points[i][d]) < 1e-5)
-                    {
-                      inside = false;
-                      break;
-                    }
-                if (inside)
-                  continue; // skip the in-cell support point
-                // Same as fluid_solver.fe.system_to_base_index(i).first.second;
-                const unsigned int index =
-                  fluid_solver.fe.system_to_component_index(i).first;
-                Assert(index < dim,
-                       ExcMessage("Vector component should be less than dim!"));
-                dof_touched[dof_indices[i]] = 1;
-                if (!point_in_solid(solid_solver.dof_handler,
-                                    support_points[i]))
+                std::stringstream message;
+                message << "Cannot find point in solid: "
+                        << support_point.point << std::endl;
+                AssertThrow(locator.found_cell(), ExcMessage(message.str()));
+              }
+            *support_point.hint = support_point.solid_cell;
+          }
+      },
+      coupling_grainsize);
+
+    // Group the support points by the solid cell they are in, so that the
+    // solid dof values are read once per cell for all of its points.
+    std::vector<unsigned int> order;
+    for (unsigned int k = 0; k < support_points.size(); ++k)
+      {
+        if (support_points[k].in_solid)
+          {
+            order.push_back(k);
+          }
+      }
+    std::stable_sort(
+      order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+        return support_points[a].solid_cell < support_points[b].solid_cell;
+      });
+
+    const FiniteElement<dim> &solid_fe = solid_solver.fe;
+    MappingQ1<dim> solid_mapping;
+    Vector<double> solid_vel(solid_fe.dofs_per_cell);
+    Vector<double> solid_acc(solid_fe.dofs_per_cell);
+    for (auto first = order.begin(); first != order.end();)
+      {
+        const auto s_cell = support_points[*first].solid_cell;
+        s_cell->get_dof_values(localized_solid_velocity, solid_vel);
+        if (!use_dirichlet_bc)
+          {
+            s_cell->get_dof_values(localized_solid_acceleration, solid_acc);
+          }
+        auto last = first;
+        for (; last != order.end(); ++last)
+          {
+            if (support_points[*last].solid_cell != s_cell)
+              break;
+            const SupportPoint &support_point = support_points[*last];
+            Point<dim> unit_point;
+            if (!Utils::GridInterpolator<dim, Vector<double>>::
+                  affine_real_to_unit_cell(
+                    s_cell, support_point.point, unit_point))
+              {
+                unit_point = solid_mapping.transform_real_to_unit_cell(
+                  s_cell, support_point.point);
+              }
+            unit_point = GeometryInfo<dim>::project_to_unit_cell(unit_point);
+            // Only the component of the fluid dof is needed
+            const unsigned int index = support_point.index;
+            double vs = 0, as = 0;
+            for (unsigned int i = 0; i < solid_fe.dofs_per_cell; ++i)
+              {
+                if (solid_fe.system_to_component_index(i).first != index)
                   continue;
-                Utils::CellLocator<dim, DoFHandler<dim>> locator(
-                  solid_solver.dof_handler, support_points[i], *(hints[i]));
-                *(hints[i]) = locator.search();
-                Utils::GridInterpolator<dim, Vector<double>> interpolator(
-                  solid_solver.dof_handler, support_points[i], {}, *(hints[i]));
-                if (!interpolator.found_cell())
+                const double phi = solid_fe.shape_value(i, unit_point);
+                vs += solid_vel[i] * phi;
+                if (!use_dirichlet_bc)
                   {
-                    std::stringstream message;
-                    message
-                      << "Cannot find point in solid: " << support_points[i]
-                      << std::endl;
-                    AssertThrow(interpolator.found_cell(),
-                                ExcMessage(message.str()));
+                    as += solid_acc[i] * phi;
                   }
-                interpolator.point_value(localized_solid_velocity,
-                                         fluid_velocity);
-                auto line = dof_indices[i];
+              }
+            auto line = support_point.line;
+            if (use_dirichlet_bc)
+              {
                 inner_nonzero.add_line(line);
                 inner_zero.add_line(line);
                 // Note that we are setting the value of the constraint to the
                 // velocity delta!
-                inner_nonzero.set_inhomogeneity(
-                  line,
-                  fluid_velocity[index] - fluid_solver.present_solution(line));
+                inner_nonzero.set_inhomogeneity(line,
+                                                vs - support_point.fluid_value);
+              }
+            else
+              {
+                // Fluid total acceleration at the support point
+                const double fluid_acc =
+                  (vs - support_point.v[index]) / time.get_delta_t() +
+                  support_point.grad_v_v[index];
+                tmp_fsi_acceleration(line) = fluid_acc - as;
               }
           }
+        first = last;
       }
     tmp_fsi_acceleration.compress(VectorOperation::insert);
     fluid_solver.fsi_acceleration = tmp_fsi_acceleration;
@@ -555,15 +753,16 @@ namespace MPI
     TimerOutput::Scope timer_section(timer, "Find solid BC");
     // Must use the updated solid coordinates
     move_solid_mesh(true);
-    // Fluid FEValues to do interpolation
-    FEValues<dim> fe_values(
-      fluid_solver.fe, fluid_solver.volume_quad_formula, update_values);
 
     for (unsigned int d = 0; d < dim; ++d)
       {
         solid_solver.fsi_stress_rows[d] = 0;
       }
 
+    // Collect the vertices on the solid boundary, together with the first
+    // of their dofs.
+    std::vector<std::pair<Point<dim>, types::global_dof_index>>
+      boundary_vertices;
     for (auto s_cell = solid_solver.dof_handler.begin_active();
          s_cell != solid_solver.dof_handler.end();
          ++s_cell)
@@ -577,54 +776,73 @@ namespace MPI
                      v < GeometryInfo<dim>::vertices_per_face;
                      ++v)
                   {
-                    auto line = s_cell->face(f)->vertex_dof_index(v, 0);
-                    // Get interpolated solution from the fluid
-                    Vector<double> value(dim + 1);
-                    Utils::GridInterpolator<dim,
-                                            PETScWrappers::MPI::BlockVector>
-                      interpolator(fluid_solver.dof_handler,
-                                   s_cell->face(f)->vertex(v),
-                                   vertices_mask);
-                    interpolator.point_value(fluid_solver.present_solution,
-                                             value);
-                    std::vector<Tensor<1, dim>> gradient(dim + 1,
-                                                         Tensor<1, dim>());
-                    interpolator.point_gradient(fluid_solver.present_solution,
-                                                gradient);
-                    // Compute stress
-                    SymmetricTensor<2, dim> sym_deformation;
-                    for (unsigned int i = 0; i < dim; ++i)
-                      {
-                        for (unsigned int j = 0; j < dim; ++j)
-                          {
-                            sym_deformation[i][j] =
-                              (gradient[i][j] + gradient[j][i]) / 2;
-                          }
-                      }
-                    // \f$ \sigma = -p\bold{I} + \mu\nabla^S v\f$
-                    SymmetricTensor<2, dim> stress =
-                      -value[dim] *
-                        Physics::Elasticity::StandardTensors<dim>::I +
-                      2 * parameters.viscosity * sym_deformation;
-                    // Assign the cell stress to local row vectors
-                    for (unsigned int d1 = 0; d1 < dim; ++d1)
-                      {
-                        for (unsigned int d2 = 0; d2 < dim; ++d2)
-                          {
-                            solid_solver.fsi_stress_rows[d1][line + d2] =
-                              stress[d1][d2];
-                          }
-                      }
-                    // End assigning local fluid stress values
-                  } // End looping support points
+                    boundary_vertices.push_back(
+                      {s_cell->face(f)->vertex(v),
+                       s_cell->face(f)->vertex_dof_index(v, 0)});
+                  }
               }
           } // End looping cell faces
       }     // End looping solid cells
+
+    // Locate the vertices in the fluid mesh on multiple threads. The
+    // interpolation reads the PETSc solution, which is not thread-safe, so
+    // it is done afterwards.
+    std::vector<std::unique_ptr<
+      Utils::GridInterpolator<dim, PETScWrappers::MPI::BlockVector>>>
+      interpolators(boundary_vertices.size());
+    parallel::apply_to_subranges(
+      0u,
+      static_cast<unsigned int>(boundary_vertices.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int k = begin; k < end; ++k)
+          {
+            interpolators[k].reset(
+              new Utils::GridInterpolator<dim,
+                                          PETScWrappers::MPI::BlockVector>(
+                fluid_solver.dof_handler,
+                boundary_vertices[k].first,
+                vertices_mask));
+          }
+      },
+      coupling_grainsize);
+
+    for (unsigned int k = 0; k < boundary_vertices.size(); ++k)
+      {
+        auto line = boundary_vertices[k].second;
+        // Get interpolated solution from the fluid
+        Vector<double> value(dim + 1);
+        interpolators[k]->point_value(fluid_solver.present_solution, value);
+        std::vector<Tensor<1, dim>> gradient(dim + 1, Tensor<1, dim>());
+        interpolators[k]->point_gradient(fluid_solver.present_solution,
+                                         gradient);
+        // Compute stress
+        SymmetricTensor<2, dim> sym_deformation;
+        for (unsigned int i = 0; i < dim; ++i)
+          {
+            for (unsigned int j = 0; j < dim; ++j)
+              {
+                sym_deformation[i][j] = (gradient[i][j] + gradient[j][i]) / 2;
+              }
+          }
+        // \f$ \sigma = -p\bold{I} + \mu\nabla^S v\f$
+        SymmetricTensor<2, dim> stress =
+          -value[dim] * Physics::Elasticity::StandardTensors<dim>::I +
+          2 * parameters.viscosity * sym_deformation;
+        // Assign the cell stress to local row vectors
+        for (unsigned int d1 = 0; d1 < dim; ++d1)
+          {
+            for (unsigned int d2 = 0; d2 < dim; ++d2)
+              {
+                solid_solver.fsi_stress_rows[d1][line + d2] = stress[d1][d2];
+              }
+          }
+        // End assigning local fluid stress values
+      } // End looping support points
     // Add up the local vectors
     for (unsigned int d = 0; d < dim; ++d)
       {
         Utilities::MPI::sum(solid_solver.fsi_stress_rows[d],
-                            solid_solver.mpi_communicator,
+                            fluid_solver.mpi_communicator,
                             solid_solver.fsi_stress_rows[d]);
       }
     move_solid_mesh(false);
@@ -638,17 +856,8 @@ namespace MPI
     // We need to increment the force until it does not penetrate
     bool still_penetrate = true;
     double force_increment = parameters.contact_force_multiplier;
-    // Cache the current solutions
-    Vector<double> cached_current_acceleration(
-      solid_solver.current_acceleration);
-    Vector<double> cached_current_velocity(solid_solver.current_velocity);
-    Vector<double> cached_current_displacement(
-      solid_solver.current_displacement);
-    Vector<double> cached_previous_acceleration(
-      solid_solver.previous_acceleration);
-    Vector<double> cached_previous_velocity(solid_solver.previous_velocity);
-    Vector<double> cached_previous_displacement(
-      solid_solver.previous_displacement);
+    // Every attempt starts from the current state
+    solid_solver.save_state();
     // By default, the force to mimic contact model is towards
     // the bottom.
     Tensor<1, dim> traction;
@@ -721,13 +930,7 @@ namespace MPI
         if (still_penetrate)
           {
             pcout << "Penetrating, apply contact model!" << std::endl;
-            solid_solver.current_acceleration = cached_current_acceleration;
-            solid_solver.current_velocity = cached_current_velocity;
-            solid_solver.current_displacement = cached_current_displacement;
-            solid_solver.previous_acceleration = cached_previous_acceleration;
-            solid_solver.previous_velocity = cached_previous_velocity;
-            solid_solver.previous_displacement = cached_previous_displacement;
-            solid_solver.time.decrement();
+            solid_solver.restore_state();
           }
       } // End adding extra stress
   }
@@ -798,8 +1001,18 @@ namespace MPI
     solution_transfer.prepare_for_coarsening_and_refinement(
       fluid_solver.present_solution);
 
+    // Carry the cell hints over to the refined mesh. The fluid solver only
+    // allows refinement of p4est meshes.
+    auto &fluid_triangulation =
+      dynamic_cast<parallel::distributed::Triangulation<dim> &>(
+        fluid_solver.triangulation);
+    const unsigned int hints_handle =
+      cell_hints.prepare_for_coarsening_and_refinement(fluid_triangulation);
+
     fluid_solver.triangulation.execute_coarsening_and_refinement();
 
+    cell_hints.unpack(fluid_triangulation, hints_handle);
+
     fluid_solver.setup_dofs();
     fluid_solver.make_constraints();
     fluid_solver.initialize_system();
@@ -812,6 +1025,366 @@ namespace MPI
     fluid_solver.nonzero_constraints.distribute(buffer);
     fluid_solver.present_solution = buffer;
     update_vertices_mask();
+    setup_cell_hints();
+  }
+
+  template <int dim>
+  void FSI<dim>::setup_solid_dof_permutation()
+  {
+    solid_dof_permutation.assign(solid_solver.dof_handler.n_dofs(),
+                                 numbers::invalid_dof_index);
+    std::vector<types::global_dof_index> dof_indices(
+      solid_solver.fe.dofs_per_cell);
+    types::global_dof_index n_numbered = 0;
+    for (auto s_cell : solid_solver.dof_handler.active_cell_iterators())
+      {
+        s_cell->get_dof_indices(dof_indices);
+        for (auto index : dof_indices)
+          {
+            if (solid_dof_permutation[index] == numbers::invalid_dof_index)
+              {
+                solid_dof_permutation[index] = n_numbered++;
+              }
+          }
+      }
+  }
+
+  template <int dim>
+  void FSI<dim>::send_fsi_stress()
+  {
+    if (n_solid_processes == 0)
+      {
+        return;
+      }
+    TimerOutput::Scope timer_section(timer, "Exchange coupling data");
+    const unsigned int n_dofs = solid_dof_permutation.size();
+    std::vector<double> buffer(dim * n_dofs);
+    if (is_fluid_process)
+      {
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              {
+                buffer[d * n_dofs + solid_dof_permutation[i]] =
+                  solid_solver.fsi_stress_rows[d][i];
+              }
+          }
+      }
+    // The stress rows are summed up over the fluid group in find_solid_bc,
+    // so the first fluid process holds all of them.
+    Timer wait_timer;
+    MPI_Bcast(buffer.data(),
+              static_cast<int>(buffer.size()),
+              MPI_DOUBLE,
+              0,
+              mpi_communicator);
+    coupling_wait_time += wait_timer.wall_time();
+    if (is_solid_process)
+      {
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              {
+                solid_solver.fsi_stress_rows[d][i] =
+                  buffer[d * n_dofs + solid_dof_permutation[i]];
+              }
+          }
+      }
+  }
+
+  template <int dim>
+  void FSI<dim>::send_solid_solution()
+  {
+    if (n_solid_processes == 0)
+      {
+        return;
+      }
+    TimerOutput::Scope timer_section(timer, "Exchange coupling data");
+    // Only the solutions used by the coupling are sent.
+    std::vector<PETScWrappers::MPI::Vector *> solutions =
+      coupled_solid_solutions();
+    const unsigned int n_dofs = solid_dof_permutation.size();
+    std::vector<double> buffer(solutions.size() * n_dofs);
+    if (is_solid_process)
+      {
+        for (unsigned int k = 0; k < solutions.size(); ++k)
+          {
+            Vector<double> localized_solution(*solutions[k]);
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              {
+                buffer[k * n_dofs + solid_dof_permutation[i]] =
+                  localized_solution[i];
+              }
+          }
+      }
+    // The first solid process sends the solutions to everyone.
+    const unsigned int solid_root =
+      Utilities::MPI::n_mpi_processes(mpi_communicator) - n_solid_processes;
+    Timer wait_timer;
+    MPI_Bcast(buffer.data(),
+              static_cast<int>(buffer.size()),
+              MPI_DOUBLE,
+              solid_root,
+              mpi_communicator);
+    coupling_wait_time += wait_timer.wall_time();
+    if (is_fluid_process)
+      {
+        Vector<double> localized_solution(n_dofs);
+        for (unsigned int k = 0; k < solutions.size(); ++k)
+          {
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              {
+                localized_solution[i] =
+                  buffer[k * n_dofs + solid_dof_permutation[i]];
+              }
+            *solutions[k] = localized_solution;
+          }
+      }
+  }
+
+  template <int dim>
+  void FSI<dim>::synchronize_time_step()
+  {
+    double delta_t = std::numeric_limits<double>::max();
+    if (is_fluid_process)
+      {
+        delta_t = std::min(delta_t, fluid_solver.time.get_delta_t());
+      }
+    if (is_solid_process)
+      {
+        delta_t = std::min(delta_t, solid_solver.time.get_delta_t());
+      }
+    delta_t = Utilities::MPI::min(delta_t, mpi_communicator);
+    time.set_delta_t(delta_t);
+    fluid_solver.time.set_delta_t(delta_t);
+    solid_solver.time.set_delta_t(delta_t);
+  }
+
+  template <int dim>
+  void FSI<dim>::print_utilization(const double wall_time)
+  {
+    const unsigned int n_processes =
+      Utilities::MPI::n_mpi_processes(mpi_communicator);
+    if (n_solid_processes == 0)
+      {
+        // Every process runs both solvers one after the other.
+        auto section_times =
+          timer.get_summary_data(TimerOutput::total_wall_time);
+        pcout << "Fluid and solid share " << n_processes
+              << " process(es), solid solver: "
+              << 100 * section_times["Run solid solver"] / wall_time
+              << "%, fluid solver: "
+              << 100 * section_times["Run fluid solver"] / wall_time
+              << "% of the wall time" << std::endl;
+        return;
+      }
+    // A process is idle while it waits for the data of the other group.
+    const double utilization = 1 - coupling_wait_time / wall_time;
+    const double fluid_utilization =
+      Utilities::MPI::sum(is_fluid_process ? utilization : 0.0,
+                          mpi_communicator) /
+      (n_processes - n_solid_processes);
+    const double solid_utilization =
+      Utilities::MPI::sum(is_solid_process ? utilization : 0.0,
+                          mpi_communicator) /
+      n_solid_processes;
+    pcout << "Fluid group: " << n_processes - n_solid_processes
+          << " process(es), utilization: " << 100 * fluid_utilization << "%"
+          << std::endl
+          << "Solid group: " << n_solid_processes
+          << " process(es), utilization: " << 100 * solid_utilization << "%"
+          << std::endl;
+  }
+
+  template <int dim>
+  std::vector<PETScWrappers::MPI::Vector *> FSI<dim>::coupled_solid_solutions()
+  {
+    return {&solid_solver.current_displacement,
+            &solid_solver.current_velocity,
+            &solid_solver.current_acceleration};
+  }
+
+  template <int dim>
+  void FSI<dim>::run_solid_step(bool first_step)
+  {
+    TimerOutput::Scope timer_section(timer, "Run solid solver");
+    const unsigned int n_substeps = parameters.solid_steps_per_fluid_step;
+    // The traction of the current fluid time step
+    std::vector<Vector<double>> fsi_stress_rows;
+    if (n_substeps > 1)
+      {
+        fsi_stress_rows = solid_solver.fsi_stress_rows;
+      }
+    for (unsigned int i = 1; i <= n_substeps; ++i)
+      {
+        if (n_substeps > 1 && !previous_fsi_stress_rows.empty())
+          {
+            const double ratio = static_cast<double>(i) / n_substeps;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                solid_solver.fsi_stress_rows[d] = fsi_stress_rows[d];
+                solid_solver.fsi_stress_rows[d].sadd(
+                  1 + ratio, -ratio, previous_fsi_stress_rows[d]);
+              }
+          }
+        if (penetration_criterion && !solid_solver.assembles_contact())
+          {
+            apply_contact_model(first_step && i == 1);
+          }
+        else
+          {
+            solid_solver.run_one_step(first_step && i == 1);
+          }
+      }
+    if (n_substeps > 1)
+      {
+        previous_fsi_stress_rows = fsi_stress_rows;
+      }
+  }
+
+  template <int dim>
+  void FSI<dim>::interpolate_solid_solution(const double fraction)
+  {
+    TimerOutput::Scope timer_section(timer, "Interpolate solid solution");
+    std::vector<PETScWrappers::MPI::Vector *> solutions =
+      coupled_solid_solutions();
+    for (unsigned int k = 0; k < solutions.size(); ++k)
+      {
+        Vector<double> solution(solid_solution_begin[k]);
+        solution.sadd(1 - fraction, fraction, solid_solution_end[k]);
+        *solutions[k] = solution;
+      }
+  }
+
+  template <int dim>
+  Vector<double> FSI<dim>::gather_fsi_stress() const
+  {
+    const unsigned int n_dofs = solid_solver.dof_handler.n_dofs();
+    Vector<double> stress(dim * n_dofs);
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          {
+            stress[d * n_dofs + i] = solid_solver.fsi_stress_rows[d][i];
+          }
+      }
+    return stress;
+  }
+
+  template <int dim>
+  void FSI<dim>::scatter_fsi_stress(const Vector<double> &stress)
+  {
+    const unsigned int n_dofs = solid_solver.dof_handler.n_dofs();
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          {
+            solid_solver.fsi_stress_rows[d][i] = stress[d * n_dofs + i];
+          }
+      }
+  }
+
+  template <int dim>
+  void FSI<dim>::cache_coupling_state()
+  {
+    if (parameters.max_coupling_iterations == 1)
+      {
+        return;
+      }
+    if (is_solid_process)
+      {
+        solid_solver.save_state();
+      }
+    if (is_fluid_process)
+      {
+        fluid_solver.save_state();
+        // The traction of the last time step is the initial guess
+        coupling_accelerator.new_time_step(gather_fsi_stress());
+      }
+  }
+
+  template <int dim>
+  bool FSI<dim>::iterate_coupling(const unsigned int iteration)
+  {
+    if (parameters.max_coupling_iterations == 1)
+      {
+        return false;
+      }
+    double residual = 0;
+    if (is_fluid_process)
+      {
+        find_solid_bc();
+        TimerOutput::Scope timer_section(timer, "Accelerate coupling");
+        residual = coupling_accelerator.update(gather_fsi_stress());
+      }
+    // Only the fluid processes know the residual
+    residual = Utilities::MPI::max(residual, mpi_communicator);
+    pcout << "Coupling iteration " << iteration + 1
+          << ", relative residual = " << residual << std::endl;
+    if (residual < parameters.coupling_tolerance)
+      {
+        return false;
+      }
+    if (iteration + 1 == parameters.max_coupling_iterations)
+      {
+        pcout << "Coupling iterations did not converge!" << std::endl;
+        return false;
+      }
+    // Back to the beginning of the time step, with the new traction
+    if (is_solid_process)
+      {
+        solid_solver.restore_state();
+      }
+    if (is_fluid_process)
+      {
+        fluid_solver.restore_state();
+        scatter_fsi_stress(coupling_accelerator.current());
+      }
+    return true;
+  }
+
+  template <int dim>
+  void FSI<dim>::print_multirate_savings(const unsigned int n_fluid_steps,
+                                         const unsigned int n_solid_steps)
+  {
+    auto section_times = timer.get_summary_data(TimerOutput::total_wall_time);
+    // The sections are timed in the group that runs them.
+    const double solid_time = Utilities::MPI::max(
+      is_solid_process ? section_times["Run solid solver"] : 0.0,
+      mpi_communicator);
+    const double solid_coupling_time = Utilities::MPI::max(
+      is_fluid_process ? section_times["Find solid BC"] : 0.0,
+      mpi_communicator);
+    const double fluid_time = Utilities::MPI::max(
+      is_fluid_process
+        ? section_times["Run fluid solver"] + section_times["Find fluid BC"] +
+            section_times["Update indicator"] + section_times["Move solid mesh"]
+        : 0.0,
+      mpi_communicator);
+    const unsigned int fluid_substeps = parameters.fluid_steps_per_solid_step;
+    const unsigned int solid_substeps = parameters.solid_steps_per_fluid_step;
+    double saved_time = 0;
+    if (fluid_substeps > 1 && n_solid_steps > 0)
+      {
+        // Without subcycling, the solid and its traction would have been
+        // computed in every fluid time step.
+        saved_time = (n_fluid_steps - n_solid_steps) *
+                     (solid_time + solid_coupling_time) / n_solid_steps;
+      }
+    else if (solid_substeps > 1 && n_fluid_steps > 0)
+      {
+        // Without subcycling, the fluid and the coupling would have been
+        // computed in every solid time step.
+        saved_time = (n_solid_steps - n_fluid_steps) *
+                     (fluid_time + solid_coupling_time) / n_fluid_steps;
+      }
+    else
+      {
+        return;
+      }
+    pcout << "Multirate coupling: " << n_fluid_steps << " fluid steps, "
+          << n_solid_steps << " solid steps, estimated time saved: "
+          << saved_time << " s" << std::endl;
   }
 
   template <int dim>
@@ -820,37 +1393,66 @@ namespace MPI
     pcout << "Running with PETSc on "
           << Utilities::MPI::n_mpi_processes(mpi_communicator)
           << " MPI rank(s)..." << std::endl;
+    if (n_solid_processes > 0)
+      {
+        pcout << n_solid_processes << " of them run the solid"
+              << (parameters.pipelined_coupling ? ", pipelined" : "")
+              << std::endl;
+      }
 
     solid_solver.triangulation.refine_global(parameters.global_refinements[1]);
-    // Try load from previous computation.
-    bool success_load =
-      solid_solver.load_checkpoint() && fluid_solver.load_checkpoint();
-    AssertThrow(
-      solid_solver.time.current() == fluid_solver.time.current(),
-      ExcMessage("Solid and fluid restart files have different time steps. "
-                 "Check and remove inconsistent restart files!"));
+    // Try load from previous computation. The solid copies on the fluid
+    // processes load the solid checkpoint as well, but their solution is
+    // replaced by the one of the solid group.
+    bool success_load = solid_solver.load_checkpoint();
+    if (is_fluid_process)
+      {
+        success_load = success_load && fluid_solver.load_checkpoint();
+        AssertThrow(
+          solid_solver.time.current() == fluid_solver.time.current(),
+          ExcMessage("Solid and fluid restart files have different time "
+                     "steps. Check and remove inconsistent restart files!"));
+      }
+    success_load = Utilities::MPI::min(static_cast<int>(success_load),
+                                       mpi_communicator);
     if (!success_load)
       {
         solid_solver.setup_dofs();
         solid_solver.initialize_system();
-        fluid_solver.triangulation.refine_global(
-          parameters.global_refinements[0]);
-        fluid_solver.setup_dofs();
-        fluid_solver.make_constraints();
-        fluid_solver.initialize_system();
+        if (is_fluid_process)
+          {
+            fluid_solver.triangulation.refine_global(
+              parameters.global_refinements[0]);
+            fluid_solver.setup_dofs();
+            fluid_solver.make_constraints();
+            fluid_solver.initialize_system();
+          }
       }
     else
       {
-        while (time.get_timestep() < solid_solver.time.get_timestep())
+        AssertThrow(parameters.fluid_steps_per_solid_step == 1 &&
+                      parameters.solid_steps_per_fluid_step == 1,
+                    ExcMessage("Multirate FSI can not be restarted!"));
+        // The step sizes may have been adapted before the checkpoint
+        time.set_state(solid_solver.time.get_state());
+      }
+    setup_solid_dof_permutation();
+    if (success_load)
+      {
+        send_solid_solution();
+      }
+
+    if (is_fluid_process)
+      {
+        collect_solid_boundaries();
+        if (success_load)
           {
-            time.increment();
+            load_cell_hints();
           }
+        setup_cell_hints();
+        update_vertices_mask();
       }
 
-    collect_solid_boundaries();
-    setup_cell_hints();
-    update_vertices_mask();
-
     pcout << "Number of fluid active cells and dofs: ["
           << fluid_solver.triangulation.n_active_cells() << ", "
           << fluid_solver.dof_handler.n_dofs() << "]" << std::endl
@@ -858,60 +1460,144 @@ namespace MPI
           << solid_solver.triangulation.n_active_cells() << ", "
           << solid_solver.dof_handler.n_dofs() << "]" << std::endl;
     bool first_step = !success_load;
-    if (parameters.refinement_interval < parameters.end_time)
+    if (is_fluid_process &&
+        parameters.refinement_interval < parameters.end_time)
       {
         refine_mesh(parameters.global_refinements[0],
                     parameters.global_refinements[0] + 3);
         refine_mesh(parameters.global_refinements[0],
                     parameters.global_refinements[0] + 3);
-        setup_cell_hints();
       }
+    const unsigned int fluid_substeps = parameters.fluid_steps_per_solid_step;
+    const unsigned int solid_substeps = parameters.solid_steps_per_fluid_step;
+    if (solid_substeps > 1)
+      {
+        solid_solver.time.set_delta_t(time.get_delta_t() / solid_substeps);
+      }
+    unsigned int n_fluid_steps = 0, n_solid_steps = 0;
+    Timer run_timer;
+    coupling_wait_time = 0;
     while (time.end() - time.current() > 1e-12)
       {
-        find_solid_bc();
-        if (success_load)
+        // When the fluid subcycles, the solid and its traction are only
+        // computed at the synchronization steps.
+        const unsigned int substep = time.get_timestep() % fluid_substeps;
+        if (substep == 0)
+          {
+            if (fluid_substeps > 1)
+              {
+                // The last solid step ends at the end time
+                solid_solver.time.set_delta_t(
+                  std::min(fluid_substeps * time.get_delta_t(),
+                           time.end() - time.current()));
+              }
+            if (is_fluid_process)
+              {
+                if (fluid_substeps > 1)
+                  {
+                    solid_solution_begin.clear();
+                    for (auto solution : coupled_solid_solutions())
+                      {
+                        solid_solution_begin.emplace_back(*solution);
+                      }
+                  }
+                find_solid_bc();
+              }
+          }
+        cache_coupling_state();
+        // With coupling iterations, the solid and the fluid steps are
+        // repeated until the fluid traction on the solid converges.
+        for (unsigned int iteration = 0;; ++iteration)
           {
-            solid_solver.assemble_system(true);
+            if (substep == 0)
+              {
+                send_fsi_stress();
+                if (is_solid_process)
+                  {
+                    if (success_load)
+                      {
+                        solid_solver.assemble_system(true);
+                      }
+                    run_solid_step(first_step);
+                  }
+                n_solid_steps += solid_substeps;
+                // Unless pipelined, the fluid waits for the new solid
+                // solution. Otherwise the fluid step runs with the solid
+                // solution of the previous time step, at the same time as
+                // the solid step.
+                if (!parameters.pipelined_coupling)
+                  {
+                    send_solid_solution();
+                  }
+                if (is_fluid_process && fluid_substeps > 1)
+                  {
+                    solid_solution_end.clear();
+                    for (auto solution : coupled_solid_solutions())
+                      {
+                        solid_solution_end.emplace_back(*solution);
+                      }
+                  }
+              }
+            if (is_fluid_process)
+              {
+                if (fluid_substeps > 1)
+                  {
+                    interpolate_solid_solution(
+                      std::min(1.0,
+                               (substep + 1) * time.get_delta_t() /
+                                 solid_solver.time.get_delta_t()));
+                  }
+                update_solid_box();
+                update_indicator();
+                fluid_solver.make_constraints();
+                if (!first_step)
+                  {
+                    fluid_solver.nonzero_constraints.clear();
+                    fluid_solver.nonzero_constraints.copy_from(
+                      fluid_solver.zero_constraints);
+                  }
+                find_fluid_bc();
+                {
+                  TimerOutput::Scope timer_section(timer, "Run fluid solver");
+                  fluid_solver.run_one_step(true);
+                }
+              }
+            if (!iterate_coupling(iteration))
+              {
+                break;
+              }
           }
-        {
-          TimerOutput::Scope timer_section(timer, "Run solid solver");
-          if (penetration_criterion)
-            {
-              apply_contact_model(first_step);
-            }
-          else
-            {
-              solid_solver.run_one_step(first_step);
-            }
-        }
-        update_solid_box();
-        update_indicator();
-        fluid_solver.make_constraints();
-        if (!first_step)
+        ++n_fluid_steps;
+        if (parameters.pipelined_coupling)
           {
-            fluid_solver.nonzero_constraints.clear();
-            fluid_solver.nonzero_constraints.copy_from(
-              fluid_solver.zero_constraints);
+            send_solid_solution();
           }
-        find_fluid_bc();
-        {
-          TimerOutput::Scope timer_section(timer, "Run fluid solver");
-          fluid_solver.run_one_step(true);
-        }
         first_step = false;
         time.increment();
-        if (time.time_to_refine())
+        if (parameters.adaptive_time_stepping)
+          {
+            synchronize_time_step();
+          }
+        if (is_fluid_process && time.time_to_refine())
           {
             refine_mesh(parameters.global_refinements[0],
                         parameters.global_refinements[0] + 3);
-            setup_cell_hints();
           }
         if (time.time_to_save())
           {
-            solid_solver.save_checkpoint(time.get_timestep());
-            fluid_solver.save_checkpoint(time.get_timestep());
+            if (is_solid_process)
+              {
+                solid_solver.save_checkpoint(time.get_timestep());
+              }
+            if (is_fluid_process)
+              {
+                fluid_solver.save_checkpoint(time.get_timestep());
+                save_cell_hints(time.get_timestep());
+              }
           }
       }
+    print_utilization(run_timer.wall_time());
+    print_multirate_savings(n_fluid_steps, n_solid_steps);
   }
 
   template <int dim>
@@ -922,6 +1608,8 @@ namespace MPI
     penetration_criterion.reset(
       new std::function<double(const Point<dim> &)>(criterion));
     penetration_direction = direction;
+    // Solvers that enforce contact in their Newton loop take it from here
+    solid_solver.set_penetration_criterion(criterion, direction);
   }
 
   template class FSI<2>;
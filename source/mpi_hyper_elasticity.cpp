@@ -73,9 +73,12 @@ namespace Solid
           this->output_results(time.get_timestep());
         }
 
-      PETScWrappers::MPI::Vector predicted_displacement(current_displacement);
-      PETScWrappers::MPI::Vector newton_update(current_displacement);
-      PETScWrappers::MPI::Vector tmp(current_displacement);
+      for (auto vector :
+           {&predicted_displacement, &newton_update, &scratch_vector})
+        {
+          Utils::NewmarkUpdate::reinit(
+            *vector, locally_owned_dofs, mpi_communicator);
+        }
 
       time.increment();
 
@@ -96,9 +99,12 @@ namespace Solid
 
       // The prediction of the current displacement,
       // which is what we want to solve.
-      predicted_displacement = previous_displacement;
-      predicted_displacement.add(
-        dt, previous_velocity, (0.5 - beta) * dt * dt, previous_acceleration);
+      const Utils::NewmarkUpdate newmark(beta, gamma);
+      newmark.predict(predicted_displacement,
+                      dt,
+                      previous_displacement,
+                      previous_velocity,
+                      previous_acceleration);
 
       pcout << std::string(100, '_') << std::endl;
 
@@ -109,20 +115,19 @@ namespace Solid
                       ExcMessage("Too many Newton iterations!"));
 
           // Compute the displacement, velocity and acceleration
-          current_acceleration = current_displacement;
-          current_acceleration -= predicted_displacement;
-          current_acceleration /= (beta * dt * dt);
-          current_velocity = previous_velocity;
-          current_velocity.add(dt * (1 - gamma),
-                               previous_acceleration,
-                               dt * gamma,
-                               current_acceleration);
+          newmark.correct(current_acceleration,
+                          current_velocity,
+                          dt,
+                          current_displacement,
+                          predicted_displacement,
+                          previous_velocity,
+                          previous_acceleration);
 
           // Assemble the system, and modify the RHS to account for
           // the time-discretization.
           assemble_system(false);
-          mass_matrix.vmult(tmp, current_acceleration);
-          system_rhs -= tmp;
+          mass_matrix.vmult(scratch_vector, current_acceleration);
+          system_rhs -= scratch_vector;
 
           // Solve linear system
           const std::pair<unsigned int, double> lin_solver_output =
@@ -162,18 +167,20 @@ namespace Solid
         }
 
       // Once converged, update current acceleration and velocity again.
-      current_acceleration = current_displacement;
-      current_acceleration -= predicted_displacement;
-      current_acceleration /= (beta * dt * dt);
-      current_velocity = previous_velocity;
-      current_velocity.add(dt * (1 - gamma),
-                           previous_acceleration,
-                           dt * gamma,
-                           current_acceleration);
+      newmark.correct(current_acceleration,
+                      current_velocity,
+                      dt,
+                      current_displacement,
+                      predicted_displacement,
+                      previous_velocity,
+                      previous_acceleration);
       // Update the previous values
-      previous_acceleration = current_acceleration;
-      previous_velocity = current_velocity;
-      previous_displacement = current_displacement;
+      Utils::NewmarkUpdate::store(current_acceleration,
+                                  current_velocity,
+                                  current_displacement,
+                                  previous_acceleration,
+                                  previous_velocity,
+                                  previous_displacement);
 
       pcout << std::string(100, '_') << std::endl
             << "Relative errors:" << std::endl
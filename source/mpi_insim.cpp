@@ -128,7 +128,7 @@ namespace Fluid
     }
 
     template <int dim>
-    InsIM<dim>::InsIM(parallel::distributed::Triangulation<dim> &tria,
+    InsIM<dim>::InsIM(parallel::DistributedTriangulationBase<dim> &tria,
                       const Parameters::AllParameters &parameters)
       : FluidSolver<dim>(tria, parameters)
     {
@@ -366,26 +366,36 @@ namespace Fluid
     InsIM<dim>::solve(const bool use_nonzero_constraints)
     {
       TimerOutput::Scope timer_section(timer, "Solve linear system");
-      preconditioner.reset(new BlockSchurPreconditioner(timer2,
-                                                        parameters.grad_div,
-                                                        parameters.viscosity,
-                                                        parameters.fluid_rho,
-                                                        time.get_delta_t(),
-                                                        owned_partitioning,
-                                                        system_matrix,
-                                                        mass_matrix,
-                                                        mass_schur));
-
       SolverControl solver_control(
         system_matrix.m(), std::max(1e-12, 1e-4 * system_rhs.l2_norm()), true);
-      // Because PETScWrappers::SolverGMRES requires preconditioner derived
-      // from PETScWrappers::PreconditionBase, we use dealii SolverFGMRES.
-      GrowingVectorMemory<PETScWrappers::MPI::BlockVector> vector_memory;
-      SolverFGMRES<PETScWrappers::MPI::BlockVector> gmres(solver_control,
-                                                          vector_memory);
 
       // The solution vector must be non-ghosted
-      gmres.solve(system_matrix, newton_update, system_rhs, *preconditioner);
+      if (parameters.fluid_linear_solver == "Field split")
+        {
+          field_split_solver.solve(
+            system_matrix, newton_update, system_rhs, solver_control);
+        }
+      else
+        {
+          preconditioner.reset(
+            new BlockSchurPreconditioner(timer2,
+                                         parameters.grad_div,
+                                         parameters.viscosity,
+                                         parameters.fluid_rho,
+                                         time.get_delta_t(),
+                                         owned_partitioning,
+                                         system_matrix,
+                                         mass_matrix,
+                                         mass_schur));
+          // Because PETScWrappers::SolverGMRES requires preconditioner
+          // derived from PETScWrappers::PreconditionBase, we use dealii
+          // SolverFGMRES.
+          GrowingVectorMemory<PETScWrappers::MPI::BlockVector> vector_memory;
+          SolverFGMRES<PETScWrappers::MPI::BlockVector> gmres(solver_control,
+                                                              vector_memory);
+          gmres.solve(
+            system_matrix, newton_update, system_rhs, *preconditioner);
+        }
 
       const AffineConstraints<double> &constraints_used =
         use_nonzero_constraints ? nonzero_constraints : zero_constraints;
@@ -125,7 +125,7 @@ namespace Fluid
     }
 
     template <int dim>
-    InsIMEX<dim>::InsIMEX(parallel::distributed::Triangulation<dim> &tria,
+    InsIMEX<dim>::InsIMEX(parallel::DistributedTriangulationBase<dim> &tria,
                           const Parameters::AllParameters &parameters)
       : FluidSolver<dim>(tria, parameters)
     {
@@ -359,31 +359,46 @@ namespace Fluid
     InsIMEX<dim>::solve(bool use_nonzero_constraints, bool assemble_system)
     {
       TimerOutput::Scope timer_section(timer, "Solve linear system");
-      if (assemble_system)
-        {
-          preconditioner.reset(
-            new BlockSchurPreconditioner(timer2,
-                                         parameters.grad_div,
-                                         parameters.viscosity,
-                                         parameters.fluid_rho,
-                                         time.get_delta_t(),
-                                         owned_partitioning,
-                                         system_matrix,
-                                         mass_matrix,
-                                         mass_schur));
-        }
-
       SolverControl solver_control(
         system_matrix.m(), std::min(1e-9, 1e-8 * system_rhs.l2_norm()), true);
-      // Because PETScWrappers::SolverGMRES requires preconditioner derived
-      // from PETScWrappers::PreconditionBase, we use dealii SolverFGMRES.
-      GrowingVectorMemory<PETScWrappers::MPI::BlockVector> vector_memory;
-      SolverFGMRES<PETScWrappers::MPI::BlockVector> gmres(solver_control,
-                                                          vector_memory);
 
       // The solution vector must be non-ghosted
-      gmres.solve(
-        system_matrix, solution_time_increment, system_rhs, *preconditioner);
+      if (parameters.fluid_linear_solver == "Field split")
+        {
+          // The field split preconditioner is reused as long as the system
+          // matrix is not reassembled
+          field_split_solver.solve(system_matrix,
+                                   solution_time_increment,
+                                   system_rhs,
+                                   solver_control,
+                                   assemble_system);
+        }
+      else
+        {
+          if (assemble_system)
+            {
+              preconditioner.reset(
+                new BlockSchurPreconditioner(timer2,
+                                             parameters.grad_div,
+                                             parameters.viscosity,
+                                             parameters.fluid_rho,
+                                             time.get_delta_t(),
+                                             owned_partitioning,
+                                             system_matrix,
+                                             mass_matrix,
+                                             mass_schur));
+            }
+          // Because PETScWrappers::SolverGMRES requires preconditioner
+          // derived from PETScWrappers::PreconditionBase, we use dealii
+          // SolverFGMRES.
+          GrowingVectorMemory<PETScWrappers::MPI::BlockVector> vector_memory;
+          SolverFGMRES<PETScWrappers::MPI::BlockVector> gmres(solver_control,
+                                                              vector_memory);
+          gmres.solve(system_matrix,
+                      solution_time_increment,
+                      system_rhs,
+                      *preconditioner);
+        }
 
       const AffineConstraints<double> &constraints_used =
         use_nonzero_constraints ? nonzero_constraints : zero_constraints;
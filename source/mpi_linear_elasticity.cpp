@@ -216,11 +216,14 @@ namespace Solid
         }
 
       const double dt = time.get_delta_t();
+      const Utils::NewmarkUpdate newmark(beta, gamma);
 
-      PETScWrappers::MPI::Vector tmp1(locally_owned_dofs, mpi_communicator);
-      PETScWrappers::MPI::Vector tmp2(locally_owned_dofs, mpi_communicator);
-
-      PETScWrappers::MPI::Vector tmp3(locally_owned_dofs, mpi_communicator);
+      for (auto vector :
+           {&effective_rhs, &predicted_displacement, &stiffness_force})
+        {
+          Utils::NewmarkUpdate::reinit(
+            *vector, locally_owned_dofs, mpi_communicator);
+        }
 
       time.increment();
       pcout << std::string(91, '*') << std::endl
@@ -228,36 +231,27 @@ namespace Solid
             << ", at t = " << std::scientific << time.current() << std::endl;
 
       // Modify the RHS
-      tmp1 = system_rhs;
-      tmp2 = previous_displacement;
-      tmp2.add(
-        dt, previous_velocity, (0.5 - beta) * dt * dt, previous_acceleration);
-      stiffness_matrix.vmult(tmp3, tmp2);
-      tmp1 -= tmp3;
-
-      auto state = this->solve(system_matrix, current_acceleration, tmp1);
-
-      // update the current velocity
-      // \f$ v_{n+1} = v_n + (1-\gamma)\Delta{t}a_n + \gamma\Delta{t}a_{n+1}
-      // \f$
-      current_velocity = previous_velocity;
-      current_velocity.add(dt * (1 - gamma),
-                           previous_acceleration,
-                           dt * gamma,
-                           current_acceleration);
-
-      // update the current displacement
-      current_displacement = previous_displacement;
-      current_displacement.add(dt, previous_velocity);
-      current_displacement.add(dt * dt * (0.5 - beta),
-                               previous_acceleration,
-                               dt * dt * beta,
-                               current_acceleration);
-
-      // update the previous values
-      previous_acceleration = current_acceleration;
-      previous_velocity = current_velocity;
-      previous_displacement = current_displacement;
+      newmark.predict(predicted_displacement,
+                      dt,
+                      previous_displacement,
+                      previous_velocity,
+                      previous_acceleration);
+      stiffness_matrix.vmult(stiffness_force, predicted_displacement);
+      Utils::NewmarkUpdate::combine(
+        effective_rhs, system_rhs, -1, stiffness_force);
+
+      auto state =
+        this->solve(system_matrix, current_acceleration, effective_rhs);
+
+      // Update the current velocity and displacement, and store them as the
+      // previous values in the same sweep.
+      newmark.advance(current_acceleration,
+                      current_velocity,
+                      current_displacement,
+                      dt,
+                      previous_acceleration,
+                      previous_velocity,
+                      previous_displacement);
 
       pcout << std::scientific << std::left << " CG iteration: " << std::setw(3)
             << state.first << " CG residual: " << state.second << std::endl;
@@ -270,9 +264,6 @@ namespace Solid
       if (time.time_to_refine())
         {
           this->refine_mesh(1, 4);
-          tmp1.reinit(locally_owned_dofs, mpi_communicator);
-          tmp2.reinit(locally_owned_dofs, mpi_communicator);
-          tmp3.reinit(locally_owned_dofs, mpi_communicator);
           assemble_system(false);
         }
     }
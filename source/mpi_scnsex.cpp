@@ -5,13 +5,34 @@ namespace Fluid
   namespace MPI
   {
     template <int dim>
-    SCnsEX<dim>::SCnsEX(parallel::distributed::Triangulation<dim> &tria,
+    SCnsEX<dim>::SCnsEX(parallel::DistributedTriangulationBase<dim> &tria,
                         const Parameters::AllParameters &parameters)
-      : FluidSolver<dim>(tria, parameters)
+      : FluidSolver<dim>(tria, parameters),
+        assembled_delta_t(0),
+        n_time_levels(parameters.local_time_step_levels),
+        finest_time_level(0)
     {
       AssertThrow(parameters.fluid_velocity_degree ==
                     parameters.fluid_pressure_degree,
                   ExcMessage("Velocity degree must the same as pressure!"));
+      // Only p::d triangulations are repartitioned with weights
+      if (n_time_levels > 1 &&
+          dynamic_cast<parallel::distributed::Triangulation<dim> *>(&tria))
+        {
+          weight_connection = tria.signals.cell_weight.connect(
+            [this](const typename parallel::distributed::Triangulation<
+                     dim>::cell_iterator &cell,
+                   const typename parallel::distributed::Triangulation<
+                     dim>::CellStatus status) {
+              return this->cell_weight(cell, status);
+            });
+        }
+    }
+
+    template <int dim>
+    SCnsEX<dim>::~SCnsEX()
+    {
+      weight_connection.disconnect();
     }
 
     template <int dim>
@@ -47,6 +68,18 @@ namespace Fluid
       fsi_acceleration.reinit(
         owned_partitioning, relevant_partitioning, mpi_communicator);
 
+      if (n_time_levels > 1)
+        {
+          level_start_solutions.resize(n_time_levels);
+          for (auto &v : level_start_solutions)
+            {
+              v.reinit(
+                owned_partitioning, relevant_partitioning, mpi_communicator);
+            }
+          level_old_solution.reinit(
+            owned_partitioning, relevant_partitioning, mpi_communicator);
+        }
+
       // Cell property
       setup_cell_property();
 
@@ -55,17 +88,19 @@ namespace Fluid
           apply_initial_condition();
         }
 
-      // Setup local matrices
+      // Setup local matrices, the pressure one is only kept for the level
+      // steps
       for (auto cell = triangulation.begin_active();
            cell != triangulation.end();
            ++cell)
         {
           if (cell->is_locally_owned())
             {
-              local_matrices.initialize(cell, 1);
+              local_matrices.initialize(cell, 2);
               const std::vector<std::shared_ptr<FullMatrix<double>>> m =
                 local_matrices.get_data(cell);
               *(m[0]) = 0;
+              *(m[1]) = 0;
             }
         }
 
@@ -97,7 +132,8 @@ namespace Fluid
 
     template <int dim>
     void SCnsEX<dim>::assemble(const bool assemble_system,
-                               const bool assemble_velocity)
+                               const bool assemble_velocity,
+                               const unsigned int time_level)
     {
       TimerOutput::Scope timer_section(timer, "Assemble system");
 
@@ -105,20 +141,25 @@ namespace Fluid
       for (unsigned int i = 0; i < dim; ++i)
         gravity[i] = parameters.gravity[i];
 
-      if (assemble_system)
+      // A level step only assembles the cells of the level, with the level
+      // constraints, and starts from the old solution of the level.
+      const bool level_step = time_level != numbers::invalid_unsigned_int;
+      const double delta_t =
+        level_step ? level_time_step(time_level) : time.get_delta_t();
+      const AffineConstraints<double> &constraints =
+        level_step ? level_constraints : nonzero_constraints;
+      const PETScWrappers::MPI::BlockVector &old_solution =
+        level_step ? level_old_solution : present_solution;
+      // The inhomogeneous constraints need the local matrices for the rhs
+      const bool reuse_local_matrix =
+        !assemble_system &&
+        (level_step ||
+         (assemble_velocity && !hard_coded_boundary_values.empty()));
+      const unsigned int block = assemble_velocity ? 0 : 1;
+
+      if (assemble_system || reuse_local_matrix)
         {
-          if (assemble_velocity)
-            {
-              system_matrix.block(0, 0) = 0;
-            }
-          else
-            {
-              system_matrix.block(1, 1) = 0;
-            }
-        }
-      else if (assemble_velocity && !hard_coded_boundary_values.empty())
-        {
-          system_matrix.block(0, 0) = 0;
+          system_matrix.block(block, block) = 0;
         }
 
       system_rhs = 0;
@@ -188,7 +229,8 @@ namespace Fluid
       for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
            ++cell)
         {
-          if (cell->is_locally_owned())
+          if (cell->is_locally_owned() &&
+              (!level_step || level_cells[cell->active_cell_index()]))
             {
               auto m = local_matrices.get_data(cell);
               fe_values.reinit(cell);
@@ -208,12 +250,12 @@ namespace Fluid
               if (assemble_velocity)
                 {
                   fe_values[velocities].get_function_values(
-                    present_solution, present_velocity_values);
+                    old_solution, present_velocity_values);
                 }
               else // assemble pressure
                 {
                   fe_values[pressure].get_function_values(
-                    present_solution, present_pressure_values);
+                    old_solution, present_pressure_values);
 
                   fe_values[pressure].get_function_values(
                     evaluation_point, current_pressure_values);
@@ -257,8 +299,7 @@ namespace Fluid
                                   local_matrix(i, j) +=
                                     (viscosity * scalar_product(grad_phi_u[j],
                                                                 grad_phi_u[i]) +
-                                     rho * phi_u[i] * phi_u[j] /
-                                       time.get_delta_t()) *
+                                     rho * phi_u[i] * phi_u[j] / delta_t) *
                                     fe_values.JxW(q);
                                   // PML attenuation
                                   local_matrix(i, j) += rho * sigma_pml[q] *
@@ -268,8 +309,8 @@ namespace Fluid
                               else
                                 {
                                   local_matrix(i, j) += phi_p[i] * phi_p[j] /
-                                                        time.get_delta_t() /
-                                                        atm * fe_values.JxW(q);
+                                                        delta_t / atm *
+                                                        fe_values.JxW(q);
                                   // PML attenuation
                                   local_matrix(i, j) += sigma_pml[q] *
                                                         phi_p[j] * phi_p[i] /
@@ -282,7 +323,7 @@ namespace Fluid
                         {
                           local_rhs(i) +=
                             (rho * (present_velocity_values[q] * phi_u[i] /
-                                      time.get_delta_t() -
+                                      delta_t -
                                     current_velocity_gradients[q] *
                                       current_velocity_values[q] * phi_u[i]) -
                              phi_u[i] * current_pressure_gradients[q] +
@@ -295,7 +336,7 @@ namespace Fluid
                             (-cp_to_cv * (atm + current_pressure_values[q]) *
                                current_velocity_divergence * phi_p[i] +
                              present_pressure_values[q] * phi_p[i] /
-                               time.get_delta_t() -
+                               delta_t -
                              phi_p[i] * current_pressure_gradients[q] *
                                current_velocity_values[q]) /
                             atm * fe_values.JxW(q);
@@ -342,52 +383,65 @@ namespace Fluid
 
               if (assemble_system)
                 {
-                  nonzero_constraints.distribute_local_to_global(
-                    local_matrix,
-                    local_rhs,
-                    local_dof_indices,
-                    system_matrix,
-                    system_rhs,
-                    false);
-                  if (assemble_velocity)
+                  constraints.distribute_local_to_global(local_matrix,
+                                                         local_rhs,
+                                                         local_dof_indices,
+                                                         system_matrix,
+                                                         system_rhs,
+                                                         false);
+                  if (assemble_velocity || level_step)
                     {
-                      *(m[0]) = local_matrix;
+                      *(m[block]) = local_matrix;
                     }
                 }
               else
                 {
-                  // *(m[0]) is the local matrix stored when the system
+                  // *(m[block]) is the local matrix stored when the system
                   // matrix is assembled
-                  if (assemble_velocity && !hard_coded_boundary_values.empty())
+                  if (reuse_local_matrix)
                     {
-                      nonzero_constraints.distribute_local_to_global(
-                        *(m[0]),
-                        local_rhs,
-                        local_dof_indices,
-                        system_matrix,
-                        system_rhs,
-                        false);
+                      constraints.distribute_local_to_global(*(m[block]),
+                                                             local_rhs,
+                                                             local_dof_indices,
+                                                             system_matrix,
+                                                             system_rhs,
+                                                             false);
                     }
                   else
                     {
-                      nonzero_constraints.distribute_local_to_global(
+                      constraints.distribute_local_to_global(
                         local_rhs, local_dof_indices, system_rhs);
                     }
                 }
             }
         }
 
-      if (assemble_system ||
-          (assemble_velocity && !hard_coded_boundary_values.empty()))
+      if (assemble_system || reuse_local_matrix)
         {
           system_matrix.compress(VectorOperation::add);
+          // The dofs away from the level keep their values
+          if (level_step)
+            {
+              const types::global_dof_index offset =
+                assemble_velocity ? 0 : dofs_per_block[0];
+              for (const auto dof : idle_dofs)
+                {
+                  if (dof >= offset && dof - offset < dofs_per_block[block])
+                    {
+                      system_matrix.block(block, block).set(
+                        dof - offset, dof - offset, 1.0);
+                    }
+                }
+              system_matrix.compress(VectorOperation::insert);
+            }
         }
       system_rhs.compress(VectorOperation::add);
     }
 
     template <int dim>
     std::pair<unsigned int, double>
-    SCnsEX<dim>::solve(const bool solve_for_velocity)
+    SCnsEX<dim>::solve(const bool solve_for_velocity,
+                       const unsigned int time_level)
     {
       // This section includes the work done in the CG solver
       TimerOutput::Scope timer_section(timer, "Solve linear system");
@@ -398,29 +452,35 @@ namespace Fluid
       GrowingVectorMemory<PETScWrappers::MPI::Vector> vector_memory;
       PETScWrappers::SolverCG cg(solver_control, mpi_communicator);
 
-      nonzero_constraints.set_zero(intermediate_solution);
+      const bool level_step = time_level != numbers::invalid_unsigned_int;
+      const AffineConstraints<double> &constraints =
+        level_step ? level_constraints : nonzero_constraints;
+      constraints.set_zero(intermediate_solution);
 
       // The solution vector must be non-ghosted
-      if (solve_for_velocity)
+      const unsigned int block = solve_for_velocity ? 0 : 1;
+      if (level_step)
         {
-          PETScWrappers::PreconditionBoomerAMG preconditioner(
-            system_matrix.block(0, 0));
-          cg.solve(system_matrix.block(0, 0),
-                   intermediate_solution.block(0),
-                   system_rhs.block(0),
+          // A level system is mostly identity rows and mass dominated on the
+          // rest, setting up AMG for it does not pay off.
+          PETScWrappers::PreconditionJacobi preconditioner(
+            system_matrix.block(block, block));
+          cg.solve(system_matrix.block(block, block),
+                   intermediate_solution.block(block),
+                   system_rhs.block(block),
                    preconditioner);
         }
       else
         {
           PETScWrappers::PreconditionBoomerAMG preconditioner(
-            system_matrix.block(1, 1));
-          cg.solve(system_matrix.block(1, 1),
-                   intermediate_solution.block(1),
-                   system_rhs.block(1),
+            system_matrix.block(block, block));
+          cg.solve(system_matrix.block(block, block),
+                   intermediate_solution.block(block),
+                   system_rhs.block(block),
                    preconditioner);
         }
 
-      nonzero_constraints.distribute(intermediate_solution);
+      constraints.distribute(intermediate_solution);
 
       return {solver_control.last_step(), solver_control.last_value()};
     }
@@ -443,12 +503,65 @@ namespace Fluid
             << "Time step = " << time.get_timestep()
             << ", at t = " << std::scientific << time.current() << std::endl;
 
+      unsigned int outer_iteration = 0;
+      if (n_time_levels > 1)
+        {
+          outer_iteration = advance_time_levels();
+        }
+      else
+        {
+          // The matrices are reassembled if the time step size has changed
+          assemble_system =
+            assemble_system || time.get_delta_t() != assembled_delta_t;
+          assembled_delta_t = time.get_delta_t();
+
+          outer_iteration = iterate(assemble_system);
+          // Newton iteration converges, update time and solution
+          present_solution = evaluation_point;
+        }
+      // Update stress for output
+      update_stress();
+      if (time_step_controller.enabled())
+        {
+          // The finest level takes the CFL limited steps, which may cut the
+          // step by more than the reduction factor
+          time_step_controller.update(
+            time,
+            time_step_controller.iteration_factor(outer_iteration),
+            time_step_controller.cfl_factor(
+              time.get_delta_t(),
+              stable_time_step() * (1u << (n_time_levels - 1))));
+          pcout << "Next time step size = " << time.get_delta_t() << std::endl;
+        }
+      // Output
+      if (time.time_to_output())
+        {
+          output_results(time.get_timestep());
+        }
+      // Save checkpoint
+      if (parameters.simulation_type == "Fluid" && time.time_to_save())
+        {
+          save_checkpoint(time.get_timestep());
+        }
+      if (parameters.simulation_type == "Fluid" && time.time_to_refine())
+        {
+          refine_mesh(parameters.global_refinements[0],
+                      parameters.global_refinements[0] + 3);
+        }
+    }
+
+    template <int dim>
+    unsigned int SCnsEX<dim>::iterate(const bool assemble_system,
+                                      const unsigned int time_level)
+    {
       // Resetting
       double current_residual = 1.0;
       double initial_residual = 1.0;
       double relative_residual = 1.0;
       unsigned int outer_iteration = 0;
-      evaluation_point = present_solution;
+      evaluation_point = time_level == numbers::invalid_unsigned_int
+                           ? present_solution
+                           : level_old_solution;
 
       PETScWrappers::MPI::BlockVector increment(owned_partitioning,
                                                 mpi_communicator);
@@ -470,12 +583,12 @@ namespace Fluid
           // should be applied at the first iteration of every time step;
           // if they are time-independent, nonzero_constraints should be
           // applied only at the first iteration of the first time step.
-          assemble(assemble_system && outer_iteration == 0, true);
-          auto state_velocity = solve(true);
+          assemble(assemble_system && outer_iteration == 0, true, time_level);
+          auto state_velocity = solve(true, time_level);
           evaluation_point.block(0) = intermediate_solution.block(0);
 
-          assemble(assemble_system && outer_iteration == 0, false);
-          auto state_pressure = solve(false);
+          assemble(assemble_system && outer_iteration == 0, false, time_level);
+          auto state_pressure = solve(false, time_level);
           evaluation_point.block(1) = intermediate_solution.block(1);
 
           increment = evaluation_point;
@@ -498,25 +611,309 @@ namespace Fluid
           outer_iteration++;
           last_solution = intermediate_solution;
         }
-      // Newton iteration converges, update time and solution
-      present_solution = evaluation_point;
-      // Update stress for output
-      update_stress();
-      // Output
-      if (time.time_to_output())
+      return outer_iteration;
+    }
+
+    template <int dim>
+    double SCnsEX<dim>::stable_time_step() const
+    {
+      FEValues<dim> fe_values(fe, volume_quad_formula, update_values);
+      double min_time_step = std::numeric_limits<double>::max();
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
         {
-          output_results(time.get_timestep());
+          if (!cell->is_locally_owned())
+            {
+              continue;
+            }
+          min_time_step =
+            std::min(min_time_step, cell_stable_time_step(cell, fe_values));
         }
-      // Save checkpoint
-      if (parameters.simulation_type == "Fluid" && time.time_to_save())
+      return Utilities::MPI::min(min_time_step, mpi_communicator);
+    }
+
+    template <int dim>
+    double SCnsEX<dim>::cell_stable_time_step(
+      const typename DoFHandler<dim>::active_cell_iterator &cell,
+      FEValues<dim> &fe_values) const
+    {
+      const FEValuesExtractors::Vector velocities(0);
+      std::vector<Tensor<1, dim>> velocity_values(volume_quad_formula.size());
+      fe_values.reinit(cell);
+      fe_values[velocities].get_function_values(present_solution,
+                                                velocity_values);
+      double max_velocity = 0;
+      for (const auto &v : velocity_values)
         {
-          save_checkpoint(time.get_timestep());
+          max_velocity = std::max(max_velocity, v.norm());
         }
-      if (parameters.simulation_type == "Fluid" && time.time_to_refine())
+      return cell->minimum_vertex_distance() /
+             parameters.fluid_velocity_degree / (max_velocity + sound_speed());
+    }
+
+    template <int dim>
+    double SCnsEX<dim>::sound_speed() const
+    {
+      // The same heat capacity ratio and atmospheric pressure as in assemble
+      const double cp_to_cv = 1.4;
+      const double atm = 1013250;
+      return std::sqrt(cp_to_cv * atm / parameters.fluid_rho);
+    }
+
+    template <int dim>
+    unsigned int SCnsEX<dim>::time_level(const double stable_step) const
+    {
+      const double ratio =
+        time.get_delta_t() / (parameters.cfl_number * stable_step);
+      if (ratio <= 1)
         {
-          refine_mesh(parameters.global_refinements[0],
-                      parameters.global_refinements[0] + 3);
+          return 0;
         }
+      // Cells beyond the finest level run above the target CFL number, as
+      // all of them do with a too large global time step.
+      return std::min(n_time_levels - 1,
+                      static_cast<unsigned int>(std::ceil(std::log2(ratio))));
+    }
+
+    template <int dim>
+    double SCnsEX<dim>::level_time_step(const unsigned int level) const
+    {
+      return time.get_delta_t() / (1u << level);
+    }
+
+    template <int dim>
+    void SCnsEX<dim>::setup_time_levels()
+    {
+      TimerOutput::Scope timer_section(timer, "Setup time levels");
+
+      // The ghost cells are assigned as well, which every process does in the
+      // same way, so that the dofs on the process boundaries agree.
+      FEValues<dim> fe_values(fe, volume_quad_formula, update_values);
+      std::vector<unsigned int> cells_per_level(n_time_levels, 0);
+      std::vector<unsigned int> cell_time_levels(triangulation.n_active_cells(),
+                                                 0);
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (cell->is_artificial())
+            {
+              continue;
+            }
+          const unsigned int level =
+            time_level(cell_stable_time_step(cell, fe_values));
+          cell_time_levels[cell->active_cell_index()] = level;
+          if (cell->is_locally_owned())
+            {
+              ++cells_per_level[level];
+            }
+        }
+      cells_per_level = Utilities::MPI::sum(cells_per_level, mpi_communicator);
+
+      // A dof takes the steps of the finest cell around it
+      std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+      dof_time_levels.assign(locally_relevant_dofs.n_elements(), 0);
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (cell->is_artificial())
+            {
+              continue;
+            }
+          cell->get_dof_indices(dof_indices);
+          for (const auto dof : dof_indices)
+            {
+              auto &level =
+                dof_time_levels[locally_relevant_dofs.index_within_set(dof)];
+              level =
+                std::max(level, cell_time_levels[cell->active_cell_index()]);
+            }
+        }
+
+      // Work per time step relative to stepping all the cells on the finest
+      // level
+      finest_time_level = 0;
+      double level_work = 0, finest_work = 0;
+      for (unsigned int l = 0; l < n_time_levels; ++l)
+        {
+          if (cells_per_level[l] > 0)
+            {
+              finest_time_level = l;
+            }
+          level_work += cells_per_level[l] * std::pow(2.0, l);
+        }
+      for (unsigned int l = 0; l < n_time_levels; ++l)
+        {
+          finest_work += cells_per_level[l] * std::pow(2.0, finest_time_level);
+        }
+      pcout << "Cells per time level:";
+      for (const auto n : cells_per_level)
+        {
+          pcout << " " << n;
+        }
+      pcout << ", relative work " << level_work / finest_work << std::endl;
+    }
+
+    template <int dim>
+    void SCnsEX<dim>::setup_level_step(const unsigned int level,
+                                       const unsigned int substep)
+    {
+      const unsigned int n_substeps = 1u << finest_time_level;
+      const unsigned int level_substeps = n_substeps >> level;
+
+      // The value of a dof at a substep within the step of the level. The
+      // coarser levels have completed their steps that contain it and are
+      // interpolated linearly, the finer ones are still at the start.
+      auto value_at = [&](const types::global_dof_index dof,
+                          const unsigned int at) {
+        const unsigned int dof_level =
+          dof_time_levels[locally_relevant_dofs.index_within_set(dof)];
+        if (dof_level >= level)
+          {
+            return static_cast<double>(present_solution(dof));
+          }
+        const unsigned int dof_substeps = n_substeps >> dof_level;
+        const unsigned int start = substep / dof_substeps * dof_substeps;
+        const double theta = static_cast<double>(at - start) / dof_substeps;
+        const double start_value = level_start_solutions[dof_level](dof);
+        return start_value + theta * (present_solution(dof) - start_value);
+      };
+
+      // The cells with dofs on the level, and all the dofs on them
+      std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+      std::vector<bool> on_level_cells(locally_relevant_dofs.n_elements(),
+                                       false);
+      level_cells.assign(triangulation.n_active_cells(), false);
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (cell->is_artificial())
+            {
+              continue;
+            }
+          cell->get_dof_indices(dof_indices);
+          bool on_level = false;
+          for (const auto dof : dof_indices)
+            {
+              on_level =
+                on_level ||
+                dof_time_levels[locally_relevant_dofs.index_within_set(dof)] ==
+                  level;
+            }
+          if (!on_level)
+            {
+              continue;
+            }
+          level_cells[cell->active_cell_index()] = true;
+          for (const auto dof : dof_indices)
+            {
+              on_level_cells[locally_relevant_dofs.index_within_set(dof)] =
+                true;
+            }
+        }
+
+      // The other dofs on these cells are fixed at the end of the substep
+      level_constraints.clear();
+      level_constraints.reinit(locally_relevant_dofs);
+      idle_dofs.clear();
+      for (const auto dof : locally_relevant_dofs)
+        {
+          const auto index = locally_relevant_dofs.index_within_set(dof);
+          if (!on_level_cells[index])
+            {
+              if (dof_handler.locally_owned_dofs().is_element(dof))
+                {
+                  idle_dofs.push_back(dof);
+                }
+              continue;
+            }
+          if (dof_time_levels[index] == level ||
+              nonzero_constraints.is_constrained(dof))
+            {
+              continue;
+            }
+          level_constraints.add_line(dof);
+          level_constraints.set_inhomogeneity(
+            dof, value_at(dof, substep + level_substeps));
+        }
+      level_constraints.merge(nonzero_constraints);
+      level_constraints.close();
+
+      // The old solution at the start of the substep, intermediate_solution
+      // is only used as the non-ghosted buffer
+      for (const auto dof : dof_handler.locally_owned_dofs())
+        {
+          intermediate_solution(dof) = value_at(dof, substep);
+        }
+      intermediate_solution.compress(VectorOperation::insert);
+      level_old_solution = intermediate_solution;
+    }
+
+    template <int dim>
+    unsigned int SCnsEX<dim>::advance_time_levels()
+    {
+      setup_time_levels();
+
+      const unsigned int n_substeps = 1u << finest_time_level;
+      unsigned int max_iterations = 0;
+      for (unsigned int substep = 0; substep < n_substeps; ++substep)
+        {
+          // Coarse first, so that the finer levels can interpolate them
+          for (unsigned int level = 0; level <= finest_time_level; ++level)
+            {
+              if (substep % (n_substeps >> level) != 0)
+                {
+                  continue;
+                }
+              level_start_solutions[level] = present_solution;
+              setup_level_step(level, substep);
+              // The cells of a level may have all their dofs on finer levels
+              const bool has_cells =
+                std::find(level_cells.begin(), level_cells.end(), true) !=
+                level_cells.end();
+              if (Utilities::MPI::max(static_cast<unsigned int>(has_cells),
+                                      mpi_communicator) == 0)
+                {
+                  continue;
+                }
+              pcout << " Level " << level << ", substep " << substep
+                    << std::endl;
+              max_iterations =
+                std::max(max_iterations, iterate(true, level));
+
+              // Only the dofs of the level are advanced
+              intermediate_solution = present_solution;
+              for (const auto dof : dof_handler.locally_owned_dofs())
+                {
+                  if (dof_time_levels[locally_relevant_dofs.index_within_set(
+                        dof)] == level)
+                    {
+                      intermediate_solution(dof) = evaluation_point(dof);
+                    }
+                }
+              intermediate_solution.compress(VectorOperation::insert);
+              present_solution = intermediate_solution;
+            }
+        }
+      return max_iterations;
+    }
+
+    template <int dim>
+    unsigned int SCnsEX<dim>::cell_weight(
+      const typename parallel::distributed::Triangulation<dim>::cell_iterator
+        &cell,
+      const typename parallel::distributed::Triangulation<dim>::CellStatus
+        status) const
+    {
+      double h = cell->minimum_vertex_distance();
+      if (status ==
+          parallel::distributed::Triangulation<dim>::CELL_REFINE)
+        {
+          h /= 2;
+        }
+      const unsigned int level = time_level(
+        h / parameters.fluid_velocity_degree / sound_speed());
+      // Every cell has a weight of 1000 on top of this
+      return 1000 * ((1u << level) - 1);
     }
 
     template <int dim>
@@ -538,6 +935,13 @@ namespace Fluid
                 }
             }
           triangulation.refine_global(parameters.global_refinements[0]);
+          // Balance the work of the time levels
+          if (weight_connection.connected())
+            {
+              dynamic_cast<parallel::distributed::Triangulation<dim> &>(
+                triangulation)
+                .repartition();
+            }
           setup_dofs();
           make_constraints();
           initialize_system();
@@ -9,8 +9,8 @@ namespace Fluid
       SchurComplementTpp(TimerOutput &timer2,
                          const std::vector<IndexSet> &owned_partitioning,
                          const PETScWrappers::MPI::BlockSparseMatrix &system,
-                         const PETScWrappers::PreconditionerBase &Pvvinv)
-      : timer2(timer2), system_matrix(&system), Pvv_inverse(&Pvvinv)
+                         const BlockIncompSchurPreconditioner &preconditioner)
+      : timer2(timer2), system_matrix(&system), preconditioner(&preconditioner)
     {
       dumb_vector.reinit(owned_partitioning,
                          system_matrix->get_mpi_communicator());
@@ -25,7 +25,7 @@ namespace Fluid
       PETScWrappers::MPI::Vector tmp1(dumb_vector.block(0)),
         tmp2(dumb_vector.block(0)), tmp3(src);
       system_matrix->block(0, 1).vmult(tmp1, src);
-      Pvv_inverse->vmult(tmp2, tmp1);
+      preconditioner->apply_Pvv_inverse(tmp2, tmp1);
       system_matrix->block(1, 0).vmult(tmp3, tmp2);
       system_matrix->block(1, 1).vmult(dst, src);
       dst -= tmp3;
@@ -38,19 +38,29 @@ namespace Fluid
       const PETScWrappers::MPI::BlockSparseMatrix &system,
       PETScWrappers::MPI::SparseMatrix &absA,
       PETScWrappers::MPI::SparseMatrix &schur,
-      PETScWrappers::MPI::SparseMatrix &B2pp)
+      PETScWrappers::MPI::SparseMatrix &B2pp,
+      const HypreILUSettings &ilu_settings,
+      const bool mixed_precision)
       : timer2(timer2),
         system_matrix(&system),
         Abs_A_matrix(&absA),
         schur_matrix(&schur),
         B2pp_matrix(&B2pp),
+        mixed_precision(mixed_precision),
         Tpp_itr(0)
     {
       // Initialize the Pvv inverse (the ILU(0) factorization of Avv)
-      Pvv_inverse.initialize(system_matrix->block(0, 0));
+      if (mixed_precision)
+        {
+          Pvv_inverse_float.initialize(system_matrix->block(0, 0));
+        }
+      else
+        {
+          Pvv_inverse = ilu_settings.create(system_matrix->block(0, 0));
+        }
       // Initialize Tpp
       Tpp.reset(new SchurComplementTpp(
-        timer2, owned_partitioning, *system_matrix, Pvv_inverse));
+        timer2, owned_partitioning, *system_matrix, *this));
 
       // Compute B2pp matrix App - Apv*rowsum(|Avv|)^(-1)*Avp
       // as the preconditioner to solve Tpp^-1
@@ -127,7 +137,29 @@ namespace Fluid
       B2pp_matrix->add(-1, *schur_matrix);
       B2pp_matrix->add(1, system_matrix->block(1, 1));
       B2pp_matrix->compress(VectorOperation::add);
-      B2pp_inverse.initialize(*B2pp_matrix);
+      if (mixed_precision)
+        {
+          B2pp_inverse_float.initialize(*B2pp_matrix);
+        }
+      else
+        {
+          B2pp_inverse = ilu_settings.create(*B2pp_matrix);
+        }
+    }
+
+    template <int dim>
+    void SCnsIM<dim>::BlockIncompSchurPreconditioner::apply_Pvv_inverse(
+      PETScWrappers::MPI::Vector &dst,
+      const PETScWrappers::MPI::Vector &src) const
+    {
+      if (mixed_precision)
+        {
+          Pvv_inverse_float.vmult(dst, src);
+        }
+      else
+        {
+          Pvv_inverse->vmult(dst, src);
+        }
     }
 
     /**
@@ -144,7 +176,7 @@ namespace Fluid
       //      |-ApvPvv^-1  I| |src(1)|   |ptmp  |
       /////////////////////////////////////////
       PETScWrappers::MPI::Vector ptmp1(src.block(0)), ptmp(src.block(1));
-      Pvv_inverse.vmult(ptmp1, src.block(0));
+      apply_Pvv_inverse(ptmp1, src.block(0));
       this->Apv().vmult(ptmp, ptmp1);
       ptmp *= -1.0;
       ptmp += src.block(1);
@@ -173,7 +205,14 @@ namespace Fluid
         solver_control,
         vector_memory,
         SolverGMRES<PETScWrappers::MPI::Vector>::AdditionalData(200));
-      gmres.solve(*Tpp, dst.block(1), ptmp, B2pp_inverse);
+      if (mixed_precision)
+        {
+          gmres.solve(*Tpp, dst.block(1), ptmp, B2pp_inverse_float);
+        }
+      else
+        {
+          gmres.solve(*Tpp, dst.block(1), ptmp, *B2pp_inverse);
+        }
       // B2pp_inverse.vmult(dst.block(1), ptmp);
       // Count iterations for this solver solving Tpp inverse
       Tpp_itr += solver_control.last_step();
@@ -183,25 +222,49 @@ namespace Fluid
       // Compute Pvv^-1*src(0) - Pvv^-1*Avp*dst(1)
       PETScWrappers::MPI::Vector utmp1(src.block(0)), utmp2(src.block(0));
       this->Avp().vmult(utmp1, dst.block(1));
-      Pvv_inverse.vmult(utmp2, utmp1);
-      Pvv_inverse.vmult(dst.block(0), src.block(0));
+      apply_Pvv_inverse(utmp2, utmp1);
+      apply_Pvv_inverse(dst.block(0), src.block(0));
       dst.block(0) -= utmp2;
     }
 
     template <int dim>
-    SCnsIM<dim>::SCnsIM(parallel::distributed::Triangulation<dim> &tria,
+    SCnsIM<dim>::SCnsIM(parallel::DistributedTriangulationBase<dim> &tria,
                         const Parameters::AllParameters &parameters)
-      : FluidSolver<dim>(tria, parameters)
+      : FluidSolver<dim>(tria, parameters),
+        previous_delta_t(0),
+        saved_previous_delta_t(0),
+        jacobian_delta_t(0),
+        jacobian_age(0),
+        n_jacobian_assemblies(0),
+        n_residual_assemblies(0),
+        ilu_tuner(
+          HypreILUSettings(
+            parameters.ilu_type,
+            PreconditionEuclid::AdditionalData(parameters.euclid_levels,
+                                               parameters.euclid_block_jacobi),
+            PreconditionPilut::AdditionalData(parameters.pilut_max_iterations,
+                                              parameters.pilut_factor_row_size,
+                                              parameters.pilut_tolerance)),
+          parameters.ilu_autotuning)
     {
       AssertThrow(parameters.fluid_velocity_degree ==
                     parameters.fluid_pressure_degree,
                   ExcMessage("Velocity degree must the same as pressure!"));
+      AssertThrow(parameters.fluid_linear_solver != "Field split" ||
+                    parameters.fluid_nonlinear_solver != "JFNK",
+                  ExcMessage("JFNK needs the block preconditioner!"));
+      AssertThrow(!parameters.ilu_autotuning ||
+                    (parameters.fluid_linear_solver == "Block preconditioner" &&
+                     !parameters.fluid_mixed_precision),
+                  ExcMessage("ILU autotuning needs the Hypre ILU in the "
+                             "block preconditioner!"));
     }
 
     template <int dim>
     void SCnsIM<dim>::initialize_system()
     {
       preconditioner.reset();
+      field_split_solver.clear();
       system_matrix.clear();
       Abs_A_matrix.clear();
       schur_matrix.clear();
@@ -281,18 +344,30 @@ namespace Fluid
     }
 
     template <int dim>
-    void SCnsIM<dim>::assemble(const bool use_nonzero_constraints)
+    void SCnsIM<dim>::assemble(const bool use_nonzero_constraints,
+                               const bool assemble_matrix)
     {
-      TimerOutput::Scope timer_section(timer, "Assemble system");
+      TimerOutput::Scope timer_section(
+        timer, assemble_matrix ? "Assemble system" : "Assemble residual");
+      AssertThrow(assemble_matrix || !use_nonzero_constraints,
+                  ExcMessage("Nonzero constraints need the cell matrix!"));
 
       Tensor<1, dim> gravity;
       for (unsigned int i = 0; i < dim; ++i)
         gravity[i] = parameters.gravity[i];
 
-      system_matrix = 0;
-      Abs_A_matrix = 0;
-      schur_matrix = 0;
-      B2pp_matrix = 0;
+      if (assemble_matrix)
+        {
+          system_matrix = 0;
+          Abs_A_matrix = 0;
+          schur_matrix = 0;
+          B2pp_matrix = 0;
+          ++n_jacobian_assemblies;
+        }
+      else
+        {
+          ++n_residual_assemblies;
+        }
 
       system_rhs = 0;
 
@@ -307,6 +382,8 @@ namespace Fluid
                                          update_JxW_values);
 
       const unsigned int dofs_per_cell = fe.dofs_per_cell;
+      // The residual alone skips the cell matrix
+      const unsigned int n_matrix_dofs = assemble_matrix ? dofs_per_cell : 0;
       const unsigned int u_dofs = fe.base_element(0).dofs_per_cell;
       const unsigned int p_dofs = fe.base_element(1).dofs_per_cell;
       const unsigned int n_q_points = volume_quad_formula.size();
@@ -460,7 +537,7 @@ namespace Fluid
                     {
                       double current_velocity_divergence =
                         trace(current_velocity_gradients[q]);
-                      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                      for (unsigned int j = 0; j < n_matrix_dofs; ++j)
                         {
                           // Let the linearized diffusion, continuity
                           // terms be written as
@@ -717,45 +794,139 @@ namespace Fluid
                 use_nonzero_constraints ? nonzero_constraints
                                         : zero_constraints;
 
-              constraints_used.distribute_local_to_global(local_matrix,
-                                                          local_rhs,
-                                                          local_dof_indices,
-                                                          system_matrix,
-                                                          system_rhs,
-                                                          true);
+              if (assemble_matrix)
+                {
+                  constraints_used.distribute_local_to_global(
+                    local_matrix,
+                    local_rhs,
+                    local_dof_indices,
+                    system_matrix,
+                    system_rhs,
+                    true);
+                }
+              else
+                {
+                  constraints_used.distribute_local_to_global(
+                    local_rhs, local_dof_indices, system_rhs);
+                }
             }
         }
 
-      system_matrix.compress(VectorOperation::add);
+      if (assemble_matrix)
+        {
+          system_matrix.compress(VectorOperation::add);
+        }
       system_rhs.compress(VectorOperation::add);
     }
 
+    template <int dim>
+    SCnsIM<dim>::JacobianFreeOperator::JacobianFreeOperator(
+      SCnsIM<dim> &solver)
+      : solver(solver)
+    {
+      point.reinit(solver.owned_partitioning, solver.mpi_communicator);
+      point = solver.evaluation_point;
+      rhs = solver.system_rhs;
+      constrained_dofs.reinit(solver.owned_partitioning,
+                              solver.mpi_communicator);
+      for (auto i : solver.dof_handler.locally_owned_dofs())
+        {
+          if (solver.zero_constraints.is_constrained(i))
+            {
+              constrained_dofs(i) = 1;
+            }
+        }
+      constrained_dofs.compress(VectorOperation::insert);
+    }
+
+    template <int dim>
+    void SCnsIM<dim>::JacobianFreeOperator::vmult(
+      PETScWrappers::MPI::BlockVector &dst,
+      const PETScWrappers::MPI::BlockVector &src) const
+    {
+      const double src_norm = src.l2_norm();
+      if (src_norm == 0)
+        {
+          dst = 0;
+          return;
+        }
+      // The usual step size, relative to the magnitude of the solution
+      const double epsilon =
+        std::sqrt(std::numeric_limits<double>::epsilon()) *
+        (1 + point.l2_norm()) / src_norm;
+      PETScWrappers::MPI::BlockVector perturbed_point(point);
+      perturbed_point.add(epsilon, src);
+      solver.evaluation_point = perturbed_point;
+      solver.assemble(false, false);
+      // The RHS is the negative residual
+      dst = rhs;
+      dst -= solver.system_rhs;
+      dst /= epsilon;
+      PETScWrappers::MPI::BlockVector constrained_src(src);
+      constrained_src.scale(constrained_dofs);
+      dst += constrained_src;
+    }
+
     template <int dim>
     std::pair<unsigned int, double>
-    SCnsIM<dim>::solve(const bool use_nonzero_constraints)
+    SCnsIM<dim>::solve(const bool use_nonzero_constraints,
+                       const bool update_preconditioner)
     {
       // This section includes the work done in the preconditioner
       // and GMRES solver.
       TimerOutput::Scope timer_section(timer, "Solve linear system");
-      preconditioner.reset(
-        new BlockIncompSchurPreconditioner(timer2,
-                                           owned_partitioning,
-                                           system_matrix,
-                                           Abs_A_matrix,
-                                           schur_matrix,
-                                           B2pp_matrix));
-
       SolverControl solver_control(
         system_matrix.m(), 1e-6 * system_rhs.l2_norm(), true);
 
-      // Because PETScWrappers::SolverGMRES requires preconditioner derived
-      // from PETScWrappers::PreconditionBase, we use dealii SolverFGMRES.
-      GrowingVectorMemory<PETScWrappers::MPI::BlockVector> vector_memory;
-      SolverFGMRES<PETScWrappers::MPI::BlockVector> gmres(solver_control,
-                                                          vector_memory);
-
       // The solution vector must be non-ghosted
-      gmres.solve(system_matrix, newton_update, system_rhs, *preconditioner);
+      if (parameters.fluid_linear_solver == "Field split")
+        {
+          field_split_solver.solve(system_matrix,
+                                   newton_update,
+                                   system_rhs,
+                                   solver_control,
+                                   update_preconditioner);
+        }
+      else
+        {
+          if (update_preconditioner || !preconditioner)
+            {
+              preconditioner.reset(new BlockIncompSchurPreconditioner(
+                timer2,
+                owned_partitioning,
+                system_matrix,
+                Abs_A_matrix,
+                schur_matrix,
+                B2pp_matrix,
+                ilu_tuner.current(),
+                parameters.fluid_mixed_precision));
+            }
+
+          // Because PETScWrappers::SolverGMRES requires preconditioner
+          // derived from PETScWrappers::PreconditionBase, we use dealii
+          // SolverFGMRES.
+          GrowingVectorMemory<PETScWrappers::MPI::BlockVector> vector_memory;
+          SolverFGMRES<PETScWrappers::MPI::BlockVector> gmres(solver_control,
+                                                              vector_memory);
+
+          if (parameters.fluid_nonlinear_solver == "JFNK" &&
+              !use_nonzero_constraints)
+            {
+              // The products overwrite the evaluation point and the RHS,
+              // which are restored afterwards.
+              const PETScWrappers::MPI::BlockVector rhs(system_rhs);
+              const PETScWrappers::MPI::BlockVector point(evaluation_point);
+              JacobianFreeOperator jacobian(*this);
+              gmres.solve(jacobian, newton_update, rhs, *preconditioner);
+              evaluation_point = point;
+              system_rhs = rhs;
+            }
+          else
+            {
+              gmres.solve(
+                system_matrix, newton_update, system_rhs, *preconditioner);
+            }
+        }
 
       const AffineConstraints<double> &constraints_used =
         use_nonzero_constraints ? nonzero_constraints : zero_constraints;
@@ -786,7 +957,12 @@ namespace Fluid
       double current_residual = 1.0;
       double initial_residual = 1.0;
       double relative_residual = 1.0;
+      // Residual reduction of the last iteration
+      double residual_ratio = 0.0;
       unsigned int outer_iteration = 0;
+      // Setup and solve time of the linear systems, which is what the ILU
+      // settings are tuned for.
+      double linear_solver_time = 0;
       evaluation_point = present_solution;
       while (relative_residual > parameters.fluid_tolerance &&
              current_residual > 1e-14)
@@ -796,15 +972,42 @@ namespace Fluid
 
           newton_update = 0;
 
-          // Since evaluation_point changes at every iteration,
-          // we have to reassemble both the lhs and rhs of the system
-          // before solving it.
           // If the Dirichlet BCs are time-dependent, nonzero_constraints
           // should be applied at the first iteration of every time step;
           // if they are time-independent, nonzero_constraints should be
           // applied only at the first iteration of the first time step.
-          assemble(apply_nonzero_constraints && outer_iteration == 0);
-          auto state = solve(apply_nonzero_constraints && outer_iteration == 0);
+          const bool use_nonzero_constraints =
+            apply_nonzero_constraints && outer_iteration == 0;
+          // Since evaluation_point changes at every iteration, the RHS is
+          // always reassembled. Full Newton reassembles the Jacobian as
+          // well, modified Newton and JFNK keep the Jacobian and its
+          // preconditioner over iterations and time steps until the
+          // convergence slows down. A Jacobian of a different time step
+          // size or mesh is not reused.
+          const bool has_preconditioner =
+            parameters.fluid_linear_solver == "Field split"
+              ? !field_split_solver.empty()
+              : preconditioner != nullptr;
+          const bool update_jacobian =
+            parameters.fluid_nonlinear_solver == "Newton" ||
+            use_nonzero_constraints || !has_preconditioner ||
+            jacobian_delta_t != time.get_delta_t() ||
+            jacobian_age >= parameters.jacobian_refresh_interval ||
+            residual_ratio > parameters.jacobian_refresh_ratio;
+          assemble(use_nonzero_constraints, update_jacobian);
+          if (update_jacobian)
+            {
+              jacobian_delta_t = time.get_delta_t();
+              jacobian_age = 0;
+            }
+          ++jacobian_age;
+          Timer linear_solver_timer;
+          auto state = solve(use_nonzero_constraints, update_jacobian);
+          linear_solver_time += linear_solver_timer.wall_time();
+          if (outer_iteration > 0)
+            {
+              residual_ratio = system_rhs.l2_norm() / current_residual;
+            }
           current_residual = system_rhs.l2_norm();
 
           // Update evaluation_point. Since newton_update has been set to
@@ -829,9 +1032,28 @@ namespace Fluid
                 << " GMRES_ITR = " << std::setw(3) << state.first
                 << " GMRES_RES = " << state.second
                 << " INNER_GMRES_ITR = " << std::setw(3)
-                << preconditioner->get_Tpp_itr_count() << std::endl;
+                << (preconditioner ? preconditioner->get_Tpp_itr_count() : 0)
+                << " JACOBIAN = " << update_jacobian << std::endl;
           outer_iteration++;
         }
+      if (ilu_tuner.tuning())
+        {
+          // All the processes must make the same choice
+          const double cost =
+            Utilities::MPI::max(linear_solver_time, mpi_communicator) /
+            outer_iteration;
+          pcout << "ILU autotuning: " << ilu_tuner.current().description()
+                << " takes " << cost << " s per Newton iteration" << std::endl;
+          ilu_tuner.record(cost);
+          if (!ilu_tuner.tuning())
+            {
+              pcout << "ILU autotuning: keeping "
+                    << ilu_tuner.current().description() << std::endl;
+            }
+          // The next time step builds the preconditioner with the new
+          // settings
+          preconditioner.reset();
+        }
       // Update solution increment, which is used in FSI application.
       PETScWrappers::MPI::BlockVector tmp1, tmp2;
       tmp1.reinit(owned_partitioning, mpi_communicator);
@@ -839,6 +1061,10 @@ namespace Fluid
       tmp1 = evaluation_point;
       tmp2 = present_solution;
       tmp2 -= tmp1;
+      if (time_step_controller.enabled())
+        {
+          adapt_time_step(tmp1, tmp2, outer_iteration);
+        }
       solution_increment = tmp2;
       // Newton iteration converges, update time and solution
       present_solution = evaluation_point;
@@ -861,6 +1087,51 @@ namespace Fluid
         }
     }
 
+    template <int dim>
+    void SCnsIM<dim>::adapt_time_step(
+      const PETScWrappers::MPI::BlockVector &solution,
+      const PETScWrappers::MPI::BlockVector &increment,
+      const unsigned int n_iterations)
+    {
+      const double dt = time.get_delta_t();
+      double factor = time_step_controller.iteration_factor(n_iterations);
+      PETScWrappers::MPI::Vector difference(increment.block(0));
+      PETScWrappers::MPI::Vector last_increment(increment.block(0));
+      last_increment = solution_increment.block(0);
+      // The last increment is zero after a restart or a mesh refinement, in
+      // which case only the Newton iterations are taken into account.
+      if (previous_delta_t > 0 && last_increment.l2_norm() > 0)
+        {
+          // u'' is approximated by the difference of the last two velocity
+          // increments divided by their time step sizes.
+          difference.add(-dt / previous_delta_t, last_increment);
+          const double error = dt / (dt + previous_delta_t) *
+                               difference.l2_norm() /
+                               std::max(solution.block(0).l2_norm(), 1e-12);
+          factor =
+            std::min(factor, time_step_controller.error_factor(error, 1));
+        }
+      previous_delta_t = dt;
+      time_step_controller.update(time, factor);
+      pcout << "Next time step size = " << time.get_delta_t() << std::endl;
+    }
+
+    template <int dim>
+    void SCnsIM<dim>::save_state()
+    {
+      FluidSolver<dim>::save_state();
+      saved_previous_delta_t = previous_delta_t;
+    }
+
+    template <int dim>
+    void SCnsIM<dim>::restore_state()
+    {
+      FluidSolver<dim>::restore_state();
+      previous_delta_t = saved_previous_delta_t;
+      // The Jacobian and its preconditioner belong to the rejected step
+      jacobian_delta_t = 0;
+    }
+
     template <int dim>
     void SCnsIM<dim>::run()
     {
@@ -908,6 +1179,9 @@ namespace Fluid
           else
             run_one_step(false);
         }
+      pcout << "Jacobian assemblies: " << n_jacobian_assemblies
+            << ", residual assemblies: " << n_residual_assemblies
+            << std::endl;
     }
     template class SCnsIM<2>;
     template class SCnsIM<3>;
@@ -0,0 +1,523 @@
+#include "mpi_shared_explicit_hyper_elasticity.h"
+
+namespace Solid
+{
+  namespace MPI
+  {
+    using namespace dealii;
+
+    template <int dim>
+    SharedExplicitHyperElasticity<dim>::SharedExplicitHyperElasticity(
+      Triangulation<dim> &tria,
+      const Parameters::AllParameters &params,
+      MPI_Comm communicator)
+      : SharedSolidSolver<dim>(tria, params, communicator),
+        critical_time_step(0)
+    {
+      AssertThrow(parameters.solid_type == "NeoHookean",
+                  ExcMessage("The explicit solver only supports NeoHookean "
+                             "materials!"));
+    }
+
+    template <int dim>
+    void SharedExplicitHyperElasticity<dim>::run_one_step(bool first_step)
+    {
+      if (first_step)
+        {
+          // The initial acceleration follows from the lumped mass directly
+          assemble_system(true);
+          compute_acceleration(previous_acceleration);
+          this->output_results(time.get_timestep());
+        }
+
+      time.increment();
+
+      // Subcycle the time step to keep the scheme stable
+      const double dt = time.get_delta_t();
+      const double stable_dt =
+        parameters.critical_time_step_fraction * critical_time_step;
+      const unsigned int n_substeps = std::max(
+        1u, static_cast<unsigned int>(std::ceil(dt / stable_dt - 1e-12)));
+      const double h = dt / n_substeps;
+
+      pcout << std::endl
+            << "Timestep " << time.get_timestep() << " @ " << time.current()
+            << "s, " << n_substeps << " substeps of " << h << "s"
+            << std::endl;
+
+      current_displacement = previous_displacement;
+      current_velocity = previous_velocity;
+      current_acceleration = previous_acceleration;
+      for (unsigned int substep = 0; substep < n_substeps; ++substep)
+        {
+          current_velocity.add(0.5 * h, current_acceleration);
+          current_displacement.add(h, current_velocity);
+          assemble_system(false);
+          compute_acceleration(current_acceleration);
+          current_velocity.add(0.5 * h, current_acceleration);
+        }
+
+      // Update the previous values
+      Utils::NewmarkUpdate::store(current_acceleration,
+                                  current_velocity,
+                                  current_displacement,
+                                  previous_acceleration,
+                                  previous_velocity,
+                                  previous_displacement);
+
+      // strain and stress
+      update_strain_and_stress();
+
+      if (time.time_to_output())
+        {
+          this->output_results(time.get_timestep());
+        }
+      if (parameters.simulation_type == "Solid" && time.time_to_save())
+        {
+          this->save_checkpoint(time.get_timestep());
+        }
+    }
+
+    template <int dim>
+    void SharedExplicitHyperElasticity<dim>::compute_acceleration(
+      PETScWrappers::MPI::Vector &acceleration)
+    {
+      acceleration = system_rhs;
+      acceleration.scale(inverse_lumped_mass);
+      // Hanging nodes follow their masters
+      constraints.distribute(acceleration);
+    }
+
+    template <int dim>
+    void SharedExplicitHyperElasticity<dim>::initialize_system()
+    {
+      SharedSolidSolver<dim>::initialize_system();
+      inverse_lumped_mass.reinit(locally_owned_dofs, mpi_communicator);
+      this->setup_reference_cache();
+      setup_qph();
+    }
+
+    template <int dim>
+    void SharedExplicitHyperElasticity<dim>::setup_qph()
+    {
+      const unsigned int n_q_points = volume_quad_formula.size();
+      for (auto cell = triangulation.begin_active();
+           cell != triangulation.end();
+           ++cell)
+        {
+          if (cell->subdomain_id() != this_mpi_process)
+            continue;
+          unsigned int mat_id = cell->material_id();
+          if (parameters.n_solid_parts == 1)
+            mat_id = 1;
+          quad_point_history.initialize(cell, n_q_points);
+          const std::vector<std::shared_ptr<Internal::PointHistory<dim>>> lqph =
+            quad_point_history.get_data(cell);
+          Assert(lqph.size() == n_q_points, ExcInternalError());
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              lqph[q]->setup(parameters, mat_id);
+            }
+        }
+    }
+
+    template <int dim>
+    void SharedExplicitHyperElasticity<dim>::estimate_critical_time_step()
+    {
+      double min_time_step = std::numeric_limits<double>::max();
+      for (auto cell = triangulation.begin_active();
+           cell != triangulation.end();
+           ++cell)
+        {
+          if (cell->subdomain_id() != this_mpi_process)
+            continue;
+          unsigned int mat_id = cell->material_id();
+          if (parameters.n_solid_parts == 1)
+            mat_id = 1;
+          // The shear modulus is twice C1 in NeoHookean model
+          const double mu = 2 * parameters.C[mat_id - 1][0];
+          const double kappa = parameters.C[mat_id - 1][1];
+          const double wave_speed =
+            std::sqrt((kappa + 4.0 / 3.0 * mu) / parameters.solid_rho);
+          min_time_step =
+            std::min(min_time_step,
+                     cell->minimum_vertex_distance() /
+                       parameters.solid_degree / wave_speed);
+        }
+      critical_time_step = Utilities::MPI::min(min_time_step, mpi_communicator);
+      pcout << "  Critical time step of the explicit solid solver: "
+            << critical_time_step << "s" << std::endl;
+    }
+
+    template <int dim>
+    void SharedExplicitHyperElasticity<dim>::assemble_system(bool initial_step)
+    {
+      timer.enter_subsection("Assemble residual");
+
+      const unsigned int n_q_points = volume_quad_formula.size();
+      const unsigned int n_f_q_points = face_quad_formula.size();
+      const unsigned int dofs_per_cell = fe.dofs_per_cell;
+      FEValuesExtractors::Vector displacement(0);
+
+      system_rhs = 0.0;
+      PETScWrappers::MPI::Vector lumped_mass;
+      if (initial_step)
+        {
+          lumped_mass.reinit(locally_owned_dofs, mpi_communicator);
+        }
+
+      FEValues<dim> fe_values(fe,
+                              volume_quad_formula,
+                              update_values | update_gradients |
+                                update_JxW_values);
+      FEFaceValues<dim> fe_face_values(fe,
+                                       face_quad_formula,
+                                       update_values | update_normal_vectors |
+                                         update_JxW_values);
+
+      std::vector<Tensor<2, dim>> grad_u(n_q_points);
+      Vector<double> local_displacement(dofs_per_cell);
+      Vector<double> local_rhs(dofs_per_cell);
+      Vector<double> local_mass(dofs_per_cell);
+      std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+
+      Vector<double> localized_displacement(current_displacement);
+      const bool cached = parameters.cache_reference_gradients;
+
+      std::vector<std::vector<Tensor<1, dim>>> fsi_stress_rows_values(dim);
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          fsi_stress_rows_values[d].resize(n_f_q_points);
+        }
+      Tensor<1, dim> gravity;
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          gravity[i] = parameters.gravity[i];
+        }
+
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (cell->subdomain_id() != this_mpi_process)
+            continue;
+
+          unsigned int c = 0;
+          cell->get_dof_indices(local_dof_indices);
+
+          local_mass = 0;
+          local_rhs = 0;
+
+          const std::vector<std::shared_ptr<Internal::PointHistory<dim>>> lqph =
+            quad_point_history.get_data(cell);
+          Assert(lqph.size() == n_q_points, ExcInternalError());
+
+          // The quadrature point history is updated in the same loop, since
+          // the residual is the only thing that depends on it.
+          if (cached)
+            {
+              c = reference_cache.index(cell);
+              cell->get_dof_values(localized_displacement, local_displacement);
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                {
+                  grad_u[q] =
+                    reference_cache.function_gradient(c, local_displacement, q);
+                }
+            }
+          else
+            {
+              fe_values.reinit(cell);
+              fe_values[displacement].get_function_gradients(
+                localized_displacement, grad_u);
+            }
+
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              lqph[q]->update(parameters, grad_u[q]);
+              const Tensor<2, dim> F_inv = lqph[q]->get_F_inv();
+              const SymmetricTensor<2, dim> tau = lqph[q]->get_tau();
+              const double rho = lqph[q]->get_density();
+              const double JxW =
+                cached ? reference_cache.get_JxW(c, q) : fe_values.JxW(q);
+
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                {
+                  const Tensor<1, dim> phi =
+                    cached ? reference_cache.value(i, q)
+                           : fe_values[displacement].value(i, q);
+                  const Tensor<2, dim> grad_phi =
+                    cached ? reference_cache.gradient(c, i, q)
+                           : fe_values[displacement].gradient(i, q);
+                  const SymmetricTensor<2, dim> sym_grad_phi =
+                    symmetrize(grad_phi * F_inv);
+                  local_rhs(i) -= sym_grad_phi * tau * JxW; // -internal force
+                  // body force
+                  local_rhs(i) += phi * gravity * rho * JxW;
+                  // The shape functions of the same component sum up to one,
+                  // so the row sum of the mass matrix is simply the integral
+                  // of the shape function.
+                  if (initial_step)
+                    {
+                      local_mass(i) +=
+                        rho * phi[fe.system_to_component_index(i).first] * JxW;
+                    }
+                }
+            }
+
+          // Neumann boundary conditions
+          // If this is a stand-alone solid simulation, the Neumann boundary
+          // type should be either Traction or Pressure; it this is a FSI
+          // simulation, the Neumann boundary type must be FSI.
+
+          for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
+               ++face)
+            {
+              unsigned int id = cell->face(face)->boundary_id();
+
+              if (!cell->face(face)->at_boundary())
+                {
+                  // Not a Neumann boundary
+                  continue;
+                }
+
+              if (parameters.simulation_type != "FSI" &&
+                  parameters.solid_neumann_bcs.find(id) ==
+                    parameters.solid_neumann_bcs.end())
+                {
+                  // Traction-free boundary, do nothing
+                  continue;
+                }
+
+              Tensor<1, dim> traction;
+              std::vector<double> prescribed_value;
+              if (parameters.simulation_type != "FSI")
+                {
+                  // In stand-alone simulation, the boundary value is prescribed
+                  // by the user.
+                  prescribed_value = parameters.solid_neumann_bcs[id];
+                }
+
+              if (parameters.simulation_type != "FSI" &&
+                  parameters.solid_neumann_bc_type == "Traction")
+                {
+                  for (unsigned int i = 0; i < dim; ++i)
+                    {
+                      traction[i] = prescribed_value[i];
+                    }
+                }
+
+              // Get FSI stress values on face quadrature points
+              std::vector<Tensor<2, dim>> fsi_stress(n_f_q_points);
+              if (parameters.simulation_type == "FSI")
+                {
+                  std::vector<Point<dim>> vertex_displacement(
+                    GeometryInfo<dim>::vertices_per_face);
+                  for (unsigned int v = 0;
+                       v < GeometryInfo<dim>::vertices_per_face;
+                       ++v)
+                    {
+                      for (unsigned int d = 0; d < dim; ++d)
+                        {
+                          vertex_displacement[v][d] = localized_displacement(
+                            cell->face(face)->vertex_dof_index(v, d));
+                        }
+                      cell->face(face)->vertex(v) += vertex_displacement[v];
+                    }
+                  fe_face_values.reinit(cell, face);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    {
+                      fe_face_values[displacement].get_function_values(
+                        fsi_stress_rows[d], fsi_stress_rows_values[d]);
+                    }
+                  for (unsigned int v = 0;
+                       v < GeometryInfo<dim>::vertices_per_face;
+                       ++v)
+                    {
+                      cell->face(face)->vertex(v) -= vertex_displacement[v];
+                    }
+                  for (unsigned int q = 0; q < n_f_q_points; ++q)
+                    {
+                      for (unsigned int d1 = 0; d1 < dim; ++d1)
+                        {
+                          for (unsigned int d2 = 0; d2 < dim; ++d2)
+                            {
+                              fsi_stress[q][d1][d2] =
+                                fsi_stress_rows_values[d1][q][d2];
+                            }
+                        }
+                    } // End looping quadrature points
+                }
+              else
+                {
+                  fe_face_values.reinit(cell, face);
+                }
+
+              for (unsigned int q = 0; q < n_f_q_points; ++q)
+                {
+                  if (parameters.simulation_type != "FSI" &&
+                      parameters.solid_neumann_bc_type == "Pressure")
+                    {
+                      // The normal is w.r.t. reference configuration!
+                      traction = fe_face_values.normal_vector(q);
+                      traction *= prescribed_value[0];
+                    }
+                  else if (parameters.simulation_type == "FSI")
+                    {
+                      traction =
+                        fsi_stress[q] * fe_face_values.normal_vector(q);
+                    }
+
+                  for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                    {
+                      const unsigned int component_j =
+                        fe.system_to_component_index(j).first;
+                      // +external force
+                      local_rhs(j) += fe_face_values.shape_value(j, q) *
+                                      traction[component_j] *
+                                      fe_face_values.JxW(q);
+                    }
+                }
+            }
+
+          constraints.distribute_local_to_global(
+            local_rhs, local_dof_indices, system_rhs);
+          if (initial_step)
+            {
+              constraints.distribute_local_to_global(
+                local_mass, local_dof_indices, lumped_mass);
+            }
+        }
+      system_rhs.compress(VectorOperation::add);
+
+      if (initial_step)
+        {
+          lumped_mass.compress(VectorOperation::add);
+          // Store the lumped mass as the diagonal of the mass matrix, the
+          // constrained rows are left empty since they are never solved for.
+          mass_matrix = 0.0;
+          inverse_lumped_mass = 0.0;
+          for (const auto i : locally_owned_dofs)
+            {
+              if (constraints.is_constrained(i))
+                continue;
+              Assert(lumped_mass(i) > 0, ExcInternalError());
+              mass_matrix.set(i, i, lumped_mass(i));
+              inverse_lumped_mass(i) = 1.0 / lumped_mass(i);
+            }
+          mass_matrix.compress(VectorOperation::insert);
+          inverse_lumped_mass.compress(VectorOperation::insert);
+          estimate_critical_time_step();
+        }
+      timer.leave_subsection();
+    }
+
+    template <int dim>
+    void SharedExplicitHyperElasticity<dim>::update_strain_and_stress()
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          for (unsigned int j = 0; j < dim; ++j)
+            {
+              strain[i][j] = 0.0;
+              stress[i][j] = 0.0;
+            }
+        }
+      PETScWrappers::MPI::Vector surrounding_cells(locally_owned_scalar_dofs,
+                                                   mpi_communicator);
+      surrounding_cells = 0.0;
+      // The strain and stress tensors are stored as 2D vectors of shape dim*dim
+      // at cell and quadrature point level.
+      std::vector<std::vector<Vector<double>>> cell_strain(
+        dim,
+        std::vector<Vector<double>>(dim,
+                                    Vector<double>(scalar_fe.dofs_per_cell)));
+      std::vector<std::vector<Vector<double>>> cell_stress(
+        dim,
+        std::vector<Vector<double>>(dim,
+                                    Vector<double>(scalar_fe.dofs_per_cell)));
+      std::vector<std::vector<Vector<double>>> quad_strain(
+        dim,
+        std::vector<Vector<double>>(
+          dim, Vector<double>(volume_quad_formula.size())));
+      std::vector<std::vector<Vector<double>>> quad_stress(
+        dim,
+        std::vector<Vector<double>>(
+          dim, Vector<double>(volume_quad_formula.size())));
+
+      // The projection matrix from quadrature points to the dofs.
+      FullMatrix<double> qpt_to_dof(scalar_fe.dofs_per_cell,
+                                    volume_quad_formula.size());
+      FETools::compute_projection_from_quadrature_points_matrix(
+        scalar_fe, volume_quad_formula, volume_quad_formula, qpt_to_dof);
+
+      auto cell = dof_handler.begin_active();
+      auto scalar_cell = scalar_dof_handler.begin_active();
+      Vector<double> local_sorrounding_cells(scalar_fe.dofs_per_cell);
+      local_sorrounding_cells = 1.0;
+
+      // The quadrature point history is up to date with the current
+      // displacement, so the strain and stress are read from there.
+      for (; cell != dof_handler.end(); ++cell, ++scalar_cell)
+        {
+          if (cell->subdomain_id() == this_mpi_process)
+            {
+              const std::vector<std::shared_ptr<Internal::PointHistory<dim>>>
+                lqph = quad_point_history.get_data(cell);
+
+              for (unsigned int q = 0; q < volume_quad_formula.size(); ++q)
+                {
+                  const SymmetricTensor<2, dim> tau = lqph[q]->get_tau();
+                  const Tensor<2, dim> F = invert(lqph[q]->get_F_inv());
+                  const double J = lqph[q]->get_det_F();
+                  for (unsigned int i = 0; i < dim; ++i)
+                    {
+                      for (unsigned int j = 0; j < dim; ++j)
+                        {
+                          quad_strain[i][j][q] = F[i][j];
+                          quad_stress[i][j][q] = tau[i][j] / J;
+                        }
+                    }
+                }
+
+              for (unsigned int i = 0; i < dim; ++i)
+                {
+                  for (unsigned int j = 0; j < dim; ++j)
+                    {
+                      qpt_to_dof.vmult(cell_strain[i][j], quad_strain[i][j]);
+                      qpt_to_dof.vmult(cell_stress[i][j], quad_stress[i][j]);
+                      scalar_cell->distribute_local_to_global(cell_strain[i][j],
+                                                              strain[i][j]);
+                      scalar_cell->distribute_local_to_global(cell_stress[i][j],
+                                                              stress[i][j]);
+                    }
+                }
+              scalar_cell->distribute_local_to_global(local_sorrounding_cells,
+                                                      surrounding_cells);
+            }
+        }
+      surrounding_cells.compress(VectorOperation::add);
+
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          for (unsigned int j = 0; j < dim; ++j)
+            {
+              strain[i][j].compress(VectorOperation::add);
+              stress[i][j].compress(VectorOperation::add);
+              const unsigned int local_begin =
+                surrounding_cells.local_range().first;
+              const unsigned int local_end =
+                surrounding_cells.local_range().second;
+              for (unsigned int k = local_begin; k < local_end; ++k)
+                {
+                  strain[i][j][k] /= surrounding_cells[k];
+                  stress[i][j][k] /= surrounding_cells[k];
+                }
+              strain[i][j].compress(VectorOperation::insert);
+              stress[i][j].compress(VectorOperation::insert);
+            }
+        }
+    }
+
+    template class SharedExplicitHyperElasticity<2>;
+    template class SharedExplicitHyperElasticity<3>;
+  } // namespace MPI
+} // namespace Solid
@@ -43,6 +43,9 @@ namespace Internal
     dPsi_vol_dJ = material->get_dPsi_vol_dJ();
     d2Psi_vol_dJ2 = material->get_d2Psi_vol_dJ2();
   }
+
+  template class PointHistory<2>;
+  template class PointHistory<3>;
 } // namespace Internal
 
 namespace Solid
@@ -53,8 +56,10 @@ namespace Solid
 
     template <int dim>
     SharedHyperElasticity<dim>::SharedHyperElasticity(
-      Triangulation<dim> &tria, const Parameters::AllParameters &params)
-      : SharedSolidSolver<dim>(tria, params)
+      Triangulation<dim> &tria,
+      const Parameters::AllParameters &params,
+      MPI_Comm communicator)
+      : SharedSolidSolver<dim>(tria, params, communicator), n_active_contacts(0)
     {
     }
 
@@ -72,108 +77,215 @@ namespace Solid
           this->output_results(time.get_timestep());
         }
 
-      PETScWrappers::MPI::Vector predicted_displacement(current_displacement);
-      PETScWrappers::MPI::Vector newton_update(current_displacement);
-      PETScWrappers::MPI::Vector tmp(current_displacement);
+      for (auto vector : {&predicted_displacement,
+                          &newton_update,
+                          &scratch_vector,
+                          &previous_rhs,
+                          &step_displacement})
+        {
+          Utils::NewmarkUpdate::reinit(
+            *vector, locally_owned_dofs, mpi_communicator);
+        }
 
       time.increment();
 
       pcout << std::endl
             << "Timestep " << time.get_timestep() << " @ " << time.current()
-            << "s" << std::endl;
-
-      // Reset the errors, iteration counter, and the solution increment
-      newton_update = 0;
-      unsigned int newton_iteration = 0;
-      error_residual = 1.0;
-      initial_error_residual = 1.0;
-      normalized_error_residual = 1.0;
-      error_update = 1.0;
-      initial_error_update = 1.0;
-      normalized_error_update = 1.0;
+            << "s, nonlinear solver: " << parameters.nonlinear_solver
+            << std::endl;
+
       const double dt = time.get_delta_t();
 
       // The prediction of the current displacement,
       // which is what we want to solve.
-      predicted_displacement = previous_displacement;
-      predicted_displacement.add(
-        dt, previous_velocity, (0.5 - beta) * dt * dt, previous_acceleration);
+      const Utils::NewmarkUpdate newmark(beta, gamma);
+      newmark.predict(predicted_displacement,
+                      dt,
+                      previous_displacement,
+                      previous_velocity,
+                      previous_acceleration);
 
       pcout << std::string(100, '_') << std::endl;
 
-      while ((normalized_error_update > parameters.tol_d ||
-              normalized_error_residual > parameters.tol_f) &&
-             error_update > 1e-12 && error_update > 1e-12)
+      // Without contact, the Newton iteration runs only once. Otherwise it
+      // is restarted after every augmentation of the contact multipliers
+      // until the penetration is within the tolerance.
+      unsigned int n_augmentations = 0;
+      // Newton iterations over all the augmentations
+      unsigned int n_iterations = 0;
+      do
         {
-          AssertThrow(newton_iteration < parameters.solid_max_iterations,
-                      ExcMessage("Too many Newton iterations!"));
-
-          // Compute the displacement, velocity and acceleration
-          current_acceleration = current_displacement;
-          current_acceleration -= predicted_displacement;
-          current_acceleration /= (beta * dt * dt);
-          current_velocity = previous_velocity;
-          current_velocity.add(dt * (1 - gamma),
-                               previous_acceleration,
-                               dt * gamma,
-                               current_acceleration);
-
-          // Assemble the system, and modify the RHS to account for
-          // the time-discretization.
-          assemble_system(false);
-          mass_matrix.vmult(tmp, current_acceleration);
-          system_rhs -= tmp;
-
-          // Solve linear system
-          const std::pair<unsigned int, double> lin_solver_output =
-            this->solve(system_matrix, newton_update, system_rhs);
-
-          // Error evaluation
-          {
-            // We should rule out the constrained components before evaluating
-            // the norms of system_rhs and newton_update.
-            error_residual = get_error(system_rhs);
-            if (newton_iteration == 0)
-              {
-                initial_error_residual = error_residual;
-              }
-            normalized_error_residual = error_residual / initial_error_residual;
+          AssertThrow(n_augmentations < parameters.solid_max_iterations,
+                      ExcMessage("Too many contact augmentations!"));
+          // Reset the errors, iteration counter, and the solution increment
+          newton_update = 0;
+          unsigned int newton_iteration = 0;
+          error_residual = 1.0;
+          initial_error_residual = 1.0;
+          normalized_error_residual = 1.0;
+          error_update = 1.0;
+          initial_error_update = 1.0;
+          normalized_error_update = 1.0;
+          // Residual reduction of the last iteration
+          double residual_ratio = 0.0;
+          lbfgs_s.clear();
+          lbfgs_y.clear();
+
+          while ((normalized_error_update > parameters.tol_d ||
+                  normalized_error_residual > parameters.tol_f) &&
+                 error_update > 1e-12 && error_update > 1e-12)
+            {
+              AssertThrow(newton_iteration < parameters.solid_max_iterations,
+                          ExcMessage("Too many Newton iterations!"));
+
+              // Compute the displacement, velocity and acceleration
+              newmark.correct(current_acceleration,
+                              current_velocity,
+                              dt,
+                              current_displacement,
+                              predicted_displacement,
+                              previous_velocity,
+                              previous_acceleration);
+
+              // Full Newton updates the tangent in every iteration, modified
+              // Newton every few iterations or when the convergence slows
+              // down, and L-BFGS only in the first iteration.
+              bool update_tangent = (newton_iteration == 0);
+              if (parameters.nonlinear_solver == "Newton")
+                {
+                  update_tangent = true;
+                }
+              else if (parameters.nonlinear_solver == "Modified Newton")
+                {
+                  update_tangent =
+                    update_tangent ||
+                    newton_iteration % parameters.tangent_refresh_interval ==
+                      0 ||
+                    residual_ratio > parameters.tangent_refresh_ratio;
+                }
+
+              // Assemble the system, and modify the RHS to account for
+              // the time-discretization.
+              assemble_system(false, update_tangent);
+              mass_matrix.vmult(scratch_vector, current_acceleration);
+              system_rhs -= scratch_vector;
+
+              // Solve linear system
+              std::pair<unsigned int, double> lin_solver_output;
+              if (parameters.nonlinear_solver == "LBFGS")
+                {
+                  if (newton_iteration > 0)
+                    {
+                      // The residual decreased by this along the last update,
+                      // which is stored if the curvature is positive.
+                      scratch_vector = previous_rhs;
+                      scratch_vector -= system_rhs;
+                      if (scratch_vector * newton_update > 0)
+                        {
+                          lbfgs_s.push_back(newton_update);
+                          lbfgs_y.push_back(scratch_vector);
+                          if (lbfgs_s.size() > parameters.lbfgs_history)
+                            {
+                              lbfgs_s.pop_front();
+                              lbfgs_y.pop_front();
+                            }
+                        }
+                    }
+                  previous_rhs = system_rhs;
+                  lin_solver_output = solve_lbfgs(system_rhs, newton_update);
+                }
+              else
+                {
+                  lin_solver_output =
+                    this->solve(system_matrix, newton_update, system_rhs);
+                }
 
-            error_update = get_error(newton_update);
-            if (newton_iteration == 0)
+              // Error evaluation
               {
-                initial_error_update = error_update;
+                // We should rule out the constrained components before
+                // evaluating the norms of system_rhs and newton_update.
+                const double last_error_residual = error_residual;
+                error_residual = get_error(system_rhs);
+                residual_ratio = (newton_iteration == 0)
+                                   ? 0.0
+                                   : error_residual / last_error_residual;
+                if (newton_iteration == 0)
+                  {
+                    initial_error_residual = error_residual;
+                  }
+                normalized_error_residual =
+                  error_residual / initial_error_residual;
+
+                error_update = get_error(newton_update);
+                if (newton_iteration == 0)
+                  {
+                    initial_error_update = error_update;
+                  }
+                normalized_error_update = error_update / initial_error_update;
               }
-            normalized_error_update = error_update / initial_error_update;
-          }
-
-          current_displacement += newton_update;
-          // Update the quadrature point history with the newest displacement
-          update_qph(current_displacement);
 
-          pcout << "Newton iteration = " << newton_iteration
-                << ", CG itr = " << lin_solver_output.first << std::fixed
-                << std::setprecision(3) << std::setw(7) << std::scientific
-                << ", CG res = " << lin_solver_output.second
-                << ", res_F = " << error_residual
-                << ", res_U = " << error_update << std::endl;
+              current_displacement += newton_update;
+              // Update the quadrature point history with the newest
+              // displacement
+              update_qph(current_displacement);
+
+              pcout << "Newton iteration = " << newton_iteration
+                    << ", CG itr = " << lin_solver_output.first << std::fixed
+                    << std::setprecision(3) << std::setw(7) << std::scientific
+                    << ", CG res = " << lin_solver_output.second
+                    << ", res_F = " << error_residual
+                    << ", res_U = " << error_update
+                    << ", K = " << (update_tangent ? "updated" : "reused");
+              if (penetration_criterion)
+                {
+                  pcout << ", contacts = " << n_active_contacts;
+                }
+              pcout << std::endl;
 
-          newton_iteration++;
+              newton_iteration++;
+            }
+          n_iterations += newton_iteration;
+          n_augmentations++;
         }
+      while (update_contact_multipliers());
 
       // Once converged, update current acceleration and velocity again.
-      current_acceleration = current_displacement;
-      current_acceleration -= predicted_displacement;
-      current_acceleration /= (beta * dt * dt);
-      current_velocity = previous_velocity;
-      current_velocity.add(dt * (1 - gamma),
-                           previous_acceleration,
-                           dt * gamma,
-                           current_acceleration);
+      newmark.correct(current_acceleration,
+                      current_velocity,
+                      dt,
+                      current_displacement,
+                      predicted_displacement,
+                      previous_velocity,
+                      previous_acceleration);
+      if (time_step_controller.enabled())
+        {
+          // The local truncation error of Newmark's method is estimated as
+          // \f$ \Delta t^2 (\beta - 1/6)(a_{n+1} - a_n) \f$ (Zienkiewicz
+          // and Xie), relative to the displacement in this step.
+          scratch_vector = current_acceleration;
+          scratch_vector -= previous_acceleration;
+          scratch_vector *= dt * dt * std::abs(beta - 1.0 / 6);
+          step_displacement = current_displacement;
+          step_displacement -= previous_displacement;
+          const double displacement_change = get_error(step_displacement);
+          double factor = time_step_controller.iteration_factor(n_iterations);
+          if (displacement_change > 0)
+            {
+              factor = std::min(
+                factor,
+                time_step_controller.error_factor(
+                  get_error(scratch_vector) / displacement_change, 2));
+            }
+          time_step_controller.update(time, factor);
+          pcout << "Next time step size = " << time.get_delta_t() << std::endl;
+        }
       // Update the previous values
-      previous_acceleration = current_acceleration;
-      previous_velocity = current_velocity;
-      previous_displacement = current_displacement;
+      Utils::NewmarkUpdate::store(current_acceleration,
+                                  current_velocity,
+                                  current_displacement,
+                                  previous_acceleration,
+                                  previous_velocity,
+                                  previous_displacement);
 
       pcout << std::string(100, '_') << std::endl
             << "Relative errors:" << std::endl
@@ -193,10 +305,37 @@ namespace Solid
         }
     }
 
+    template <int dim>
+    std::pair<unsigned int, double> SharedHyperElasticity<dim>::solve_lbfgs(
+      const PETScWrappers::MPI::Vector &residual,
+      PETScWrappers::MPI::Vector &update)
+    {
+      // Two-loop recursion, newest pair first
+      const unsigned int m = lbfgs_s.size();
+      std::vector<double> alpha(m), rho(m);
+      PETScWrappers::MPI::Vector q(residual);
+      for (int i = m - 1; i >= 0; --i)
+        {
+          rho[i] = 1.0 / (lbfgs_y[i] * lbfgs_s[i]);
+          alpha[i] = rho[i] * (lbfgs_s[i] * q);
+          q.add(-alpha[i], lbfgs_y[i]);
+        }
+      // The tangent of the first iteration is the initial inverse Hessian
+      const std::pair<unsigned int, double> output =
+        this->solve(system_matrix, update, q);
+      for (unsigned int i = 0; i < m; ++i)
+        {
+          const double beta_i = rho[i] * (lbfgs_y[i] * update);
+          update.add(alpha[i] - beta_i, lbfgs_s[i]);
+        }
+      return output;
+    }
+
     template <int dim>
     void SharedHyperElasticity<dim>::initialize_system()
     {
       SharedSolidSolver<dim>::initialize_system();
+      this->setup_reference_cache();
       setup_qph();
     }
 
@@ -238,6 +377,7 @@ namespace Solid
         fe, volume_quad_formula, update_values | update_gradients);
 
       Vector<double> tmp(evaluation_point);
+      Vector<double> local_displacement(fe.dofs_per_cell);
 
       for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
            ++cell)
@@ -248,8 +388,21 @@ namespace Solid
             quad_point_history.get_data(cell);
           Assert(lqph.size() == n_q_points, ExcInternalError());
 
-          fe_values.reinit(cell);
-          fe_values[displacement].get_function_gradients(tmp, grad_u);
+          if (parameters.cache_reference_gradients)
+            {
+              const unsigned int c = reference_cache.index(cell);
+              cell->get_dof_values(tmp, local_displacement);
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                {
+                  grad_u[q] =
+                    reference_cache.function_gradient(c, local_displacement, q);
+                }
+            }
+          else
+            {
+              fe_values.reinit(cell);
+              fe_values[displacement].get_function_gradients(tmp, grad_u);
+            }
 
           for (unsigned int q = 0; q < n_q_points; ++q)
             {
@@ -271,14 +424,24 @@ namespace Solid
         {
           if (cell->subdomain_id() != this_mpi_process)
             continue;
-          fe_values.reinit(cell);
           const std::vector<std::shared_ptr<const Internal::PointHistory<dim>>>
             lqph = quad_point_history.get_data(cell);
           Assert(lqph.size() == n_q_points, ExcInternalError());
+          unsigned int c = 0;
+          if (parameters.cache_reference_gradients)
+            {
+              c = reference_cache.index(cell);
+            }
+          else
+            {
+              fe_values.reinit(cell);
+            }
           for (unsigned int q = 0; q < n_q_points; ++q)
             {
               const double det = lqph[q]->get_det_F();
-              const double JxW = fe_values.JxW(q);
+              const double JxW = parameters.cache_reference_gradients
+                                   ? reference_cache.get_JxW(c, q)
+                                   : fe_values.JxW(q);
               volume += det * JxW;
             }
         }
@@ -298,9 +461,12 @@ namespace Solid
     }
 
     template <int dim>
-    void SharedHyperElasticity<dim>::assemble_system(bool initial_step)
+    void SharedHyperElasticity<dim>::assemble_system(bool initial_step,
+                                                     bool assemble_matrix)
     {
-      timer.enter_subsection("Assemble tangent matrix");
+      Assert(assemble_matrix || !initial_step, ExcInternalError());
+      timer.enter_subsection(assemble_matrix ? "Assemble tangent matrix"
+                                             : "Assemble residual");
 
       const unsigned int n_q_points = volume_quad_formula.size();
       const unsigned int n_f_q_points = face_quad_formula.size();
@@ -313,7 +479,11 @@ namespace Solid
         {
           mass_matrix = 0.0;
         }
-      system_matrix = 0.0;
+      // The tangent is kept if only the residual is assembled
+      if (assemble_matrix)
+        {
+          system_matrix = 0.0;
+        }
       system_rhs = 0.0;
 
       FEValues<dim> fe_values(fe,
@@ -356,7 +526,17 @@ namespace Solid
           if (cell->subdomain_id() != this_mpi_process)
             continue;
 
-          fe_values.reinit(cell);
+          // The reference shape data is either read from the cache or
+          // recomputed.
+          unsigned int c = 0;
+          if (parameters.cache_reference_gradients)
+            {
+              c = reference_cache.index(cell);
+            }
+          else
+            {
+              fe_values.reinit(cell);
+            }
           cell->get_dof_indices(local_dof_indices);
 
           local_mass = 0;
@@ -372,9 +552,18 @@ namespace Solid
               const Tensor<2, dim> F_inv = lqph[q]->get_F_inv();
               for (unsigned int k = 0; k < dofs_per_cell; ++k)
                 {
-                  phi[q][k] = fe_values[displacement].value(k, q);
-                  grad_phi[q][k] =
-                    fe_values[displacement].gradient(k, q) * F_inv;
+                  if (parameters.cache_reference_gradients)
+                    {
+                      phi[q][k] = reference_cache.value(k, q);
+                      grad_phi[q][k] =
+                        reference_cache.gradient(c, k, q) * F_inv;
+                    }
+                  else
+                    {
+                      phi[q][k] = fe_values[displacement].value(k, q);
+                      grad_phi[q][k] =
+                        fe_values[displacement].gradient(k, q) * F_inv;
+                    }
                   sym_grad_phi[q][k] = symmetrize(grad_phi[q][k]);
                 }
 
@@ -382,49 +571,60 @@ namespace Solid
               const SymmetricTensor<4, dim> Jc = lqph[q]->get_Jc();
               const double rho = lqph[q]->get_density();
               const double dt = time.get_delta_t();
-              const double JxW = fe_values.JxW(q);
+              const double JxW = parameters.cache_reference_gradients
+                                   ? reference_cache.get_JxW(c, q)
+                                   : fe_values.JxW(q);
 
               for (unsigned int i = 0; i < dofs_per_cell; ++i)
                 {
                   const unsigned int component_i =
                     fe.system_to_component_index(i).first;
-                  for (unsigned int j = 0; j <= i; ++j)
+                  if (assemble_matrix)
                     {
-                      if (initial_step)
+                      for (unsigned int j = 0; j <= i; ++j)
                         {
-                          local_mass(i, j) += rho * phi[q][i] * phi[q][j] * JxW;
-                        }
-                      else
-                        {
-                          const unsigned int component_j =
-                            fe.system_to_component_index(j).first;
-                          local_matrix(i, j) +=
-                            (phi[q][i] * phi[q][j] * rho / (beta * dt * dt) +
-                             sym_grad_phi[q][i] * Jc * sym_grad_phi[q][j]) *
-                            JxW;
-                          if (component_i == component_j)
+                          if (initial_step)
+                            {
+                              local_mass(i, j) +=
+                                rho * phi[q][i] * phi[q][j] * JxW;
+                            }
+                          else
                             {
+                              const unsigned int component_j =
+                                fe.system_to_component_index(j).first;
                               local_matrix(i, j) +=
-                                grad_phi[q][i][component_i] * tau *
-                                grad_phi[q][j][component_j] * JxW;
+                                (phi[q][i] * phi[q][j] * rho /
+                                   (beta * dt * dt) +
+                                 sym_grad_phi[q][i] * Jc *
+                                   sym_grad_phi[q][j]) *
+                                JxW;
+                              if (component_i == component_j)
+                                {
+                                  local_matrix(i, j) +=
+                                    grad_phi[q][i][component_i] * tau *
+                                    grad_phi[q][j][component_j] * JxW;
+                                }
                             }
                         }
                     }
                   local_rhs(i) -=
                     sym_grad_phi[q][i] * tau * JxW; // -internal force
                   // body force
-                  local_rhs[i] += phi[q][i] * gravity * rho * fe_values.JxW(q);
+                  local_rhs[i] += phi[q][i] * gravity * rho * JxW;
                 }
             }
 
-          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          if (assemble_matrix)
             {
-              for (unsigned int j = i + 1; j < dofs_per_cell; ++j)
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
                 {
-                  local_matrix(i, j) = local_matrix(j, i);
-                  if (initial_step)
+                  for (unsigned int j = i + 1; j < dofs_per_cell; ++j)
                     {
-                      local_mass(i, j) = local_mass(j, i);
+                      local_matrix(i, j) = local_matrix(j, i);
+                      if (initial_step)
+                        {
+                          local_mass(i, j) = local_mass(j, i);
+                        }
                     }
                 }
             }
@@ -552,7 +752,7 @@ namespace Solid
                                                      mass_matrix,
                                                      system_rhs);
             }
-          else
+          else if (assemble_matrix)
             {
               constraints.distribute_local_to_global(local_matrix,
                                                      local_rhs,
@@ -560,13 +760,23 @@ namespace Solid
                                                      system_matrix,
                                                      system_rhs);
             }
+          else
+            {
+              constraints.distribute_local_to_global(
+                local_rhs, local_dof_indices, system_rhs);
+            }
+        }
+
+      if (!initial_step && penetration_criterion)
+        {
+          assemble_contact(localized_displacement, assemble_matrix);
         }
 
       if (initial_step)
         {
           mass_matrix.compress(VectorOperation::add);
         }
-      else
+      else if (assemble_matrix)
         {
           system_matrix.compress(VectorOperation::add);
         }
@@ -574,6 +784,98 @@ namespace Solid
       timer.leave_subsection();
     }
 
+    template <int dim>
+    void SharedHyperElasticity<dim>::assemble_contact(
+      const Vector<double> &displacement, bool assemble_matrix)
+    {
+      const Tensor<1, dim> n =
+        penetration_direction / penetration_direction.norm();
+      FullMatrix<double> local_matrix(dim, dim);
+      Vector<double> local_rhs(dim);
+      unsigned int n_active = 0;
+      for (const auto &contact_vertex : contact_vertices)
+        {
+          Point<dim> x = triangulation.get_vertices()[contact_vertex.vertex];
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              x[d] += displacement(contact_vertex.dofs[d]);
+            }
+          const double penetration = std::invoke(*penetration_criterion, x);
+          const double stiffness =
+            parameters.contact_penalty * contact_vertex.area;
+          const double force =
+            contact_vertex.multiplier + stiffness * penetration;
+          // No force where the gap is open, whatever the multiplier
+          if (penetration < 0 || force <= 0)
+            continue;
+          ++n_active;
+          // The penetration decreases along the contact direction, so the
+          // force pushing the vertex out contributes stiffness * n x n to the
+          // tangent.
+          for (unsigned int i = 0; i < dim; ++i)
+            {
+              local_rhs[i] = force * n[i];
+              for (unsigned int j = 0; j < dim; ++j)
+                {
+                  local_matrix(i, j) = stiffness * n[i] * n[j];
+                }
+            }
+          if (assemble_matrix)
+            {
+              constraints.distribute_local_to_global(local_matrix,
+                                                     local_rhs,
+                                                     contact_vertex.dofs,
+                                                     system_matrix,
+                                                     system_rhs);
+            }
+          else
+            {
+              constraints.distribute_local_to_global(
+                local_rhs, contact_vertex.dofs, system_rhs);
+            }
+        }
+      n_active_contacts = Utilities::MPI::sum(n_active, mpi_communicator);
+    }
+
+    template <int dim>
+    bool SharedHyperElasticity<dim>::update_contact_multipliers()
+    {
+      if (!penetration_criterion)
+        return false;
+      Vector<double> localized_displacement(current_displacement);
+      double max_penetration = 0;
+      for (auto &contact_vertex : contact_vertices)
+        {
+          Point<dim> x = triangulation.get_vertices()[contact_vertex.vertex];
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              x[d] += localized_displacement(contact_vertex.dofs[d]);
+            }
+          const double penetration = std::invoke(*penetration_criterion, x);
+          const double stiffness =
+            parameters.contact_penalty * contact_vertex.area;
+          max_penetration = std::max(max_penetration, penetration);
+          // The contact is released where the gap opens
+          if (penetration < 0)
+            {
+              contact_vertex.multiplier = 0;
+            }
+          else
+            {
+              contact_vertex.multiplier += stiffness * penetration;
+            }
+        }
+      max_penetration = Utilities::MPI::max(max_penetration, mpi_communicator);
+      // Same tolerance as the contact model in FSI
+      if (max_penetration > 1e-5)
+        {
+          pcout << "Penetrating by " << max_penetration
+                << ", augment contact forces!" << std::endl;
+          return true;
+        }
+      return false;
+    }
+
     template <int dim>
     void SharedHyperElasticity<dim>::update_strain_and_stress()
     {
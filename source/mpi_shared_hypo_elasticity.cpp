@@ -42,58 +42,48 @@ namespace Solid
       Triangulation<dim> &tria,
       const Parameters::AllParameters &params,
       double dx,
-      double hdx)
-      : SharedSolidSolver<dim>(tria, params), dx(dx), hdx(hdx)
+      double hdx,
+      MPI_Comm communicator)
+      : SharedSolidSolver<dim>(tria, params, communicator), dx(dx), hdx(hdx)
     {
     }
 
     template <int dim>
     void SharedHypoElasticity<dim>::run_one_step(bool first_step)
     {
-      // Not parallelized yet, only rank 0 does work!
+      // Every process advances its own part of the body, see m_body.
+      std::string particle_file = "particles";
+      if (n_mpi_processes > 1)
+        {
+          particle_file += "-" + Utilities::int_to_string(this_mpi_process, 4);
+        }
       if (first_step)
         {
-          if (this_mpi_process == 0)
-            {
-              construct_particles();
-              utilities<dim>::vtk_write_particle(m_body->get_particles(),
-                                                 m_body->get_num_part(),
-                                                 time.get_timestep(),
-                                                 "particles");
-            }
+          construct_particles();
+          store_body_state();
+          utilities<dim>::vtk_write_particle(m_body->get_particles(),
+                                             m_body->get_num_part(),
+                                             time.get_timestep(),
+                                             particle_file);
           this->output_results(time.get_timestep());
         }
       time.increment();
       pcout << std::endl
             << "Timestep " << time.get_timestep() << " @ " << time.current()
             << "s" << std::endl;
-      if (this_mpi_process == 0)
-        {
-          m_body->step();
-          synchronize();
-        }
-      // distribute
-      Vector<double> displacement(dof_handler.n_dofs());
-      Vector<double> velocity(dof_handler.n_dofs());
-      Vector<double> acceleration(dof_handler.n_dofs());
-      Utilities::MPI::sum(
-        serialized_displacement, mpi_communicator, displacement);
-      Utilities::MPI::sum(serialized_velocity, mpi_communicator, velocity);
-      Utilities::MPI::sum(
-        serialized_acceleration, mpi_communicator, acceleration);
-      current_displacement = displacement;
-      current_velocity = velocity;
-      current_acceleration = acceleration;
+      update_ghosts();
+      {
+        TimerOutput::Scope timer_section(timer, "Advance particles");
+        m_body->step();
+      }
+      synchronize();
       if (time.time_to_output())
         {
           this->output_results(time.get_timestep());
-          if (this_mpi_process == 0)
-            {
-              utilities<dim>::vtk_write_particle(m_body->get_particles(),
-                                                 m_body->get_num_part(),
-                                                 time.get_timestep(),
-                                                 "particles");
-            }
+          utilities<dim>::vtk_write_particle(m_body->get_particles(),
+                                             m_body->get_num_part(),
+                                             time.get_timestep(),
+                                             particle_file);
         }
       if (parameters.simulation_type == "Solid" && time.time_to_save())
         {
@@ -105,9 +95,7 @@ namespace Solid
     void SharedHypoElasticity<dim>::initialize_system()
     {
       SharedSolidSolver<dim>::initialize_system();
-      serialized_displacement = Vector<double>(dof_handler.n_dofs());
-      serialized_velocity = Vector<double>(dof_handler.n_dofs());
-      serialized_acceleration = Vector<double>(dof_handler.n_dofs());
+      setup_local_body();
     }
 
     template <int dim>
@@ -123,26 +111,248 @@ namespace Solid
       // do nothing
     }
 
+    template <int dim>
+    void SharedHypoElasticity<dim>::setup_local_body()
+    {
+      const unsigned int n_q_points = volume_quad_formula.size();
+      const unsigned int n_quad_state = dim * dim + 2;
+      const unsigned int n_cells = triangulation.n_active_cells();
+
+      // In every RK4 stage, particles and quadrature points interact within
+      // the support hdx * dx in both directions, and the particles near the
+      // edge of the truncated body have wrong RKPM corrections. So the owned
+      // cells are advanced exactly if the halo is wider than
+      // (2 * 4 + 2) supports.
+      const double halo_width = 10 * hdx * dx;
+      in_local_body.assign(n_cells, false);
+      Utils::CellCenterIndex<dim> index(dof_handler);
+      std::vector<unsigned int> neighbors;
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (cell->subdomain_id() != this_mpi_process)
+            continue;
+          index.query(cell->center(),
+                      halo_width + cell->diameter() +
+                        index.get_max_diameter(),
+                      neighbors);
+          for (auto i : neighbors)
+            {
+              in_local_body[index.entry(i).cell->active_cell_index()] = true;
+            }
+        }
+
+      // Number the cells subdomain by subdomain
+      std::vector<unsigned int> subdomain_offset(n_mpi_processes + 1, 0);
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          subdomain_offset[cell->subdomain_id() + 1]++;
+        }
+      for (unsigned int i = 0; i < n_mpi_processes; ++i)
+        {
+          subdomain_offset[i + 1] += subdomain_offset[i];
+        }
+      std::vector<unsigned int> counter(subdomain_offset.begin(),
+                                        subdomain_offset.end() - 1);
+      subdomain_wise_cell_index.resize(n_cells);
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          subdomain_wise_cell_index[cell->active_cell_index()] =
+            counter[cell->subdomain_id()]++;
+        }
+
+      // Exchange patterns of the nodal and quadrature point states
+      const unsigned int state_per_cell = n_q_points * n_quad_state;
+      locally_owned_quad_state = IndexSet(n_cells * state_per_cell);
+      locally_owned_quad_state.add_range(
+        subdomain_offset[this_mpi_process] * state_per_cell,
+        subdomain_offset[this_mpi_process + 1] * state_per_cell);
+      locally_relevant_quad_state = IndexSet(n_cells * state_per_cell);
+      locally_relevant_body_dofs = IndexSet(dof_handler.n_dofs());
+      std::vector<types::global_dof_index> local_dof_indices(fe.dofs_per_cell);
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
+          const unsigned int begin =
+            subdomain_wise_cell_index[cell->active_cell_index()] *
+            state_per_cell;
+          locally_relevant_quad_state.add_range(begin, begin + state_per_cell);
+          cell->get_dof_indices(local_dof_indices);
+          locally_relevant_body_dofs.add_indices(local_dof_indices.begin(),
+                                                 local_dof_indices.end());
+        }
+      locally_relevant_quad_state.compress();
+      locally_relevant_body_dofs.compress();
+      quad_state.reinit(locally_owned_quad_state, mpi_communicator);
+      // The particle states are numbered like the dofs, three per dof
+      locally_owned_particle_state = IndexSet(3 * dof_handler.n_dofs());
+      for (const auto dof : locally_owned_dofs)
+        {
+          locally_owned_particle_state.add_range(3 * dof, 3 * dof + 3);
+        }
+      locally_relevant_particle_state = IndexSet(3 * dof_handler.n_dofs());
+      for (const auto dof : locally_relevant_body_dofs)
+        {
+          locally_relevant_particle_state.add_range(3 * dof, 3 * dof + 3);
+        }
+      locally_owned_particle_state.compress();
+      locally_relevant_particle_state.compress();
+      particle_state.reinit(locally_owned_particle_state, mpi_communicator);
+    }
+
+    template <int dim>
+    void SharedHypoElasticity<dim>::update_ghosts()
+    {
+      TimerOutput::Scope timer_section(timer, "Update ghosts");
+      const unsigned int n_q_points = volume_quad_formula.size();
+      const unsigned int n_quad_state = dim * dim + 2;
+
+      // Only the entries in the halo are communicated, from their owners.
+      PETScWrappers::MPI::Vector displacement(
+        locally_owned_dofs, locally_relevant_body_dofs, mpi_communicator);
+      PETScWrappers::MPI::Vector velocity(
+        locally_owned_dofs, locally_relevant_body_dofs, mpi_communicator);
+      PETScWrappers::MPI::Vector acceleration(
+        locally_owned_dofs, locally_relevant_body_dofs, mpi_communicator);
+      PETScWrappers::MPI::Vector rates(locally_owned_particle_state,
+                                       locally_relevant_particle_state,
+                                       mpi_communicator);
+      PETScWrappers::MPI::Vector state(locally_owned_quad_state,
+                                       locally_relevant_quad_state,
+                                       mpi_communicator);
+      displacement = current_displacement;
+      velocity = current_velocity;
+      acceleration = current_acceleration;
+      rates = particle_state;
+      state = quad_state;
+
+      for (unsigned int id = 0; id < m_body->get_num_part(); ++id)
+        {
+          if (locally_owned_dofs.is_element(particle_dofs[id * dim]))
+            continue;
+          particle<dim> *p = m_body->get_particles()[id];
+          particle<dim> *cur_p = m_body->get_cur_particles()[id];
+          for (unsigned int n = 0; n < dim; ++n)
+            {
+              const auto dof = particle_dofs[id * dim + n];
+              p->x[n] = p->X[n] + displacement(dof);
+              p->v[n] = velocity(dof);
+              p->a[n] = acceleration(dof);
+              p->previous_v[n] = rates(3 * dof);
+              p->v_t[n] = rates(3 * dof + 1);
+              cur_p->x[n] = p->x[n];
+              cur_p->v[n] = p->v[n];
+              cur_p->a[n] = p->a[n];
+              cur_p->previous_v[n] = p->previous_v[n];
+              cur_p->v_t[n] = p->v_t[n];
+            }
+          p->rho = rates(3 * particle_dofs[id * dim] + 2);
+          cur_p->rho = p->rho;
+        }
+
+      // The quadrature points are stored cell by cell in the local body
+      unsigned int quad_point_id = 0;
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
+          if (cell->subdomain_id() == this_mpi_process)
+            {
+              quad_point_id += n_q_points;
+              continue;
+            }
+          unsigned int iter =
+            subdomain_wise_cell_index[cell->active_cell_index()] *
+            n_q_points * n_quad_state;
+          for (unsigned int q = 0; q < n_q_points; ++q, ++quad_point_id)
+            {
+              particle<dim> *qp = m_body->get_quad_points()[quad_point_id];
+              for (unsigned int r = 0; r < dim; ++r)
+                for (unsigned int c = 0; c < dim; ++c)
+                  qp->S(r, c) = state(iter++);
+              qp->p = state(iter++);
+              qp->rho = state(iter++);
+            }
+        }
+    }
+
+    template <int dim>
+    void SharedHypoElasticity<dim>::store_body_state()
+    {
+      const unsigned int n_q_points = volume_quad_formula.size();
+      const unsigned int n_quad_state = dim * dim + 2;
+
+      // Every owner writes the states of its own particles
+      for (unsigned int id = 0; id < m_body->get_num_part(); ++id)
+        {
+          if (!locally_owned_dofs.is_element(particle_dofs[id * dim]))
+            continue;
+          const particle<dim> *p = m_body->get_particles()[id];
+          for (unsigned int n = 0; n < dim; ++n)
+            {
+              const auto dof = particle_dofs[id * dim + n];
+              current_displacement(dof) = p->x[n] - p->X[n];
+              current_velocity(dof) = p->v[n];
+              current_acceleration(dof) = p->a[n];
+              particle_state(3 * dof) = p->previous_v[n];
+              particle_state(3 * dof + 1) = p->v_t[n];
+              particle_state(3 * dof + 2) = p->rho;
+            }
+        }
+      current_displacement.compress(VectorOperation::insert);
+      current_velocity.compress(VectorOperation::insert);
+      current_acceleration.compress(VectorOperation::insert);
+      particle_state.compress(VectorOperation::insert);
+
+      unsigned int quad_point_id = 0;
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
+          if (cell->subdomain_id() != this_mpi_process)
+            {
+              quad_point_id += n_q_points;
+              continue;
+            }
+          unsigned int iter =
+            subdomain_wise_cell_index[cell->active_cell_index()] *
+            n_q_points * n_quad_state;
+          for (unsigned int q = 0; q < n_q_points; ++q, ++quad_point_id)
+            {
+              const particle<dim> *qp =
+                m_body->get_quad_points()[quad_point_id];
+              for (unsigned int r = 0; r < dim; ++r)
+                for (unsigned int c = 0; c < dim; ++c)
+                  quad_state(iter++) = qp->S(r, c);
+              quad_state(iter++) = qp->p;
+              quad_state(iter++) = qp->rho;
+            }
+        }
+      quad_state.compress(VectorOperation::insert);
+    }
+
     template <int dim>
     void SharedHypoElasticity<dim>::synchronize()
     {
-      std::vector<bool> vertex_touched(triangulation.n_vertices(), false);
-      const unsigned int dofs_per_cell = fe.dofs_per_cell;
+      TimerOutput::Scope timer_section(timer, "Synchronize");
+      store_body_state();
       unsigned int n_face_q_points = face_quad_formula.size();
       unsigned int face_quad_point_id = 0;
 
       const FEValuesExtractors::Vector displacement(0);
 
-      FEValues<dim> fe_values(fe, volume_quad_formula, update_values);
-
       FEFaceValues<dim> fe_face_values(
         fe,
         face_quad_formula,
         update_values | update_quadrature_points | update_normal_vectors |
           update_JxW_values);
 
-      std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
-
       std::vector<std::vector<Tensor<1, dim>>> fsi_stress_rows_values(dim);
       for (unsigned int d = 0; d < dim; ++d)
         {
@@ -152,29 +362,9 @@ namespace Solid
       for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
            ++cell)
         {
-          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
-               ++v)
-            {
-              if (!vertex_touched[cell->vertex_index(v)])
-                {
-                  vertex_touched[cell->vertex_index(v)] = true;
-                  int id = vertex_mapping[cell->vertex_index(v)];
-                  auto disp = m_body->get_particles()[id]->x -
-                              m_body->get_particles()[id]->X;
-                  auto vel = m_body->get_particles()[id]->v;
-                  auto acc = m_body->get_particles()[id]->a;
-                  for (unsigned int n = 0; n < dim; ++n)
-                    {
-                      serialized_displacement(cell->vertex_dof_index(v, n)) =
-                        disp[n];
-                      serialized_velocity(cell->vertex_dof_index(v, n)) =
-                        vel[n];
-                      serialized_acceleration(cell->vertex_dof_index(v, n)) =
-                        acc[n];
-                    }
-                }
-            }
-          cell->get_dof_indices(local_dof_indices);
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
+          // The halo also needs the traction to be advanced correctly
           for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
             {
               if (cell->face(f)->at_boundary())
@@ -185,10 +375,12 @@ namespace Solid
                        v < GeometryInfo<dim>::vertices_per_face;
                        ++v)
                     {
+                      int id = vertex_mapping[cell->face(f)->vertex_index(v)];
+                      auto disp = m_body->get_particles()[id]->x -
+                                  m_body->get_particles()[id]->X;
                       for (unsigned int d = 0; d < dim; ++d)
                         {
-                          vertex_displacement[v][d] = serialized_displacement(
-                            cell->face(f)->vertex_dof_index(v, d));
+                          vertex_displacement[v][d] = disp[d];
                         }
                       cell->face(f)->vertex(v) += vertex_displacement[v];
                     }
@@ -237,14 +429,30 @@ namespace Solid
       FEValues<dim> fe_values(
         fe, volume_quad_formula, update_quadrature_points | update_JxW_values);
       unsigned int n_q_points = volume_quad_formula.size();
+      // Only the cells in the local body are turned into particles
+      unsigned int n_local_cells = 0;
+      std::vector<bool> vertex_in_body(triangulation.n_vertices(), false);
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
+          ++n_local_cells;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            {
+              vertex_in_body[cell->vertex_index(v)] = true;
+            }
+        }
       // Particles
-      unsigned int n_particles = triangulation.n_vertices();
+      unsigned int n_particles =
+        std::count(vertex_in_body.begin(), vertex_in_body.end(), true);
       particle<dim> **particles = new particle<dim> *[n_particles];
       unsigned int particle_id = 0;
       vertex_mapping = std::vector<int>(triangulation.n_vertices(), -1);
+      particle_dofs.resize(n_particles * dim);
       // Volume quadrature points, assuming 2nd order integration
-      unsigned int n_vol_quad =
-        volume_quad_formula.size() * triangulation.n_active_cells();
+      unsigned int n_vol_quad = volume_quad_formula.size() * n_local_cells;
       particle<dim> **vol_quad_points = new particle<dim> *[n_vol_quad];
       unsigned int vol_quad_point_id = 0;
       // Face quadrature points, assuming 2nd order integration
@@ -255,6 +463,8 @@ namespace Solid
       for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
            ++cell)
         {
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
           // Vertex
           for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
                ++v)
@@ -273,6 +483,11 @@ namespace Solid
                     cell->measure() * parameters.solid_rho;
                   particles[particle_id]->quad_weight =
                     particles[particle_id]->m / particles[particle_id]->rho;
+                  for (unsigned int n = 0; n < dim; ++n)
+                    {
+                      particle_dofs[particle_id * dim + n] =
+                        cell->vertex_dof_index(v, n);
+                    }
                   vertex_mapping[cell->vertex_index(v)] = particle_id++;
                 }
             }
@@ -303,7 +518,7 @@ namespace Solid
                 }
             }
         }
-      AssertThrow(triangulation.n_vertices() == particle_id,
+      AssertThrow(n_particles == particle_id,
                   ExcMessage("Vertices do not match!"));
       AssertThrow(n_vol_quad == vol_quad_point_id,
                   ExcMessage("Volume quadrature points do not match!"));
@@ -314,6 +529,8 @@ namespace Solid
       for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
            ++cell)
         {
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
           // Then set face quad points
           for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
             {
@@ -419,36 +636,25 @@ namespace Solid
           return false;
         }
       construct_particles();
-      std::vector<bool> vertex_touched(triangulation.n_vertices(), false);
       Vector<double> localized_displacement(current_displacement);
       Vector<double> localized_velocity(current_velocity);
       Vector<double> localized_acceleration(current_acceleration);
-      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
-           ++cell)
+      for (unsigned int id = 0; id < m_body->get_num_part(); ++id)
         {
-          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
-               ++v)
+          for (unsigned int n = 0; n < dim; ++n)
             {
-              if (!vertex_touched[cell->vertex_index(v)])
-                {
-                  vertex_touched[cell->vertex_index(v)] = true;
-                  int id = vertex_mapping[cell->vertex_index(v)];
-                  for (unsigned int n = 0; n < dim; ++n)
-                    {
-                      m_body->get_cur_particles()[id]->x[n] +=
-                        localized_displacement(cell->vertex_dof_index(v, n));
-                      m_body->get_cur_particles()[id]->v[n] +=
-                        localized_velocity(cell->vertex_dof_index(v, n));
-                      m_body->get_cur_particles()[id]->a[n] +=
-                        localized_acceleration(cell->vertex_dof_index(v, n));
-                      m_body->get_particles()[id]->x[n] =
-                        m_body->get_cur_particles()[id]->x[n];
-                      m_body->get_particles()[id]->v[n] =
-                        m_body->get_cur_particles()[id]->v[n];
-                      m_body->get_particles()[id]->a[n] =
-                        m_body->get_cur_particles()[id]->a[n];
-                    }
-                }
+              const auto dof = particle_dofs[id * dim + n];
+              m_body->get_cur_particles()[id]->x[n] +=
+                localized_displacement(dof);
+              m_body->get_cur_particles()[id]->v[n] += localized_velocity(dof);
+              m_body->get_cur_particles()[id]->a[n] +=
+                localized_acceleration(dof);
+              m_body->get_particles()[id]->x[n] =
+                m_body->get_cur_particles()[id]->x[n];
+              m_body->get_particles()[id]->v[n] =
+                m_body->get_cur_particles()[id]->v[n];
+              m_body->get_particles()[id]->a[n] =
+                m_body->get_cur_particles()[id]->a[n];
             }
         }
       fs::path local_path = fs::current_path();
@@ -466,17 +672,30 @@ namespace Solid
       AssertThrow(checkpoint_file != local_path,
                   ExcMessage("Could not find restart files for stress!"));
       // set time step load the checkpoint file
-      Vector<double> stress(m_body->get_num_quad_points() * (dim * dim + 1));
+      // The stresses are stored in the order of the active cells
+      const unsigned int n_q_points = volume_quad_formula.size();
+      const unsigned int n_stress = dim * dim + 1;
+      Vector<double> stress(triangulation.n_active_cells() * n_q_points *
+                            n_stress);
       std::ifstream fs_stress(checkpoint_file);
       stress.block_read(fs_stress);
-      unsigned int iter = 0;
-      for (unsigned int i = 0; i < m_body->get_num_quad_points(); ++i)
+      unsigned int quad_point_id = 0;
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
         {
-          for (unsigned int r = 0; r < dim; ++r)
-            for (unsigned int c = 0; c < dim; ++c)
-              m_body->get_quad_points()[i]->S(r, c) = stress[iter++];
-          m_body->get_quad_points()[i]->p = stress[iter++];
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
+          unsigned int iter = cell->active_cell_index() * n_q_points * n_stress;
+          for (unsigned int q = 0; q < n_q_points; ++q, ++quad_point_id)
+            {
+              particle<dim> *qp = m_body->get_quad_points()[quad_point_id];
+              for (unsigned int r = 0; r < dim; ++r)
+                for (unsigned int c = 0; c < dim; ++c)
+                  qp->S(r, c) = stress[iter++];
+              qp->p = stress[iter++];
+            }
         }
+      store_body_state();
       return true;
     }
 
@@ -484,18 +703,27 @@ namespace Solid
     void SharedHypoElasticity<dim>::save_checkpoint(const int output_index)
     {
       SharedSolidSolver<dim>::save_checkpoint(output_index);
-      // Stress at quad points
+      // Stress and pressure at quad points, gathered from the owners
+      Vector<double> localized_state(quad_state);
       if (this_mpi_process == 0)
         {
-          Vector<double> stress(m_body->get_num_quad_points() *
-                                (dim * dim + 1));
-          unsigned int iter = 0;
-          for (unsigned int i = 0; i < m_body->get_num_quad_points(); ++i)
+          const unsigned int n_q_points = volume_quad_formula.size();
+          const unsigned int n_stress = dim * dim + 1;
+          const unsigned int n_quad_state = dim * dim + 2;
+          Vector<double> stress(triangulation.n_active_cells() * n_q_points *
+                                n_stress);
+          for (unsigned int c = 0; c < triangulation.n_active_cells(); ++c)
             {
-              for (unsigned int r = 0; r < dim; ++r)
-                for (unsigned int c = 0; c < dim; ++c)
-                  stress[iter++] = m_body->get_quad_points()[i]->S(r, c);
-              stress[iter++] = m_body->get_quad_points()[i]->p;
+              const unsigned int owned_q =
+                subdomain_wise_cell_index[c] * n_q_points;
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                {
+                  for (unsigned int i = 0; i < n_stress; ++i)
+                    {
+                      stress[(c * n_q_points + q) * n_stress + i] =
+                        localized_state[(owned_q + q) * n_quad_state + i];
+                    }
+                }
             }
           fs::path local_path = fs::current_path();
           std::set<fs::path> checkpoints;
@@ -520,6 +748,92 @@ namespace Solid
         }
     }
 
+    template <int dim>
+    template <typename Function>
+    void SharedHypoElasticity<dim>::for_each_body_state(Function f)
+    {
+      for (auto particles :
+           {m_body->get_particles(), m_body->get_cur_particles()})
+        {
+          for (unsigned int id = 0; id < m_body->get_num_part(); ++id)
+            {
+              particle<dim> *p = particles[id];
+              for (unsigned int n = 0; n < dim; ++n)
+                {
+                  f(p->x[n]);
+                  f(p->v[n]);
+                  f(p->a[n]);
+                  f(p->previous_v[n]);
+                  f(p->v_t[n]);
+                }
+              f(p->rho);
+            }
+        }
+      // The quadrature points are stored cell by cell in the local body
+      const unsigned int n_q_points = volume_quad_formula.size();
+      const unsigned int n_face_q_points = face_quad_formula.size();
+      unsigned int quad_point_id = 0;
+      unsigned int face_quad_point_id = 0;
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (!in_local_body[cell->active_cell_index()])
+            continue;
+          for (unsigned int q = 0; q < n_q_points; ++q, ++quad_point_id)
+            {
+              particle<dim> *qp = m_body->get_quad_points()[quad_point_id];
+              for (unsigned int r = 0; r < dim; ++r)
+                for (unsigned int c = 0; c < dim; ++c)
+                  f(qp->S(r, c));
+              f(qp->p);
+              f(qp->rho);
+            }
+          for (unsigned int face = 0;
+               face < GeometryInfo<dim>::faces_per_cell;
+               ++face)
+            {
+              if (!cell->face(face)->at_boundary())
+                continue;
+              for (unsigned int q = 0; q < n_face_q_points;
+                   ++q, ++face_quad_point_id)
+                {
+                  particle<dim> *qp =
+                    m_body->get_face_quad_points()[face_quad_point_id];
+                  for (unsigned int n = 0; n < dim; ++n)
+                    f(qp->t[n]);
+                }
+            }
+        }
+    }
+
+    template <int dim>
+    void SharedHypoElasticity<dim>::save_state()
+    {
+      SharedSolidSolver<dim>::save_state();
+      saved_body_state.clear();
+      // The body is constructed in the first step
+      if (m_body)
+        {
+          for_each_body_state(
+            [this](const double &value) { saved_body_state.push_back(value); });
+        }
+    }
+
+    template <int dim>
+    void SharedHypoElasticity<dim>::restore_state()
+    {
+      SharedSolidSolver<dim>::restore_state();
+      // Saved before the first step, which constructs the body again
+      if (saved_body_state.empty())
+        {
+          return;
+        }
+      unsigned int i = 0;
+      for_each_body_state(
+        [this, &i](double &value) { value = saved_body_state[i++]; });
+      store_body_state();
+    }
+
     template class SharedHypoElasticity<2>;
     template class SharedHypoElasticity<3>;
   } // namespace MPI
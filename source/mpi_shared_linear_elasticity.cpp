@@ -8,8 +8,10 @@ namespace Solid
 
     template <int dim>
     SharedLinearElasticity<dim>::SharedLinearElasticity(
-      Triangulation<dim> &tria, const Parameters::AllParameters &parameters)
-      : SharedSolidSolver<dim>(tria, parameters)
+      Triangulation<dim> &tria,
+      const Parameters::AllParameters &parameters,
+      MPI_Comm communicator)
+      : SharedSolidSolver<dim>(tria, parameters, communicator)
     {
       material.resize(parameters.n_solid_parts, LinearElasticMaterial<dim>());
       for (unsigned int i = 0; i < parameters.n_solid_parts; ++i)
@@ -311,12 +313,17 @@ namespace Solid
         assemble_system(false);
 
       const double dt = time.get_delta_t();
+      const Utils::NewmarkUpdate newmark(beta, gamma);
 
-      PETScWrappers::MPI::Vector tmp1(locally_owned_dofs, mpi_communicator);
-      PETScWrappers::MPI::Vector tmp2(locally_owned_dofs, mpi_communicator);
-      PETScWrappers::MPI::Vector tmp3(locally_owned_dofs, mpi_communicator);
-      PETScWrappers::MPI::Vector tmp4(locally_owned_dofs, mpi_communicator);
-      PETScWrappers::MPI::Vector tmp5(locally_owned_dofs, mpi_communicator);
+      for (auto vector : {&effective_rhs,
+                          &predicted_displacement,
+                          &stiffness_force,
+                          &predicted_velocity,
+                          &damping_force})
+        {
+          Utils::NewmarkUpdate::reinit(
+            *vector, locally_owned_dofs, mpi_communicator);
+        }
 
       time.increment();
       pcout << std::string(91, '*') << std::endl
@@ -324,43 +331,34 @@ namespace Solid
             << ", at t = " << std::scientific << time.current() << std::endl;
 
       // Modify the RHS
-      tmp1 = system_rhs;
-      tmp2 = previous_displacement;
-      tmp2.add((1 + alpha) * dt,
-               previous_velocity,
-               (0.5 - beta) * dt * dt * (1 + alpha),
-               previous_acceleration);
-      stiffness_matrix.vmult(tmp3, tmp2);
-
-      tmp4 = previous_velocity;
-      tmp4.add((1 + alpha) * (1 - gamma) * dt, previous_acceleration);
-      damping_matrix.vmult(tmp5, tmp4);
-      tmp1 -= tmp3;
-      tmp1 -= tmp5;
-
-      auto state = this->solve(system_matrix, current_acceleration, tmp1);
-
-      // update the current velocity
-      // \f$ v_{n+1} = v_n + (1-\gamma)\Delta{t}a_n + \gamma\Delta{t}a_{n+1}
-      // \f$
-      current_velocity = previous_velocity;
-      current_velocity.add(dt * (1 - gamma),
-                           previous_acceleration,
-                           dt * gamma,
-                           current_acceleration);
-
-      // update the current displacement
-      current_displacement = previous_displacement;
-      current_displacement.add(dt, previous_velocity);
-      current_displacement.add(dt * dt * (0.5 - beta),
-                               previous_acceleration,
-                               dt * dt * beta,
-                               current_acceleration);
-
-      // update the previous values
-      previous_acceleration = current_acceleration;
-      previous_velocity = current_velocity;
-      previous_displacement = current_displacement;
+      Utils::NewmarkUpdate::combine(predicted_displacement,
+                                    previous_displacement,
+                                    (1 + alpha) * dt,
+                                    previous_velocity,
+                                    (0.5 - beta) * dt * dt * (1 + alpha),
+                                    previous_acceleration);
+      stiffness_matrix.vmult(stiffness_force, predicted_displacement);
+
+      Utils::NewmarkUpdate::combine(predicted_velocity,
+                                    previous_velocity,
+                                    (1 + alpha) * (1 - gamma) * dt,
+                                    previous_acceleration);
+      damping_matrix.vmult(damping_force, predicted_velocity);
+      Utils::NewmarkUpdate::combine(
+        effective_rhs, system_rhs, -1, stiffness_force, -1, damping_force);
+
+      auto state =
+        this->solve(system_matrix, current_acceleration, effective_rhs);
+
+      // Update the current velocity and displacement, and store them as the
+      // previous values in the same sweep.
+      newmark.advance(current_acceleration,
+                      current_velocity,
+                      current_displacement,
+                      dt,
+                      previous_acceleration,
+                      previous_velocity,
+                      previous_displacement);
 
       pcout << std::scientific << std::left << " CG iteration: " << std::setw(3)
             << state.first << " CG residual: " << state.second << std::endl;
@@ -377,9 +375,6 @@ namespace Solid
         {
           this->refine_mesh(parameters.global_refinements[1],
                             parameters.global_refinements[1] + 3);
-          tmp1.reinit(locally_owned_dofs, mpi_communicator);
-          tmp2.reinit(locally_owned_dofs, mpi_communicator);
-          tmp3.reinit(locally_owned_dofs, mpi_communicator);
           assemble_system(false);
         }
 
@@ -9,7 +9,8 @@ namespace Solid
     template <int dim, int spacedim>
     SharedSolidSolver<dim, spacedim>::SharedSolidSolver(
       Triangulation<dim, spacedim> &tria,
-      const Parameters::AllParameters &parameters)
+      const Parameters::AllParameters &parameters,
+      MPI_Comm communicator)
       : triangulation(tria),
         parameters(parameters),
         dof_handler(triangulation),
@@ -18,7 +19,7 @@ namespace Solid
         scalar_fe(parameters.solid_degree),
         volume_quad_formula(parameters.solid_degree + 1),
         face_quad_formula(parameters.solid_degree + 1),
-        mpi_communicator(MPI_COMM_WORLD),
+        mpi_communicator(communicator),
         n_mpi_processes(Utilities::MPI::n_mpi_processes(mpi_communicator)),
         this_mpi_process(Utilities::MPI::this_mpi_process(mpi_communicator)),
         pcout(std::cout, (this_mpi_process == 0)),
@@ -27,6 +28,7 @@ namespace Solid
              parameters.output_interval,
              parameters.refinement_interval,
              parameters.save_interval),
+        time_step_controller(parameters),
         timer(
           mpi_communicator, pcout, TimerOutput::never, TimerOutput::wall_times)
     {
@@ -105,6 +107,8 @@ namespace Solid
 
       constraints.close();
 
+      setup_contact_vertices();
+
       pcout << "  Number of active solid cells: "
             << triangulation.n_active_cells() << std::endl
             << "  Number of degrees of freedom: " << dof_handler.n_dofs()
@@ -112,23 +116,231 @@ namespace Solid
     }
 
     template <int dim, int spacedim>
-    void SharedSolidSolver<dim, spacedim>::initialize_system()
+    void SharedSolidSolver<dim, spacedim>::setup_contact_vertices()
     {
-      DynamicSparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs());
+      contact_vertices.clear();
+      // Map from the vertex index to its position in contact_vertices
+      std::vector<int> vertex_to_contact(triangulation.n_vertices(), -1);
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+            {
+              if (!cell->face(f)->at_boundary())
+                continue;
+              const double area = cell->face(f)->measure() /
+                                  GeometryInfo<dim>::vertices_per_face;
+              for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_face;
+                   ++v)
+                {
+                  // Every vertex is handled by the process owning its dofs
+                  if (!locally_owned_dofs.is_element(
+                        cell->face(f)->vertex_dof_index(v, 0)))
+                    continue;
+                  const unsigned int index = cell->face(f)->vertex_index(v);
+                  if (vertex_to_contact[index] < 0)
+                    {
+                      vertex_to_contact[index] = contact_vertices.size();
+                      ContactVertex contact_vertex;
+                      contact_vertex.vertex = index;
+                      for (unsigned int d = 0; d < spacedim; ++d)
+                        {
+                          contact_vertex.dofs.push_back(
+                            cell->face(f)->vertex_dof_index(v, d));
+                        }
+                      contact_vertex.area = 0;
+                      contact_vertex.multiplier = 0;
+                      contact_vertices.push_back(contact_vertex);
+                    }
+                  contact_vertices[vertex_to_contact[index]].area += area;
+                }
+            }
+        }
+    }
 
-      DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+    template <int dim, int spacedim>
+    void SharedSolidSolver<dim, spacedim>::transfer_contact_multipliers(
+      const std::vector<Point<spacedim>> &old_vertices,
+      const std::vector<bool> &old_used_vertices,
+      const std::vector<double> &contact_pressure)
+    {
+      std::vector<int> vertex_to_contact(triangulation.n_vertices(), -1);
+      for (unsigned int i = 0; i < contact_vertices.size(); ++i)
+        {
+          vertex_to_contact[contact_vertices[i].vertex] = i;
+        }
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+            {
+              if (!cell->face(f)->at_boundary())
+                continue;
+              for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_face;
+                   ++v)
+                {
+                  const int i =
+                    vertex_to_contact[cell->face(f)->vertex_index(v)];
+                  if (i < 0)
+                    continue;
+                  auto &contact_vertex = contact_vertices[i];
+                  const unsigned int index = contact_vertex.vertex;
+                  const Point<spacedim> &vertex = cell->face(f)->vertex(v);
+                  double pressure = 0;
+                  if (index < old_vertices.size() && old_used_vertices[index] &&
+                      old_vertices[index] == vertex)
+                    {
+                      // The vertex was there before
+                      pressure = contact_pressure[index];
+                    }
+                  else
+                    {
+                      // A new vertex of a refined face, which lies on the
+                      // same face of the parent cell
+                      const auto parent_face = cell->parent()->face(f);
+                      for (unsigned int w = 0;
+                           w < GeometryInfo<dim>::vertices_per_face;
+                           ++w)
+                        {
+                          pressure +=
+                            contact_pressure[parent_face->vertex_index(w)] /
+                            GeometryInfo<dim>::vertices_per_face;
+                        }
+                    }
+                  contact_vertex.multiplier = pressure * contact_vertex.area;
+                }
+            }
+        }
+    }
+
+    template <int dim, int spacedim>
+    void SharedSolidSolver<dim, spacedim>::setup_reference_cache()
+    {
+      reference_cache = ReferenceCache();
+      if (!parameters.cache_reference_gradients)
+        return;
+
+      const unsigned int n_q_points = volume_quad_formula.size();
+      const unsigned int dofs_per_cell = fe.dofs_per_cell;
+      reference_cache.n_q_points = n_q_points;
+      reference_cache.dofs_per_cell = dofs_per_cell;
+      reference_cache.cell_index.resize(triangulation.n_active_cells(),
+                                        numbers::invalid_unsigned_int);
+      unsigned int n_owned_cells = 0;
+      for (auto cell = triangulation.begin_active();
+           cell != triangulation.end();
+           ++cell)
+        {
+          if (cell->subdomain_id() == this_mpi_process)
+            {
+              reference_cache.cell_index[cell->active_cell_index()] =
+                n_owned_cells++;
+            }
+        }
+
+      reference_cache.shape_component.resize(dofs_per_cell);
+      for (unsigned int k = 0; k < dofs_per_cell; ++k)
+        {
+          reference_cache.shape_component[k] =
+            fe.system_to_component_index(k).first;
+        }
+      reference_cache.shape_values.resize(n_q_points * dofs_per_cell);
+      reference_cache.shape_gradients.resize(std::size_t(n_owned_cells) *
+                                             n_q_points * spacedim *
+                                             dofs_per_cell);
+      reference_cache.JxW.resize(std::size_t(n_owned_cells) * n_q_points);
+
+      FEValues<dim, spacedim> fe_values(fe,
+                                        volume_quad_formula,
+                                        update_values | update_gradients |
+                                          update_JxW_values);
+      // The shape values do not depend on the geometry
+      fe_values.reinit(dof_handler.begin_active());
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          for (unsigned int k = 0; k < dofs_per_cell; ++k)
+            {
+              reference_cache.shape_values[q * dofs_per_cell + k] =
+                fe_values.shape_value(k, q);
+            }
+        }
+
+      auto g = reference_cache.shape_gradients.begin();
+      auto JxW = reference_cache.JxW.begin();
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+           ++cell)
+        {
+          if (cell->subdomain_id() != this_mpi_process)
+            continue;
+          fe_values.reinit(cell);
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              *JxW++ = fe_values.JxW(q);
+              for (unsigned int d = 0; d < spacedim; ++d)
+                {
+                  for (unsigned int k = 0; k < dofs_per_cell; ++k)
+                    {
+                      *g++ = fe_values.shape_grad(k, q)[d];
+                    }
+                }
+            }
+        }
 
-      system_matrix.reinit(
-        locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
+      pcout << "  Reference shape gradient cache: "
+            << Utilities::MPI::sum(
+                 double(reference_cache.memory_consumption()),
+                 mpi_communicator) /
+                 1048576.0
+            << " MB" << std::endl;
+    }
+
+    template <int dim, int spacedim>
+    std::size_t
+    SharedSolidSolver<dim, spacedim>::ReferenceCache::memory_consumption()
+      const
+    {
+      return MemoryConsumption::memory_consumption(cell_index) +
+             MemoryConsumption::memory_consumption(shape_component) +
+             MemoryConsumption::memory_consumption(shape_values) +
+             MemoryConsumption::memory_consumption(shape_gradients) +
+             MemoryConsumption::memory_consumption(JxW);
+    }
 
-      mass_matrix.reinit(
-        locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
+    template <int dim, int spacedim>
+    void SharedSolidSolver<dim, spacedim>::initialize_system()
+    {
+      DynamicSparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs());
 
-      stiffness_matrix.reinit(
-        locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
+      DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
 
-      damping_matrix.reinit(
-        locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
+      for (auto matrix :
+           {&system_matrix, &mass_matrix, &stiffness_matrix, &damping_matrix})
+        {
+          if (parameters.solid_symmetric_storage)
+            {
+              // One block per support point, whose spacedim components are
+              // numbered together
+              SymmetricStorage::reinit(*matrix,
+                                       locally_owned_dofs,
+                                       dsp,
+                                       mpi_communicator,
+                                       fe.n_components());
+            }
+          else
+            {
+              matrix->reinit(
+                locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
+            }
+        }
+      pcout << "  Solid matrix memory: "
+            << Utilities::MPI::sum(
+                 double(system_matrix.memory_consumption() +
+                        mass_matrix.memory_consumption() +
+                        stiffness_matrix.memory_consumption() +
+                        damping_matrix.memory_consumption()),
+                 mpi_communicator) /
+                 1048576.0
+            << " MB" << std::endl;
 
       system_rhs.reinit(locally_owned_dofs, mpi_communicator);
 
@@ -172,7 +384,8 @@ namespace Solid
         }
     }
 
-    // Solve linear system \f$Ax = b\f$ using CG solver.
+    // Solve linear system \f$Ax = b\f$ using CG solver, or FGMRES with the
+    // mixed precision preconditioner.
     template <int dim, int spacedim>
     std::pair<unsigned int, double> SharedSolidSolver<dim, spacedim>::solve(
       const PETScWrappers::MPI::SparseMatrix &A,
@@ -184,11 +397,24 @@ namespace Solid
       SolverControl solver_control(dof_handler.n_dofs() * 2,
                                    1e-8 * b.l2_norm());
 
-      PETScWrappers::SolverCG cg(solver_control, mpi_communicator);
+      if (parameters.solid_mixed_precision)
+        {
+          // The single precision preconditioner only works with the deal.II
+          // solvers. ILU and its rounding to float are not symmetric, which
+          // CG relies on, so a flexible Krylov method is used.
+          PreconditionMixedPrecision preconditioner;
+          preconditioner.initialize(A);
+          SolverFGMRES<PETScWrappers::MPI::Vector> fgmres(solver_control);
+          fgmres.solve(A, x, b, preconditioner);
+        }
+      else
+        {
+          PETScWrappers::SolverCG cg(solver_control, mpi_communicator);
 
-      PETScWrappers::PreconditionNone preconditioner(A);
+          PETScWrappers::PreconditionNone preconditioner(A);
 
-      cg.solve(A, x, b, preconditioner);
+          cg.solve(A, x, b, preconditioner);
+        }
 
       Vector<double> localized_x(x);
       constraints.distribute(localized_x);
@@ -380,12 +606,29 @@ namespace Solid
           trans[i].prepare_for_coarsening_and_refinement(buffers[i]);
         }
 
+      // The contact pressures of all the vertices, since the vertices change
+      // their owners
+      std::vector<double> contact_pressure(triangulation.n_vertices(), 0);
+      for (const auto &contact_vertex : contact_vertices)
+        {
+          contact_pressure[contact_vertex.vertex] =
+            contact_vertex.multiplier / contact_vertex.area;
+        }
+      contact_pressure =
+        Utilities::MPI::sum(contact_pressure, mpi_communicator);
+      const std::vector<Point<spacedim>> old_vertices =
+        triangulation.get_vertices();
+      const std::vector<bool> old_used_vertices =
+        triangulation.get_used_vertices();
+
       // Refine the mesh
       triangulation.execute_coarsening_and_refinement();
 
-      // Reinitialize the system
+      // Reinitialize the system, which builds the new contact vertices
       setup_dofs();
       initialize_system();
+      transfer_contact_multipliers(
+        old_vertices, old_used_vertices, contact_pressure);
 
       // Transfer the previous solutions and handle the constraints
       trans[0].interpolate(previous_displacement);
@@ -427,6 +670,16 @@ namespace Solid
       return current_displacement;
     }
 
+    template <int dim, int spacedim>
+    void SharedSolidSolver<dim, spacedim>::set_penetration_criterion(
+      const std::function<double(const Point<spacedim> &)> &criterion,
+      Tensor<1, spacedim> direction)
+    {
+      penetration_criterion.reset(
+        new std::function<double(const Point<spacedim> &)>(criterion));
+      penetration_direction = direction;
+    }
+
     template <int dim, int spacedim>
     void
     SharedSolidSolver<dim, spacedim>::save_checkpoint(const int output_index)
@@ -460,6 +713,8 @@ namespace Solid
               fs::remove(to_be_removed);
               to_be_removed.replace_extension(".solid_checkpoint_acceleration");
               fs::remove(to_be_removed);
+              to_be_removed.replace_extension(".solid_checkpoint_time");
+              fs::remove(to_be_removed);
               checkpoints.erase(checkpoints.begin());
             }
           // Name the checkpoint file
@@ -477,6 +732,8 @@ namespace Solid
           localized_disp.block_write(disp);
           localized_vel.block_write(vel);
           localized_acc.block_write(acc);
+          checkpoint_file.replace_extension(".solid_checkpoint_time");
+          time.save(checkpoint_file.string(), times_and_names);
         }
 
       pcout << "Checkpoint file successfully saved at time step "
@@ -529,24 +786,35 @@ namespace Solid
       previous_displacement = current_displacement;
       previous_velocity = current_velocity;
       previous_acceleration = current_acceleration;
-      // Update the time and names to set the current time and write
-      // correct .pvd file.
-
-      for (int i = 0; i <= Utilities::string_to_int(checkpoint_file.stem());
-           ++i)
+      // Restore the time and the names to write the correct .pvd file.
+      checkpoint_file.replace_extension(".solid_checkpoint_time");
+      if (fs::exists(checkpoint_file))
         {
-          if ((time.current() == 0 || time.time_to_output()) &&
-              Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+          time.load(checkpoint_file.string(), times_and_names);
+        }
+      else
+        {
+          // Older checkpoints only have the number of the time step, from
+          // which the time is rebuilt with the current step size.
+          AssertThrow(!parameters.adaptive_time_stepping,
+                      ExcMessage("The checkpoint has no time to restart "
+                                 "with adaptive time steps!"));
+          for (int i = 0; i <= Utilities::string_to_int(checkpoint_file.stem());
+               ++i)
             {
-              std::string basename =
-                "solid-" + Utilities::int_to_string(time.get_timestep(), 6);
-              std::string filename = basename + ".vtu";
+              if ((time.current() == 0 || time.time_to_output()) &&
+                  Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+                {
+                  std::string basename =
+                    "solid-" + Utilities::int_to_string(time.get_timestep(), 6);
+                  std::string filename = basename + ".vtu";
 
-              times_and_names.push_back({time.current(), filename});
+                  times_and_names.push_back({time.current(), filename});
+                }
+              if (i == Utilities::string_to_int(checkpoint_file.stem()))
+                break;
+              time.increment();
             }
-          if (i == Utilities::string_to_int(checkpoint_file.stem()))
-            break;
-          time.increment();
         }
 
       pcout << "Checkpoint file successfully loaded from time step "
@@ -554,6 +822,45 @@ namespace Solid
       return true;
     }
 
+    template <int dim, int spacedim>
+    void SharedSolidSolver<dim, spacedim>::save_state()
+    {
+      saved_solutions = {current_displacement,
+                         current_velocity,
+                         current_acceleration,
+                         previous_displacement,
+                         previous_velocity,
+                         previous_acceleration};
+      saved_contact_multipliers.resize(contact_vertices.size());
+      for (unsigned int i = 0; i < contact_vertices.size(); ++i)
+        {
+          saved_contact_multipliers[i] = contact_vertices[i].multiplier;
+        }
+      saved_time = time.get_state();
+      n_saved_outputs = times_and_names.size();
+    }
+
+    template <int dim, int spacedim>
+    void SharedSolidSolver<dim, spacedim>::restore_state()
+    {
+      AssertThrow(saved_solutions.size() == 6 &&
+                    saved_contact_multipliers.size() ==
+                      contact_vertices.size(),
+                  ExcMessage("No state of this mesh was saved!"));
+      current_displacement = saved_solutions[0];
+      current_velocity = saved_solutions[1];
+      current_acceleration = saved_solutions[2];
+      previous_displacement = saved_solutions[3];
+      previous_velocity = saved_solutions[4];
+      previous_acceleration = saved_solutions[5];
+      for (unsigned int i = 0; i < contact_vertices.size(); ++i)
+        {
+          contact_vertices[i].multiplier = saved_contact_multipliers[i];
+        }
+      time.set_state(saved_time);
+      times_and_names.resize(n_saved_outputs);
+    }
+
     template class SharedSolidSolver<2>;
     template class SharedSolidSolver<3>;
     template class SharedSolidSolver<2, 3>;
@@ -45,7 +45,12 @@ namespace Solid
       TimerOutput::Scope timer_section(timer, "Setup system");
 
       dof_handler.distribute_dofs(fe);
-      DoFRenumbering::Cuthill_McKee(dof_handler);
+      // Cuthill-McKee separates the components of a support point, which the
+      // blocks of the symmetric storage keep together
+      if (!parameters.solid_symmetric_storage)
+        {
+          DoFRenumbering::Cuthill_McKee(dof_handler);
+        }
       dg_dof_handler.distribute_dofs(dg_fe);
 
       // Extract the locally owned and relevant dofs
@@ -114,14 +119,27 @@ namespace Solid
         mpi_communicator,
         locally_relevant_dofs);
 
-      system_matrix.reinit(
-        locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
-
-      mass_matrix.reinit(
-        locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
-
-      stiffness_matrix.reinit(
-        locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
+      for (auto matrix : {&system_matrix, &mass_matrix, &stiffness_matrix})
+        {
+          if (parameters.solid_symmetric_storage)
+            {
+              SymmetricStorage::reinit(
+                *matrix, locally_owned_dofs, dsp, mpi_communicator, dim);
+            }
+          else
+            {
+              matrix->reinit(
+                locally_owned_dofs, locally_owned_dofs, dsp, mpi_communicator);
+            }
+        }
+      pcout << "  Solid matrix memory: "
+            << Utilities::MPI::sum(
+                 double(system_matrix.memory_consumption() +
+                        mass_matrix.memory_consumption() +
+                        stiffness_matrix.memory_consumption()),
+                 mpi_communicator) /
+                 1048576.0
+            << " MB" << std::endl;
 
       system_rhs.reinit(locally_owned_dofs, mpi_communicator);
 
@@ -152,6 +170,10 @@ namespace Solid
       PETScWrappers::SolverCG cg(solver_control, mpi_communicator);
 
       PETScWrappers::PreconditionBlockJacobi preconditioner(A);
+      if (SymmetricStorage::is_symmetric(A))
+        {
+          SymmetricStorage::use_cholesky_blocks(preconditioner);
+        }
 
       cg.solve(A, x, b, preconditioner);
       constraints.distribute(x);
@@ -34,6 +34,26 @@ namespace Parameters
         "",
         Patterns::List(dealii::Patterns::Double()),
         "Gravity acceleration that applies to both fluid and solid");
+      prm.declare_entry("Solid processes",
+                        "0",
+                        Patterns::Integer(0),
+                        "Number of processes that only run the solid in FSI, "
+                        "0 to run both solvers on all the processes");
+      prm.declare_entry("Pipelined coupling",
+                        "0",
+                        Patterns::Integer(0, 1),
+                        "Overlap the solid step with the fluid step of the "
+                        "previous time level in FSI");
+      prm.declare_entry("Fluid steps per solid step",
+                        "1",
+                        Patterns::Integer(1),
+                        "Number of fluid time steps in one solid time step "
+                        "in FSI");
+      prm.declare_entry("Solid steps per fluid step",
+                        "1",
+                        Patterns::Integer(1),
+                        "Number of solid time steps in one fluid time step "
+                        "in FSI");
     }
     prm.leave_subsection();
   }
@@ -60,6 +80,127 @@ namespace Parameters
       gravity = Utilities::string_to_double(parsed_input);
       AssertThrow(static_cast<int>(gravity.size()) == dimension,
                   ExcMessage("Inconsistent dimension of gravity!"));
+      solid_processes = prm.get_integer("Solid processes");
+      pipelined_coupling = prm.get_integer("Pipelined coupling");
+      AssertThrow(!pipelined_coupling || solid_processes > 0,
+                  ExcMessage("Pipelined coupling requires solid processes!"));
+      fluid_steps_per_solid_step =
+        prm.get_integer("Fluid steps per solid step");
+      solid_steps_per_fluid_step =
+        prm.get_integer("Solid steps per fluid step");
+      AssertThrow(fluid_steps_per_solid_step == 1 ||
+                    solid_steps_per_fluid_step == 1,
+                  ExcMessage("Only one of the solvers can subcycle!"));
+      AssertThrow(!pipelined_coupling || fluid_steps_per_solid_step == 1,
+                  ExcMessage("Pipelined coupling requires the solid to take "
+                             "the fluid time step!"));
+    }
+    prm.leave_subsection();
+  }
+
+  void TimeStepping::declareParameters(ParameterHandler &prm)
+  {
+    prm.enter_subsection("Time stepping");
+    {
+      prm.declare_entry("Adaptive time stepping",
+                        "0",
+                        Patterns::Integer(0, 1),
+                        "Adapt the time step size during the simulation");
+      prm.declare_entry("Minimum time step size",
+                        "1e-10",
+                        Patterns::Double(0.0),
+                        "Lower bound of the adaptive time step size");
+      prm.declare_entry("Maximum time step size",
+                        "1.0",
+                        Patterns::Double(0.0),
+                        "Upper bound of the adaptive time step size");
+      prm.declare_entry("Time step growth factor",
+                        "2.0",
+                        Patterns::Double(1.0),
+                        "Max ratio of two consecutive time step sizes");
+      prm.declare_entry("Time step reduction factor",
+                        "0.25",
+                        Patterns::Double(0.0, 1.0),
+                        "Min ratio of two consecutive time step sizes");
+      prm.declare_entry(
+        "CFL number", "0.5", Patterns::Double(0.0), "Target CFL number");
+      prm.declare_entry("Truncation error tolerance",
+                        "1e-3",
+                        Patterns::Double(0.0),
+                        "Relative local truncation error per time step");
+      prm.declare_entry("Target nonlinear iterations",
+                        "5",
+                        Patterns::Integer(1),
+                        "Number of nonlinear iterations per time step to "
+                        "aim at");
+      prm.declare_entry("Local time step levels",
+                        "1",
+                        Patterns::Integer(1, 16),
+                        "Number of power-of-two time step levels of the "
+                        "explicit fluid solver, 1 for a global time step");
+    }
+    prm.leave_subsection();
+  }
+
+  void TimeStepping::parseParameters(ParameterHandler &prm)
+  {
+    prm.enter_subsection("Time stepping");
+    {
+      adaptive_time_stepping = prm.get_integer("Adaptive time stepping");
+      min_time_step = prm.get_double("Minimum time step size");
+      max_time_step = prm.get_double("Maximum time step size");
+      AssertThrow(min_time_step <= max_time_step,
+                  ExcMessage("Minimum time step size exceeds the maximum!"));
+      time_step_growth = prm.get_double("Time step growth factor");
+      time_step_reduction = prm.get_double("Time step reduction factor");
+      cfl_number = prm.get_double("CFL number");
+      truncation_error_tolerance = prm.get_double("Truncation error tolerance");
+      target_nonlinear_iterations =
+        prm.get_integer("Target nonlinear iterations");
+      local_time_step_levels = prm.get_integer("Local time step levels");
+    }
+    prm.leave_subsection();
+  }
+
+  void FSICoupling::declareParameters(ParameterHandler &prm)
+  {
+    prm.enter_subsection("FSI coupling");
+    {
+      prm.declare_entry("Coupling iterations",
+                        "1",
+                        Patterns::Integer(1),
+                        "Max number of coupling iterations per time step, "
+                        "1 for explicit coupling");
+      prm.declare_entry("Coupling tolerance",
+                        "1e-4",
+                        Patterns::Double(0.0),
+                        "Relative residual of the fluid traction");
+      prm.declare_entry("Coupling acceleration",
+                        "IQN-ILS",
+                        Patterns::Selection("IQN-ILS|Aitken|Constant"),
+                        "Acceleration of the coupling iterations");
+      prm.declare_entry("Initial relaxation factor",
+                        "0.5",
+                        Patterns::Double(0.0, 1.0),
+                        "Relaxation factor of the first coupling iteration");
+      prm.declare_entry("Reused time steps",
+                        "8",
+                        Patterns::Integer(0),
+                        "Number of previous time steps whose secant "
+                        "information is reused by IQN-ILS");
+    }
+    prm.leave_subsection();
+  }
+
+  void FSICoupling::parseParameters(ParameterHandler &prm)
+  {
+    prm.enter_subsection("FSI coupling");
+    {
+      max_coupling_iterations = prm.get_integer("Coupling iterations");
+      coupling_tolerance = prm.get_double("Coupling tolerance");
+      coupling_acceleration = prm.get("Coupling acceleration");
+      initial_relaxation = prm.get_double("Initial relaxation factor");
+      reused_time_steps = prm.get_integer("Reused time steps");
     }
     prm.leave_subsection();
   }
@@ -131,6 +272,72 @@ namespace Parameters
         "1e-10",
         Patterns::Double(0.0),
         "The absolute tolerance of the nonlinear system residual");
+      prm.declare_entry("Nonlinear solver",
+                        "Newton",
+                        Patterns::Selection("Newton|Modified Newton|JFNK"),
+                        "The nonlinear solver of the implicit slightly "
+                        "compressible solver");
+      prm.declare_entry("Jacobian refresh interval",
+                        "10",
+                        Patterns::Integer(1),
+                        "Number of Newton iterations the Jacobian is reused "
+                        "in modified Newton and JFNK");
+      prm.declare_entry("Jacobian refresh ratio",
+                        "0.5",
+                        Patterns::Double(0.0),
+                        "Update the Jacobian if the residual decreases slower "
+                        "than this ratio in modified Newton and JFNK");
+      prm.declare_entry("Mixed precision preconditioner",
+                        "0",
+                        Patterns::Integer(0, 1),
+                        "Store the ILU(0) factors of the implicit slightly "
+                        "compressible solver in single precision");
+      prm.declare_entry("Linear solver",
+                        "Block preconditioner",
+                        Patterns::Selection("Block preconditioner|Field split"),
+                        "Precondition the implicit fluid solvers with the "
+                        "built-in block preconditioners or PETSc PCFIELDSPLIT");
+      prm.declare_entry("Field split type",
+                        "Schur",
+                        Patterns::Selection("Schur|Multiplicative|Additive"),
+                        "How PCFIELDSPLIT combines the velocity and pressure "
+                        "splits");
+      prm.declare_entry("PETSc options",
+                        "",
+                        Patterns::Anything(),
+                        "PETSc options of the field split solver, with the "
+                        "prefix -fluid_");
+      prm.declare_entry("ILU preconditioner",
+                        "Euclid",
+                        Patterns::Selection("Euclid|PILUT"),
+                        "The Hypre ILU preconditioner of the implicit slightly "
+                        "compressible solver");
+      prm.declare_entry("Euclid fill levels",
+                        "0",
+                        Patterns::Integer(0),
+                        "Number of levels of fill of Euclid ILU(k)");
+      prm.declare_entry("Euclid block Jacobi",
+                        "0",
+                        Patterns::Integer(0, 1),
+                        "Use block Jacobi ILU(k) instead of parallel ILU(k)");
+      prm.declare_entry("PILUT max iterations",
+                        "20",
+                        Patterns::Integer(1),
+                        "Maximum number of PILUT iterations");
+      prm.declare_entry("PILUT factor row size",
+                        "20",
+                        Patterns::Integer(1),
+                        "Maximum number of nonzeros per row of the PILUT "
+                        "factors");
+      prm.declare_entry("PILUT drop tolerance",
+                        "1e-4",
+                        Patterns::Double(0.0),
+                        "Drop tolerance of PILUT");
+      prm.declare_entry("ILU autotuning",
+                        "0",
+                        Patterns::Integer(0, 1),
+                        "Try a few ILU settings in the first time steps and "
+                        "keep the fastest one");
     }
     prm.leave_subsection();
   }
@@ -142,6 +349,21 @@ namespace Parameters
       grad_div = prm.get_double("Grad-Div stabilization");
       fluid_max_iterations = prm.get_integer("Max Newton iterations");
       fluid_tolerance = prm.get_double("Nonlinear system tolerance");
+      fluid_nonlinear_solver = prm.get("Nonlinear solver");
+      jacobian_refresh_interval = prm.get_integer("Jacobian refresh interval");
+      jacobian_refresh_ratio = prm.get_double("Jacobian refresh ratio");
+      fluid_mixed_precision =
+        prm.get_integer("Mixed precision preconditioner");
+      fluid_linear_solver = prm.get("Linear solver");
+      field_split_type = prm.get("Field split type");
+      fluid_petsc_options = prm.get("PETSc options");
+      ilu_type = prm.get("ILU preconditioner");
+      euclid_levels = prm.get_integer("Euclid fill levels");
+      euclid_block_jacobi = prm.get_integer("Euclid block Jacobi");
+      pilut_max_iterations = prm.get_integer("PILUT max iterations");
+      pilut_factor_row_size = prm.get_integer("PILUT factor row size");
+      pilut_tolerance = prm.get_double("PILUT drop tolerance");
+      ilu_autotuning = prm.get_integer("ILU autotuning");
     }
     prm.leave_subsection();
   }
@@ -412,6 +634,50 @@ namespace Parameters
         "1e8",
         Patterns::Double(0.0),
         "Multiplier of the penetration distance to compute contact force.");
+      prm.declare_entry("Contact penalty",
+                        "1e10",
+                        Patterns::Double(0.0),
+                        "Contact force per unit boundary area and unit "
+                        "penetration of the hyperelastic solver");
+      prm.declare_entry("Nonlinear solver",
+                        "Newton",
+                        Patterns::Selection("Newton|Modified Newton|LBFGS"),
+                        "The nonlinear solver of the hyperelastic solver");
+      prm.declare_entry(
+        "Tangent refresh interval",
+        "5",
+        Patterns::Integer(1),
+        "Number of iterations the tangent is reused in modified Newton");
+      prm.declare_entry("Tangent refresh ratio",
+                        "0.5",
+                        Patterns::Double(0.0),
+                        "Update the tangent if the residual decreases slower "
+                        "than this ratio in modified Newton");
+      prm.declare_entry("LBFGS history",
+                        "5",
+                        Patterns::Integer(1),
+                        "Number of correction pairs stored by L-BFGS");
+      prm.declare_entry("Critical time step fraction",
+                        "0.9",
+                        Patterns::Double(0.0, 1.0),
+                        "Fraction of the estimated critical time step used "
+                        "by the explicit solid solver");
+      prm.declare_entry("Cache reference shape gradients",
+                        "1",
+                        Patterns::Integer(0, 1),
+                        "Store the shape function gradients and JxW values "
+                        "in the reference configuration for the hyperelastic "
+                        "solvers instead of recomputing them");
+      prm.declare_entry("Mixed precision preconditioner",
+                        "0",
+                        Patterns::Integer(0, 1),
+                        "Precondition the linear solver of the shared solid "
+                        "solvers with single precision ILU(0) factors");
+      prm.declare_entry("Symmetric matrix storage",
+                        "0",
+                        Patterns::Integer(0, 1),
+                        "Store only the upper triangle of the matrices of the "
+                        "parallel solid solvers (PETSc SBAIJ)");
     }
     prm.leave_subsection();
   }
@@ -425,6 +691,17 @@ namespace Parameters
       tol_d = prm.get_double("Displacement tolerance");
       tol_f = prm.get_double("Force tolerance");
       contact_force_multiplier = prm.get_double("Contact force multiplier");
+      contact_penalty = prm.get_double("Contact penalty");
+      nonlinear_solver = prm.get("Nonlinear solver");
+      tangent_refresh_interval = prm.get_integer("Tangent refresh interval");
+      tangent_refresh_ratio = prm.get_double("Tangent refresh ratio");
+      lbfgs_history = prm.get_integer("LBFGS history");
+      critical_time_step_fraction =
+        prm.get_double("Critical time step fraction");
+      cache_reference_gradients =
+        prm.get_integer("Cache reference shape gradients");
+      solid_mixed_precision = prm.get_integer("Mixed precision preconditioner");
+      solid_symmetric_storage = prm.get_integer("Symmetric matrix storage");
     }
     prm.leave_subsection();
   }
@@ -543,6 +820,8 @@ namespace Parameters
   void AllParameters::declareParameters(ParameterHandler &prm)
   {
     Simulation::declareParameters(prm);
+    TimeStepping::declareParameters(prm);
+    FSICoupling::declareParameters(prm);
     FluidFESystem::declareParameters(prm);
     FluidMaterial::declareParameters(prm);
     FluidSolver::declareParameters(prm);
@@ -558,6 +837,8 @@ namespace Parameters
   void AllParameters::parseParameters(ParameterHandler &prm)
   {
     Simulation::parseParameters(prm);
+    TimeStepping::parseParameters(prm);
+    FSICoupling::parseParameters(prm);
     FluidFESystem::parseParameters(prm);
     FluidMaterial::parseParameters(prm);
     FluidSolver::parseParameters(prm);
@@ -0,0 +1,109 @@
+#include "preconditioner_mixed_precision.h"
+
+PreconditionMixedPrecision::AdditionalData::AdditionalData(
+  const double strengthen_diagonal)
+  : strengthen_diagonal(strengthen_diagonal)
+{
+}
+
+void PreconditionMixedPrecision::initialize(
+  const PETScWrappers::MatrixBase &matrix,
+  const AdditionalData &additional_data)
+{
+  const auto range = matrix.local_range();
+  const unsigned int n_rows = range.second - range.first;
+
+  // The rows of a symmetric matrix only hold the upper triangle, the lower
+  // one is mirrored.
+  const bool upper_only = SymmetricStorage::is_symmetric(matrix);
+  PetscErrorCode ierr;
+  if (upper_only)
+    {
+      ierr = MatGetRowUpperTriangular(matrix);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+
+  // Only the couplings within the locally owned rows are kept, which makes
+  // the factorization block Jacobi across the processes. The diagonal is
+  // always in the pattern because ILU needs it.
+  DynamicSparsityPattern dsp(n_rows, n_rows);
+  for (auto r = range.first; r < range.second; ++r)
+    {
+      dsp.add(r - range.first, r - range.first);
+      for (auto entry = matrix.begin(r); entry != matrix.end(r); ++entry)
+        {
+          if (entry->column() >= range.first && entry->column() < range.second)
+            {
+              dsp.add(r - range.first, entry->column() - range.first);
+              if (upper_only)
+                {
+                  dsp.add(entry->column() - range.first, r - range.first);
+                }
+            }
+        }
+    }
+  sparsity_pattern.copy_from(dsp);
+
+  // The double precision block only lives until it is factorized
+  SparseMatrix<double> local_matrix(sparsity_pattern);
+  for (auto r = range.first; r < range.second; ++r)
+    {
+      for (auto entry = matrix.begin(r); entry != matrix.end(r); ++entry)
+        {
+          if (entry->column() >= range.first && entry->column() < range.second)
+            {
+              local_matrix.set(r - range.first,
+                               entry->column() - range.first,
+                               entry->value());
+              if (upper_only)
+                {
+                  local_matrix.set(entry->column() - range.first,
+                                   r - range.first,
+                                   entry->value());
+                }
+            }
+        }
+    }
+  if (upper_only)
+    {
+      ierr = MatRestoreRowUpperTriangular(matrix);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+  ilu.initialize(
+    local_matrix,
+    SparseILU<float>::AdditionalData(additional_data.strengthen_diagonal));
+
+  src_buffer.reinit(n_rows);
+  dst_buffer.reinit(n_rows);
+}
+
+void PreconditionMixedPrecision::vmult(
+  PETScWrappers::VectorBase &dst, const PETScWrappers::VectorBase &src) const
+{
+  AssertThrow(src.local_size() == src_buffer.size() &&
+                dst.local_size() == dst_buffer.size(),
+              ExcMessage("Vector layout does not match the preconditioner!"));
+
+  // Round the local part to single precision
+  const PetscScalar *src_array;
+  PetscErrorCode ierr = VecGetArrayRead(src, &src_array);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  std::copy(src_array, src_array + src_buffer.size(), src_buffer.begin());
+  ierr = VecRestoreArrayRead(src, &src_array);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+  ilu.vmult(dst_buffer, src_buffer);
+
+  PetscScalar *dst_array;
+  ierr = VecGetArray(dst, &dst_array);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+  std::copy(dst_buffer.begin(), dst_buffer.end(), dst_array);
+  ierr = VecRestoreArray(dst, &dst_array);
+  AssertThrow(ierr == 0, ExcPETScError(ierr));
+}
+
+std::size_t PreconditionMixedPrecision::memory_consumption() const
+{
+  return sparsity_pattern.memory_consumption() + ilu.memory_consumption() +
+         src_buffer.memory_consumption() + dst_buffer.memory_consumption();
+}
@@ -1,4 +1,5 @@
 #include "preconditioner_pilut.h"
+#include <algorithm>
 #include <_hypre_parcsr_ls.h>
 #include <petsc/private/pcimpl.h> /*I "petscpc.h" I*/
 /* this include is needed ONLY to allow access to the private data inside the
@@ -196,16 +197,25 @@ void PreconditionPilut::initialize(const PETScWrappers::MatrixBase &matrix_,
 
 /* ----------------- PreconditionEuclid ------------------------ */
 
-PreconditionEuclid::PreconditionEuclid(const PETScWrappers::MatrixBase &matrix)
+PreconditionEuclid::AdditionalData::AdditionalData(const unsigned int levels,
+                                                   const bool block_jacobi)
+  : levels(levels), block_jacobi(block_jacobi)
 {
-  initialize(matrix);
 }
 
-void PreconditionEuclid::initialize(const PETScWrappers::MatrixBase &matrix_)
+PreconditionEuclid::PreconditionEuclid(const PETScWrappers::MatrixBase &matrix,
+                                       const AdditionalData &additional_data)
+{
+  initialize(matrix, additional_data);
+}
+
+void PreconditionEuclid::initialize(const PETScWrappers::MatrixBase &matrix_,
+                                    const AdditionalData &additional_data_)
 {
   clear();
 
   matrix = static_cast<Mat>(matrix_);
+  additional_data = additional_data_;
 
   MPI_Comm comm = matrix_.get_mpi_communicator();
 
@@ -220,6 +230,11 @@ void PreconditionEuclid::initialize(const PETScWrappers::MatrixBase &matrix_)
 
   ierr = PCHYPRESetType_Euclid(pc);
 
+  PETScWrappers::set_option_value("-pc_hypre_euclid_levels",
+                                  Utilities::to_string(additional_data.levels));
+  PETScWrappers::set_option_value(
+    "-pc_hypre_euclid_bj", additional_data.block_jacobi ? "true" : "false");
+
   ierr = PCSetFromOptions(pc);
   AssertThrow(ierr == 0, ExcPETScError(ierr));
 
@@ -227,4 +242,110 @@ void PreconditionEuclid::initialize(const PETScWrappers::MatrixBase &matrix_)
   AssertThrow(ierr == 0, ExcPETScError(ierr));
 }
 
-/* ----------------- PreconditionEuclid ------------------------ */
+/* ----------------- HypreILUSettings ------------------------ */
+
+HypreILUSettings::HypreILUSettings(
+  const std::string &type,
+  const PreconditionEuclid::AdditionalData &euclid_data,
+  const PreconditionPilut::AdditionalData &pilut_data)
+  : type(type), euclid_data(euclid_data), pilut_data(pilut_data)
+{
+  AssertThrow(type == "Euclid" || type == "PILUT",
+              ExcMessage("Unknown ILU preconditioner!"));
+}
+
+std::shared_ptr<PETScWrappers::PreconditionerBase>
+HypreILUSettings::create(const PETScWrappers::MatrixBase &matrix) const
+{
+  if (type == "PILUT")
+    {
+      return std::make_shared<PreconditionPilut>(matrix, pilut_data);
+    }
+  return std::make_shared<PreconditionEuclid>(matrix, euclid_data);
+}
+
+std::string HypreILUSettings::description() const
+{
+  std::stringstream description;
+  if (type == "PILUT")
+    {
+      description << "PILUT (max iterations " << pilut_data.maxiter
+                  << ", factor row size " << pilut_data.factorrowsize
+                  << ", drop tolerance " << pilut_data.tolerance << ")";
+    }
+  else
+    {
+      description << "Euclid " << (euclid_data.block_jacobi ? "block " : "")
+                  << "ILU(" << euclid_data.levels << ")";
+    }
+  return description.str();
+}
+
+bool HypreILUSettings::operator==(const HypreILUSettings &other) const
+{
+  if (type != other.type)
+    {
+      return false;
+    }
+  if (type == "PILUT")
+    {
+      return pilut_data.maxiter == other.pilut_data.maxiter &&
+             pilut_data.factorrowsize == other.pilut_data.factorrowsize &&
+             pilut_data.tolerance == other.pilut_data.tolerance;
+    }
+  return euclid_data.levels == other.euclid_data.levels &&
+         euclid_data.block_jacobi == other.euclid_data.block_jacobi;
+}
+
+/* ----------------- ILUAutoTuner ------------------------ */
+
+ILUAutoTuner::ILUAutoTuner(const HypreILUSettings &configured,
+                           const bool enabled)
+  : candidates({configured}), index(0)
+{
+  if (!enabled)
+    {
+      // Nothing to try, lock in the configured settings right away.
+      costs.push_back(0);
+      return;
+    }
+  const std::vector<HypreILUSettings> grid = {
+    HypreILUSettings("Euclid", PreconditionEuclid::AdditionalData(0, false)),
+    HypreILUSettings("Euclid", PreconditionEuclid::AdditionalData(1, false)),
+    HypreILUSettings("Euclid", PreconditionEuclid::AdditionalData(0, true)),
+    HypreILUSettings("Euclid", PreconditionEuclid::AdditionalData(1, true)),
+    HypreILUSettings("PILUT",
+                     PreconditionEuclid::AdditionalData(),
+                     configured.pilut_data)};
+  for (const auto &settings : grid)
+    {
+      if (!(settings == configured))
+        {
+          candidates.push_back(settings);
+        }
+    }
+}
+
+const HypreILUSettings &ILUAutoTuner::current() const
+{
+  return candidates[index];
+}
+
+bool ILUAutoTuner::tuning() const { return costs.size() < candidates.size(); }
+
+void ILUAutoTuner::record(const double cost)
+{
+  if (!tuning())
+    {
+      return;
+    }
+  costs.push_back(cost);
+  if (tuning())
+    {
+      ++index;
+    }
+  else
+    {
+      index = std::min_element(costs.begin(), costs.end()) - costs.begin();
+    }
+}
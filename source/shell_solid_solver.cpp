@@ -68,6 +68,36 @@ namespace Solid
           bc.second;
       }
     this->m_shell->make_constraints(dirichlet_bcs);
+    setup_index_maps();
+  }
+
+  void ShellSolidSolver::setup_index_maps()
+  {
+    // The node id in m_mesh is the vertex index, so one walk over the mesh
+    // is enough for the whole simulation.
+    vector_node_dofs.clear();
+    scalar_node_dofs.clear();
+    std::vector<bool> vertex_touched(triangulation.n_vertices(), false);
+    auto scalar_cell = scalar_dof_handler.begin_active();
+    for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
+         ++cell, ++scalar_cell)
+      {
+        for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+          {
+            const unsigned int node = cell->vertex_index(v);
+            if (!vertex_touched[node])
+              {
+                vertex_touched[node] = true;
+                for (unsigned int n : {0, 1, 2})
+                  {
+                    vector_node_dofs.push_back(
+                      {node, n, cell->vertex_dof_index(v, n)});
+                  }
+                scalar_node_dofs.push_back(
+                  {node, 0, scalar_cell->vertex_dof_index(v, 0)});
+              }
+          }
+      }
   }
 
   void ShellSolidSolver::update_strain_and_stress() {}
@@ -139,78 +169,44 @@ namespace Solid
 
   void ShellSolidSolver::grab_solution()
   {
-    std::vector<bool> vertex_touched(triangulation.n_vertices(), false);
     const std::vector<libMesh::Number> &solution(m_shell->get_solution());
     AssertThrow(solution.size() == current_displacement.size() * 5,
                 ExcMessage("Inconsistent solution size!"));
     // Copy the solutions
-    for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
-         ++cell)
+    for (const auto &node_dof : vector_node_dofs)
       {
-        for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
-          {
-            if (!vertex_touched[cell->vertex_index(v)])
-              {
-                vertex_touched[cell->vertex_index(v)] = true;
-                for (unsigned int n : {0, 1, 2})
-                  {
-                    current_displacement(cell->vertex_dof_index(v, n)) =
-                      solution[15 * cell->vertex_index(v) + n];
-                    current_drilling(cell->vertex_dof_index(v, n)) =
-                      solution[15 * cell->vertex_index(v) + 3 + n];
-                  }
-              }
-          }
+        current_displacement(node_dof.dof) =
+          solution[15 * node_dof.node + node_dof.component];
+        current_drilling(node_dof.dof) =
+          solution[15 * node_dof.node + 3 + node_dof.component];
       }
   }
 
   void ShellSolidSolver::push_solution()
   {
-    std::vector<bool> vertex_touched(triangulation.n_vertices(), false);
     std::vector<libMesh::Number> solution(current_displacement.size() * 2);
     // Copy the solutions
-    for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
-         ++cell)
+    for (const auto &node_dof : vector_node_dofs)
       {
-        for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
-          {
-            if (!vertex_touched[cell->vertex_index(v)])
-              {
-                vertex_touched[cell->vertex_index(v)] = true;
-                for (unsigned int n : {0, 1, 2})
-                  {
-                    solution[6 * cell->vertex_index(v) + n] =
-                      current_displacement(cell->vertex_dof_index(v, n));
-                  }
-              }
-          }
+        solution[6 * node_dof.node + node_dof.component] =
+          current_displacement(node_dof.dof);
       }
     this->m_shell->set_solution(solution);
   }
 
   void ShellSolidSolver::grab_stress()
   {
-    std::vector<bool> vertex_touched(triangulation.n_vertices(), false);
     const std::vector<libMesh::Number> &solution(m_shell->get_solution());
     AssertThrow(solution.size() == current_displacement.size() * 5,
                 ExcMessage("Inconsistent solution size!"));
     // Copy the solutions
-    for (auto cell = scalar_dof_handler.begin_active();
-         cell != scalar_dof_handler.end();
-         ++cell)
+    for (const auto &node_dof : scalar_node_dofs)
       {
-        for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+        for (unsigned int i : {0, 1, 2})
           {
-            if (!vertex_touched[cell->vertex_index(v)])
-              {
-                vertex_touched[cell->vertex_index(v)] = true;
-                for (unsigned int i : {0, 1, 2})
-                  {
-                    for (unsigned int j : {0, 1, 2})
-                      stress[i][j](cell->vertex_dof_index(v, 0)) =
-                        solution[15 * cell->vertex_index(v) + 3 * i + j];
-                  }
-              }
+            for (unsigned int j : {0, 1, 2})
+              stress[i][j](node_dof.dof) =
+                solution[15 * node_dof.node + 3 * i + j];
           }
       }
   }
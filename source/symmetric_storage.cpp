@@ -0,0 +1,169 @@
+#include "symmetric_storage.h"
+
+#include <set>
+
+namespace SymmetricStorage
+{
+  namespace
+  {
+    // The PETSc handle is a protected member of the wrapper
+    struct MatrixAccess : PETScWrappers::MPI::SparseMatrix
+    {
+      static Mat &handle(PETScWrappers::MPI::SparseMatrix &m)
+      {
+        return m.*(&MatrixAccess::matrix);
+      }
+    };
+  } // namespace
+
+  void reinit(PETScWrappers::MPI::SparseMatrix &matrix,
+              const IndexSet &locally_owned_dofs,
+              const DynamicSparsityPattern &dsp,
+              const MPI_Comm &mpi_communicator,
+              const unsigned int block_size)
+  {
+    AssertThrow(locally_owned_dofs.is_contiguous(),
+                ExcMessage("The locally owned dofs must be contiguous!"));
+    const types::global_dof_index n_dofs = dsp.n_rows();
+    const types::global_dof_index n_local = locally_owned_dofs.n_elements();
+    const types::global_dof_index first =
+      n_local > 0 ? *locally_owned_dofs.begin() : 0;
+    const types::global_dof_index bs = block_size;
+    AssertThrow(first % bs == 0 && n_local % bs == 0 && n_dofs % bs == 0,
+                ExcMessage("The locally owned dofs are not aligned to the "
+                           "block size!"));
+
+    // Let the wrapper set up its state with a diagonal pattern, which is
+    // cheap, rather than a full AIJ copy of the pattern.
+    {
+      DynamicSparsityPattern diagonal(n_dofs, n_dofs, locally_owned_dofs);
+      for (const auto i : locally_owned_dofs)
+        {
+          diagonal.add(i, i);
+        }
+      matrix.reinit(
+        locally_owned_dofs, locally_owned_dofs, diagonal, mpi_communicator);
+    }
+
+    // The upper block columns of the owned block rows, split into the
+    // diagonal and the off-diagonal part of the row distribution
+    const types::global_dof_index first_block = first / bs;
+    const types::global_dof_index end_block = (first + n_local) / bs;
+    std::vector<std::vector<PetscInt>> block_columns(end_block - first_block);
+    std::vector<PetscInt> d_nnz(block_columns.size()),
+      o_nnz(block_columns.size());
+    for (types::global_dof_index br = first_block; br < end_block; ++br)
+      {
+        std::set<PetscInt> columns{static_cast<PetscInt>(br)};
+        for (types::global_dof_index i = br * bs; i < (br + 1) * bs; ++i)
+          {
+            for (unsigned int k = 0; k < dsp.row_length(i); ++k)
+              {
+                const types::global_dof_index bc =
+                  dsp.column_number(i, k) / bs;
+                if (bc >= br)
+                  {
+                    columns.insert(bc);
+                  }
+              }
+          }
+        auto &row = block_columns[br - first_block];
+        row.assign(columns.begin(), columns.end());
+        for (const auto bc : row)
+          {
+            if (static_cast<types::global_dof_index>(bc) < end_block)
+              {
+                ++d_nnz[br - first_block];
+              }
+            else
+              {
+                ++o_nnz[br - first_block];
+              }
+          }
+      }
+
+    Mat handle;
+    PetscErrorCode ierr = MatCreate(mpi_communicator, &handle);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    ierr = MatSetSizes(handle, n_local, n_local, n_dofs, n_dofs);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    ierr = MatSetType(handle, MATSBAIJ);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    // Only the call that matches the type takes effect
+    ierr = MatSeqSBAIJSetPreallocation(handle, bs, 0, d_nnz.data());
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    ierr = MatMPISBAIJSetPreallocation(
+      handle, bs, 0, d_nnz.data(), 0, o_nnz.data());
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+    // Insert the pattern, so that zeroing and assembly keep it
+    std::vector<PetscScalar> zeros;
+    for (types::global_dof_index br = first_block; br < end_block; ++br)
+      {
+        const auto &row = block_columns[br - first_block];
+        zeros.assign(row.size() * bs * bs, 0.0);
+        const PetscInt block_row = br;
+        ierr = MatSetValuesBlocked(handle,
+                                   1,
+                                   &block_row,
+                                   static_cast<PetscInt>(row.size()),
+                                   row.data(),
+                                   zeros.data(),
+                                   INSERT_VALUES);
+        AssertThrow(ierr == 0, ExcPETScError(ierr));
+      }
+    ierr = MatAssemblyBegin(handle, MAT_FINAL_ASSEMBLY);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    ierr = MatAssemblyEnd(handle, MAT_FINAL_ASSEMBLY);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+    ierr = MatSetOption(handle, MAT_SYMMETRIC, PETSC_TRUE);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    ierr = MatSetOption(handle, MAT_SYMMETRY_ETERNAL, PETSC_TRUE);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    // The assembly adds full local matrices
+    ierr = MatSetOption(handle, MAT_IGNORE_LOWER_TRIANGULAR, PETSC_TRUE);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    // Same as deal.II does for AIJ: the pattern is complete
+    ierr = MatSetOption(handle, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+    Mat &wrapped = MatrixAccess::handle(matrix);
+    ierr = MatDestroy(&wrapped);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    wrapped = handle;
+  }
+
+  bool is_symmetric(const PETScWrappers::MatrixBase &matrix)
+  {
+    PetscBool symmetric;
+    const PetscErrorCode ierr =
+      PetscObjectTypeCompareAny(reinterpret_cast<PetscObject>(
+                                  static_cast<Mat>(matrix)),
+                                &symmetric,
+                                MATSBAIJ,
+                                MATSEQSBAIJ,
+                                MATMPISBAIJ,
+                                "");
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    return symmetric;
+  }
+
+  void use_cholesky_blocks(
+    const PETScWrappers::PreconditionBlockJacobi &preconditioner)
+  {
+    PetscInt n_blocks;
+    KSP *block_solvers;
+    PetscErrorCode ierr = PCBJacobiGetSubKSP(
+      preconditioner.get_pc(), &n_blocks, nullptr, &block_solvers);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    for (PetscInt i = 0; i < n_blocks; ++i)
+      {
+        PC block_preconditioner;
+        ierr = KSPGetPC(block_solvers[i], &block_preconditioner);
+        AssertThrow(ierr == 0, ExcPETScError(ierr));
+        ierr = PCSetType(block_preconditioner, PCICC);
+        AssertThrow(ierr == 0, ExcPETScError(ierr));
+      }
+  }
+} // namespace SymmetricStorage
@@ -1,44 +1,593 @@
 #include "utilities.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <bitset>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
 
 namespace Utils
 {
-  bool Time::time_to_output() const
+  bool Time::passed_multiple_of(const double interval) const
   {
-    auto delta = static_cast<unsigned int>(output_interval / delta_t);
-    return (timestep >= delta && timestep % delta == 0);
+    if (timestep == 0)
+      {
+        return false;
+      }
+    // Tolerate the round-off accumulated in time_current
+    const double tolerance = 1e-6 * (time_current - time_previous);
+    return std::floor((time_current + tolerance) / interval) >
+           std::floor((time_previous + tolerance) / interval);
   }
 
-  bool Time::time_to_refine() const
+  bool Time::time_to_output() const
   {
-    auto delta = static_cast<unsigned int>(refinement_interval / delta_t);
-    return (timestep >= delta && timestep % delta == 0);
+    return passed_multiple_of(output_interval);
   }
 
-  bool Time::time_to_save() const
+  bool Time::time_to_refine() const
   {
-    auto delta = static_cast<unsigned int>(save_interval / delta_t);
-    return (timestep >= delta && timestep % delta == 0);
+    return passed_multiple_of(refinement_interval);
   }
 
+  bool Time::time_to_save() const { return passed_multiple_of(save_interval); }
+
   void Time::increment()
   {
+    time_previous = time_current;
     time_current += delta_t;
     ++timestep;
   }
 
   void Time::decrement()
   {
-    time_current -= delta_t;
+    time_current = time_previous;
+    time_previous = time_current - delta_t;
     --timestep;
   }
 
   void Time::set_delta_t(double delta) { delta_t = delta; }
 
+  Time::State Time::get_state() const
+  {
+    return {timestep, time_current, time_previous, delta_t};
+  }
+
+  void Time::set_state(const State &state)
+  {
+    timestep = state.timestep;
+    time_current = state.current;
+    time_previous = state.previous;
+    delta_t = state.delta_t;
+  }
+
+  void
+  Time::save(const std::string &filename,
+             const std::vector<std::pair<double, std::string>> &outputs) const
+  {
+    std::ofstream file(filename);
+    file << std::setprecision(17) << timestep << " " << time_current << " "
+         << time_previous << " " << delta_t << "\n"
+         << outputs.size() << "\n";
+    for (const auto &output : outputs)
+      {
+        file << output.first << " " << output.second << "\n";
+      }
+    AssertThrow(file, ExcMessage("Cannot write " + filename));
+  }
+
+  void Time::load(const std::string &filename,
+                  std::vector<std::pair<double, std::string>> &outputs)
+  {
+    std::ifstream file(filename);
+    std::size_t n_outputs = 0;
+    file >> timestep >> time_current >> time_previous >> delta_t >>
+      n_outputs;
+    outputs.resize(n_outputs);
+    for (auto &output : outputs)
+      {
+        file >> output.first >> output.second;
+      }
+    AssertThrow(file, ExcMessage("Cannot read " + filename));
+  }
+
+  TimeStepController::TimeStepController(const Parameters::AllParameters &p)
+    : adaptive(p.adaptive_time_stepping),
+      min_delta_t(p.min_time_step),
+      max_delta_t(p.max_time_step),
+      growth(p.time_step_growth),
+      reduction(p.time_step_reduction),
+      cfl_number(p.cfl_number),
+      tolerance(p.truncation_error_tolerance),
+      target_iterations(p.target_nonlinear_iterations)
+  {
+  }
+
+  double TimeStepController::cfl_factor(const double delta_t,
+                                        const double stable_delta_t) const
+  {
+    return cfl_number * stable_delta_t / delta_t;
+  }
+
+  double TimeStepController::error_factor(const double error,
+                                          const unsigned int order) const
+  {
+    if (error <= 0)
+      {
+        return growth;
+      }
+    // The usual safety factor keeps the next step from being rejected
+    return 0.9 * std::pow(tolerance / error, 1.0 / (order + 1));
+  }
+
+  double
+  TimeStepController::iteration_factor(const unsigned int n_iterations) const
+  {
+    return static_cast<double>(target_iterations) /
+           std::max(n_iterations, 1u);
+  }
+
+  void TimeStepController::update(Time &time,
+                                  const double factor,
+                                  const double limit) const
+  {
+    if (!adaptive)
+      {
+        return;
+      }
+    double delta_t =
+      time.get_delta_t() * std::max(reduction, std::min(growth, factor));
+    delta_t = std::max(min_delta_t, std::min(max_delta_t, delta_t));
+    delta_t = std::min(delta_t, time.get_delta_t() * limit);
+    const double remaining = time.end() - time.current();
+    if (remaining > 1e-12)
+      {
+        delta_t = std::min(delta_t, remaining);
+      }
+    time.set_delta_t(delta_t);
+  }
+
+  CouplingAccelerator::CouplingAccelerator(const Parameters::AllParameters &p)
+    : method(p.coupling_acceleration),
+      initial_relaxation(p.initial_relaxation),
+      reused_time_steps(p.reused_time_steps),
+      relaxation(p.initial_relaxation)
+  {
+  }
+
+  void CouplingAccelerator::new_time_step(const Vector<double> &x0)
+  {
+    // The interface does not change size, unless the solid is remeshed.
+    if (x.size() != x0.size())
+      {
+        residual_differences.clear();
+        x_tilde_differences.clear();
+        differences_per_step.clear();
+      }
+    x = x0;
+    previous_residual.reinit(0);
+    previous_x_tilde.reinit(0);
+    relaxation = initial_relaxation;
+    if (method != "IQN-ILS")
+      {
+        return;
+      }
+    differences_per_step.push_front(0);
+    while (differences_per_step.size() > reused_time_steps + 1)
+      {
+        for (unsigned int i = 0; i < differences_per_step.back(); ++i)
+          {
+            residual_differences.pop_back();
+            x_tilde_differences.pop_back();
+          }
+        differences_per_step.pop_back();
+      }
+  }
+
+  double CouplingAccelerator::update(const Vector<double> &x_tilde)
+  {
+    Vector<double> residual(x_tilde);
+    residual -= x;
+    const double x_tilde_norm = x_tilde.l2_norm();
+    const double relative_residual =
+      x_tilde_norm > 0 ? residual.l2_norm() / x_tilde_norm
+                       : residual.l2_norm();
+
+    if (previous_residual.size() == residual.size())
+      {
+        Vector<double> residual_difference(residual);
+        residual_difference -= previous_residual;
+        if (method == "Aitken")
+          {
+            const double denominator =
+              residual_difference * residual_difference;
+            if (denominator > 0)
+              {
+                relaxation *=
+                  -(previous_residual * residual_difference) / denominator;
+              }
+          }
+        else if (method == "IQN-ILS")
+          {
+            Vector<double> x_tilde_difference(x_tilde);
+            x_tilde_difference -= previous_x_tilde;
+            residual_differences.push_front(residual_difference);
+            x_tilde_differences.push_front(x_tilde_difference);
+            ++differences_per_step.front();
+          }
+      }
+    previous_residual = residual;
+    previous_x_tilde = x_tilde;
+
+    if (residual_differences.empty())
+      {
+        x.add(relaxation, residual);
+        return relative_residual;
+      }
+
+    // Least squares min |V alpha + r| by a QR decomposition of V, the
+    // residual differences, with modified Gram-Schmidt. Differences that
+    // are almost linearly dependent on the later ones are skipped.
+    std::vector<Vector<double>> q;
+    std::vector<std::vector<double>> r;
+    std::vector<unsigned int> columns;
+    for (unsigned int j = 0; j < residual_differences.size(); ++j)
+      {
+        Vector<double> column(residual_differences[j]);
+        const double norm = column.l2_norm();
+        std::vector<double> r_column(q.size() + 1);
+        for (unsigned int i = 0; i < q.size(); ++i)
+          {
+            r_column[i] = q[i] * column;
+            column.add(-r_column[i], q[i]);
+          }
+        r_column.back() = column.l2_norm();
+        if (r_column.back() <= 1e-10 * norm || norm == 0)
+          {
+            continue;
+          }
+        column /= r_column.back();
+        q.push_back(column);
+        r.push_back(r_column);
+        columns.push_back(j);
+      }
+    // Back substitution of R alpha = -Q^T r, then x = x~ + W alpha
+    std::vector<double> alpha(q.size());
+    for (unsigned int i = q.size(); i-- > 0;)
+      {
+        double value = -(q[i] * residual);
+        for (unsigned int k = i + 1; k < q.size(); ++k)
+          {
+            value -= r[k][i] * alpha[k];
+          }
+        alpha[i] = value / r[i][i];
+      }
+    x = x_tilde;
+    for (unsigned int i = 0; i < q.size(); ++i)
+      {
+        x.add(alpha[i], x_tilde_differences[columns[i]]);
+      }
+    return relative_residual;
+  }
+
+  namespace
+  {
+    /// Read access to the locally owned entries of a PETSc vector.
+    class ReadArray
+    {
+    public:
+      ReadArray(const PETScWrappers::VectorBase &v) : vector(v)
+      {
+        const PetscErrorCode ierr = VecGetArrayRead(vector, &data);
+        AssertThrow(ierr == 0, ExcPETScError(ierr));
+      }
+      ~ReadArray()
+      {
+        const PetscErrorCode ierr = VecRestoreArrayRead(vector, &data);
+        AssertNothrow(ierr == 0, ExcPETScError(ierr));
+        (void)ierr;
+      }
+      const PetscScalar &operator[](const unsigned int i) const
+      {
+        return data[i];
+      }
+
+    private:
+      const PETScWrappers::VectorBase &vector;
+      const PetscScalar *data;
+    };
+
+    /// Write access to the locally owned entries of a PETSc vector.
+    class WriteArray
+    {
+    public:
+      WriteArray(PETScWrappers::VectorBase &v) : vector(v)
+      {
+        const PetscErrorCode ierr = VecGetArray(vector, &data);
+        AssertThrow(ierr == 0, ExcPETScError(ierr));
+      }
+      ~WriteArray()
+      {
+        const PetscErrorCode ierr = VecRestoreArray(vector, &data);
+        AssertNothrow(ierr == 0, ExcPETScError(ierr));
+        (void)ierr;
+      }
+      PetscScalar &operator[](const unsigned int i) { return data[i]; }
+
+    private:
+      PETScWrappers::VectorBase &vector;
+      PetscScalar *data;
+    };
+  } // namespace
+
+  NewmarkUpdate::NewmarkUpdate(const double beta, const double gamma)
+    : beta(beta), gamma(gamma)
+  {
+  }
+
+  void NewmarkUpdate::reinit(VectorType &x,
+                             const IndexSet &locally_owned,
+                             MPI_Comm comm)
+  {
+    if (x.size() != locally_owned.size() ||
+        x.locally_owned_elements() != locally_owned)
+      {
+        x.reinit(locally_owned, comm);
+      }
+  }
+
+  void NewmarkUpdate::combine(VectorType &x,
+                              const VectorType &y,
+                              const double c_z,
+                              const VectorType &z)
+  {
+    AssertThrow(x.local_size() == y.local_size() &&
+                  x.local_size() == z.local_size(),
+                ExcMessage("Vector layouts do not match!"));
+    WriteArray x_data(x);
+    ReadArray y_data(y), z_data(z);
+    for (unsigned int i = 0; i < x.local_size(); ++i)
+      {
+        x_data[i] = y_data[i] + c_z * z_data[i];
+      }
+  }
+
+  void NewmarkUpdate::combine(VectorType &x,
+                              const VectorType &y,
+                              const double c_z,
+                              const VectorType &z,
+                              const double c_w,
+                              const VectorType &w)
+  {
+    AssertThrow(x.local_size() == y.local_size() &&
+                  x.local_size() == z.local_size() &&
+                  x.local_size() == w.local_size(),
+                ExcMessage("Vector layouts do not match!"));
+    WriteArray x_data(x);
+    ReadArray y_data(y), z_data(z), w_data(w);
+    for (unsigned int i = 0; i < x.local_size(); ++i)
+      {
+        x_data[i] = y_data[i] + c_z * z_data[i] + c_w * w_data[i];
+      }
+  }
+
+  void NewmarkUpdate::predict(VectorType &predicted,
+                              const double dt,
+                              const VectorType &d_n,
+                              const VectorType &v_n,
+                              const VectorType &a_n) const
+  {
+    combine(predicted, d_n, dt, v_n, (0.5 - beta) * dt * dt, a_n);
+  }
+
+  void NewmarkUpdate::correct(VectorType &a,
+                              VectorType &v,
+                              const double dt,
+                              const VectorType &d,
+                              const VectorType &predicted,
+                              const VectorType &v_n,
+                              const VectorType &a_n) const
+  {
+    AssertThrow(a.local_size() == v.local_size() &&
+                  a.local_size() == d.local_size() &&
+                  a.local_size() == predicted.local_size() &&
+                  a.local_size() == v_n.local_size() &&
+                  a.local_size() == a_n.local_size(),
+                ExcMessage("Vector layouts do not match!"));
+    const double c_a = 1 / (beta * dt * dt);
+    WriteArray a_data(a), v_data(v);
+    ReadArray d_data(d), predicted_data(predicted), v_n_data(v_n),
+      a_n_data(a_n);
+    for (unsigned int i = 0; i < a.local_size(); ++i)
+      {
+        a_data[i] = c_a * (d_data[i] - predicted_data[i]);
+        v_data[i] = v_n_data[i] +
+                    dt * ((1 - gamma) * a_n_data[i] + gamma * a_data[i]);
+      }
+  }
+
+  void NewmarkUpdate::advance(const VectorType &a,
+                              VectorType &v,
+                              VectorType &d,
+                              const double dt,
+                              VectorType &a_n,
+                              VectorType &v_n,
+                              VectorType &d_n) const
+  {
+    AssertThrow(a.local_size() == v.local_size() &&
+                  a.local_size() == d.local_size() &&
+                  a.local_size() == a_n.local_size() &&
+                  a.local_size() == v_n.local_size() &&
+                  a.local_size() == d_n.local_size(),
+                ExcMessage("Vector layouts do not match!"));
+    ReadArray a_data(a);
+    WriteArray v_data(v), d_data(d), a_n_data(a_n), v_n_data(v_n),
+      d_n_data(d_n);
+    for (unsigned int i = 0; i < a.local_size(); ++i)
+      {
+        const double a_old = a_n_data[i];
+        const double v_old = v_n_data[i];
+        // \f$ v_{n+1} = v_n + (1-\gamma)\Delta{t}a_n + \gamma\Delta{t}a_{n+1}
+        // \f$
+        v_data[i] = v_old + dt * ((1 - gamma) * a_old + gamma * a_data[i]);
+        d_data[i] = d_n_data[i] + dt * v_old +
+                    dt * dt * ((0.5 - beta) * a_old + beta * a_data[i]);
+        a_n_data[i] = a_data[i];
+        v_n_data[i] = v_data[i];
+        d_n_data[i] = d_data[i];
+      }
+  }
+
+  void NewmarkUpdate::store(const VectorType &a,
+                            const VectorType &v,
+                            const VectorType &d,
+                            VectorType &a_n,
+                            VectorType &v_n,
+                            VectorType &d_n)
+  {
+    AssertThrow(a.local_size() == v.local_size() &&
+                  a.local_size() == d.local_size() &&
+                  a.local_size() == a_n.local_size() &&
+                  a.local_size() == v_n.local_size() &&
+                  a.local_size() == d_n.local_size(),
+                ExcMessage("Vector layouts do not match!"));
+    ReadArray a_data(a), v_data(v), d_data(d);
+    WriteArray a_n_data(a_n), v_n_data(v_n), d_n_data(d_n);
+    for (unsigned int i = 0; i < a.local_size(); ++i)
+      {
+        a_n_data[i] = a_data[i];
+        v_n_data[i] = v_data[i];
+        d_n_data[i] = d_data[i];
+      }
+  }
+
+  template <int dim>
+  CellCenterIndex<dim>::CellCenterIndex(const DoFHandler<dim> &dof_handler)
+    : dof_handler(dof_handler), max_diameter(0), bin_size(1)
+  {
+    reinit();
+  }
+
+  template <int dim>
+  void CellCenterIndex<dim>::reinit()
+  {
+    entries.clear();
+    bins.clear();
+    max_diameter = 0;
+    for (auto cell : dof_handler.active_cell_iterators())
+      {
+        if (!cell->is_locally_owned())
+          continue;
+        entries.push_back(
+          {cell, cell->center(), cell->diameter(), cell->measure()});
+        max_diameter = std::max(max_diameter, entries.back().diameter);
+      }
+    if (entries.empty())
+      {
+        n_bins.fill(0);
+        return;
+      }
+    // The support radius of the cubic spline is twice the cell diameter,
+    // so with this bin size a query only needs the neighboring bins.
+    bin_size = 2 * max_diameter;
+    Point<dim> upper = entries[0].center;
+    origin = entries[0].center;
+    for (const auto &e : entries)
+      {
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            origin[d] = std::min(origin[d], e.center[d]);
+            upper[d] = std::max(upper[d], e.center[d]);
+          }
+      }
+    unsigned int total_bins = 1;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        n_bins[d] =
+          static_cast<int>(std::floor((upper[d] - origin[d]) / bin_size)) + 1;
+        total_bins *= n_bins[d];
+      }
+    bins.resize(total_bins);
+    for (unsigned int i = 0; i < entries.size(); ++i)
+      {
+        std::array<int, dim> b;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            b[d] = std::min(
+              static_cast<int>(
+                std::floor((entries[i].center[d] - origin[d]) / bin_size)),
+              n_bins[d] - 1);
+          }
+        bins[bin_index(b)].push_back(i);
+      }
+  }
+
+  template <int dim>
+  unsigned int
+  CellCenterIndex<dim>::bin_index(const std::array<int, dim> &b) const
+  {
+    unsigned int index = b[dim - 1];
+    for (int d = dim - 2; d >= 0; --d)
+      {
+        index = index * n_bins[d] + b[d];
+      }
+    return index;
+  }
+
+  template <int dim>
+  void CellCenterIndex<dim>::query(const Point<dim> &p,
+                                   double radius,
+                                   std::vector<unsigned int> &result) const
+  {
+    result.clear();
+    if (entries.empty())
+      return;
+    std::array<int, dim> lower, upper;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        lower[d] = std::max(
+          static_cast<int>(std::floor((p[d] - radius - origin[d]) / bin_size)),
+          0);
+        upper[d] = std::min(
+          static_cast<int>(std::floor((p[d] + radius - origin[d]) / bin_size)),
+          n_bins[d] - 1);
+        if (upper[d] < lower[d])
+          return;
+      }
+    // Visit every bin in the box [lower, upper]
+    std::array<int, dim> b = lower;
+    while (true)
+      {
+        for (auto i : bins[bin_index(b)])
+          {
+            if (entries[i].center.distance(p) < radius)
+              {
+                result.push_back(i);
+              }
+          }
+        unsigned int d = 0;
+        for (; d < dim; ++d)
+          {
+            if (++b[d] <= upper[d])
+              break;
+            b[d] = lower[d];
+          }
+        if (d == dim)
+          break;
+      }
+  }
+
   template <int dim, typename VectorType>
   SPHInterpolator<dim, VectorType>::SPHInterpolator(
     const DoFHandler<dim> &dof_handler, const Point<dim> &point)
-    : dof_handler(dof_handler), target(point)
+    : dof_handler(dof_handler),
+      targets(1, point),
+      mapping(1),
+      fe_values(mapping,
+                dof_handler.get_fe(),
+                cell_center_quadrature(),
+                update_values | update_gradients)
   {
     for (auto cell : dof_handler.active_cell_iterators())
       {
@@ -46,14 +595,65 @@ namespace Utils
           continue;
         Point<dim> center = cell->center();
         double h = cell->diameter();
-        double kernel_value = cubic_spline(center, target, h);
+        double kernel_value = cubic_spline(center, point, h);
         if (kernel_value > 1e-12)
           {
-            sources.push_back({cell, kernel_value});
+            // In SPH interpolation, volume must be multiplied because kernel
+            // function has a unit of LENGTH^{-dim}
+            sources.push_back({cell, {{0, kernel_value * cell->measure()}}});
           }
       }
   }
 
+  template <int dim, typename VectorType>
+  SPHInterpolator<dim, VectorType>::SPHInterpolator(
+    const CellCenterIndex<dim> &index, const std::vector<Point<dim>> &points)
+    : dof_handler(index.get_dof_handler()),
+      targets(points),
+      mapping(1),
+      fe_values(mapping,
+                dof_handler.get_fe(),
+                cell_center_quadrature(),
+                update_values | update_gradients)
+  {
+    // Group the contributions by source cell so that every cell is evaluated
+    // once for the whole batch. The map keeps the sources in the order of
+    // the active cells.
+    std::map<unsigned int, std::vector<std::pair<unsigned int, double>>>
+      contributions;
+    std::vector<unsigned int> neighbors;
+    const double radius = 2 * index.get_max_diameter();
+    for (unsigned int t = 0; t < targets.size(); ++t)
+      {
+        index.query(targets[t], radius, neighbors);
+        for (auto i : neighbors)
+          {
+            const auto &e = index.entry(i);
+            double kernel_value =
+              cubic_spline(e.center, targets[t], e.diameter);
+            if (kernel_value > 1e-12)
+              {
+                contributions[i].push_back({t, kernel_value * e.measure});
+              }
+          }
+      }
+    sources.reserve(contributions.size());
+    for (auto &c : contributions)
+      {
+        sources.push_back({index.entry(c.first).cell, std::move(c.second)});
+      }
+  }
+
+  template <int dim, typename VectorType>
+  Quadrature<dim> SPHInterpolator<dim, VectorType>::cell_center_quadrature()
+  {
+    // Cell center in unit coordinate system
+    Point<dim> unit_center;
+    for (unsigned int i = 0; i < dim; ++i)
+      unit_center[i] = 0.5;
+    return Quadrature<dim>(unit_center);
+  }
+
   template <int dim, typename VectorType>
   double SPHInterpolator<dim, VectorType>::cubic_spline(const Point<dim> &pi,
                                                         const Point<dim> &pj,
@@ -79,67 +679,74 @@ namespace Utils
 
   template <int dim, typename VectorType>
   void SPHInterpolator<dim, VectorType>::point_value(
-    const VectorType &fe_function,
-    Vector<typename VectorType::value_type> &value)
+    const VectorType &fe_function, Vector<Number> &value)
   {
-    typedef typename VectorType::value_type Number;
-    const FiniteElement<dim> &fe = dof_handler.get_fe();
-    Assert(value.size() == fe.n_components(),
-           ExcDimensionMismatch(value.size(), fe.n_components()));
+    std::vector<Vector<Number>> values(targets.size(), value);
+    point_values(fe_function, values);
+    value = values[0];
+  }
 
-    // Cell center in unit coordinate system
-    Point<dim> unit_center;
-    for (unsigned int i = 0; i < dim; ++i)
-      unit_center[i] = 0.5;
-    Quadrature<dim> quad(unit_center);
-    MappingQGeneric<dim> mapping(1);
-    FEValues<dim> fe_values(mapping, fe, quad, update_values);
-    value = 0;
-    for (auto p : sources)
-      {
-        auto cell = p.first;
-        fe_values.reinit(cell);
-        std::vector<Vector<Number>> u_value(1,
-                                            Vector<Number>(fe.n_components()));
+  template <int dim, typename VectorType>
+  void SPHInterpolator<dim, VectorType>::point_values(
+    const VectorType &fe_function, std::vector<Vector<Number>> &values)
+  {
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    AssertDimension(values.size(), targets.size());
+    for (auto &value : values)
+      {
+        Assert(value.size() == fe.n_components(),
+               ExcDimensionMismatch(value.size(), fe.n_components()));
+        value = 0;
+      }
+    std::vector<Vector<Number>> u_value(1, Vector<Number>(fe.n_components()));
+    for (const auto &source : sources)
+      {
+        fe_values.reinit(source.first);
         fe_values.get_function_values(fe_function, u_value);
-        // In SPH interpolation, volume must be multiplied because kernel
-        // function has a unit of LENGTH^{-dim}
-        u_value[0] *= p.second * cell->measure();
-        value += u_value[0];
+        for (const auto &target : source.second)
+          {
+            values[target.first].add(target.second, u_value[0]);
+          }
       }
   }
 
   template <int dim, typename VectorType>
   void SPHInterpolator<dim, VectorType>::point_gradient(
     const VectorType &fe_function,
-    std::vector<Tensor<1, dim, typename VectorType::value_type>> &gradient)
+    std::vector<Tensor<1, dim, Number>> &gradient)
+  {
+    std::vector<std::vector<Tensor<1, dim, Number>>> gradients(targets.size(),
+                                                               gradient);
+    point_gradients(fe_function, gradients);
+    gradient = gradients[0];
+  }
+
+  template <int dim, typename VectorType>
+  void SPHInterpolator<dim, VectorType>::point_gradients(
+    const VectorType &fe_function,
+    std::vector<std::vector<Tensor<1, dim, Number>>> &gradients)
   {
-    typedef typename VectorType::value_type Number;
     const FiniteElement<dim> &fe = dof_handler.get_fe();
-    Assert(gradient.size() == fe.n_components(),
-           ExcDimensionMismatch(gradient.size(), fe.n_components()));
-    // Cell center in unit coordinate system
-    Point<dim> unit_center;
-    for (unsigned int i = 0; i < dim; ++i)
-      unit_center[i] = 0.5;
-    Quadrature<dim> quad(unit_center);
-    MappingQGeneric<dim> mapping(1);
-    FEValues<dim> fe_values(mapping, fe, quad, update_gradients);
-    for (unsigned int i = 0; i < gradient.size(); ++i)
-      gradient[i] = 0;
-    for (auto p : sources)
-      {
-        auto cell = p.first;
-        fe_values.reinit(cell);
-        std::vector<std::vector<Tensor<1, dim, Number>>> u_gradient(
-          1, std::vector<Tensor<1, dim, Number>>(fe.n_components()));
-        fe_values.get_function_gradients(fe_function, u_gradient);
+    AssertDimension(gradients.size(), targets.size());
+    for (auto &gradient : gradients)
+      {
+        Assert(gradient.size() == fe.n_components(),
+               ExcDimensionMismatch(gradient.size(), fe.n_components()));
         for (unsigned int i = 0; i < gradient.size(); ++i)
+          gradient[i] = 0;
+      }
+    std::vector<std::vector<Tensor<1, dim, Number>>> u_gradient(
+      1, std::vector<Tensor<1, dim, Number>>(fe.n_components()));
+    for (const auto &source : sources)
+      {
+        fe_values.reinit(source.first);
+        fe_values.get_function_gradients(fe_function, u_gradient);
+        for (const auto &target : source.second)
           {
-            // In SPH interpolation, volume must be multiplied because kernel
-            // function has a unit of LENGTH^{-dim}
-            u_gradient[0][i] *= p.second * cell->measure();
-            gradient[i] += u_gradient[0][i];
+            for (unsigned int i = 0; i < fe.n_components(); ++i)
+              {
+                gradients[target.first][i] += target.second * u_gradient[0][i];
+              }
           }
       }
   }
@@ -150,13 +757,20 @@ namespace Utils
     const Point<dim> &point,
     const std::vector<bool> &mask,
     const typename DoFHandler<dim>::active_cell_iterator &cell)
-    : dof_handler(dof_handler), point(point), cell_found(true)
+    : dof_handler(dof_handler), point(point), cell_found(true), affine(false)
   {
     // If the cell is valid we just use the cell
     if (cell.state() == IteratorState::IteratorStates::valid)
       {
         cell_point.first = cell;
-        cell_point.second = mapping.transform_real_to_unit_cell(cell, point);
+        // Parallelograms and parallelepipeds can be inverted in closed form,
+        // otherwise fall back to the Newton iteration of MappingQ1.
+        affine = affine_real_to_unit_cell(cell, point, cell_point.second);
+        if (!affine)
+          {
+            cell_point.second =
+              mapping.transform_real_to_unit_cell(cell, point);
+          }
         return;
       }
     // This function throws an exception of GridTools::ExcPointNotFound if the
@@ -176,65 +790,187 @@ namespace Utils
   }
 
   template <int dim, typename VectorType>
-  void GridInterpolator<dim, VectorType>::point_value(
-    const VectorType &fe_function,
-    Vector<typename VectorType::value_type> &value)
+  bool GridInterpolator<dim, VectorType>::affine_real_to_unit_cell(
+    const typename DoFHandler<dim>::cell_iterator &cell,
+    const Point<dim> &p,
+    Point<dim> &unit_point)
   {
-    typedef typename VectorType::value_type Number;
-    const FiniteElement<dim> &fe = dof_handler.get_fe();
-    Assert(value.size() == fe.n_components(),
-           ExcDimensionMismatch(value.size(), fe.n_components()));
-    // If for some reason, the point is not found in any cell,
-    // or it is on a cell that is not locally owned, return 0.
-    if (cell_point.first == dof_handler.end() ||
-        !cell_point.first->is_locally_owned())
+    // With the lexicographic vertex numbering, vertex 2^d is the neighbor of
+    // vertex 0 in the d-th direction, and a cell is affine if every vertex
+    // can be reached by adding these edge vectors to vertex 0.
+    const Point<dim> &v0 = cell->vertex(0);
+    Tensor<2, dim> jacobian;
+    for (unsigned int d = 0; d < dim; ++d)
       {
-        value = 0;
-        return;
+        const Tensor<1, dim> edge = cell->vertex(1 << d) - v0;
+        for (unsigned int i = 0; i < dim; ++i)
+          {
+            jacobian[i][d] = edge[i];
+          }
       }
+    const double tolerance = 1e-12 * cell->diameter();
+    for (unsigned int v = 1; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      {
+        Point<dim> affine_vertex = v0;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            if (v & (1 << d))
+              {
+                for (unsigned int i = 0; i < dim; ++i)
+                  {
+                    affine_vertex[i] += jacobian[i][d];
+                  }
+              }
+          }
+        if (affine_vertex.distance(cell->vertex(v)) > tolerance)
+          {
+            return false;
+          }
+      }
+    unit_point = Point<dim>(invert(jacobian) * (p - v0));
+    return true;
+  }
+
+  template <int dim, typename VectorType>
+  bool GridInterpolator<dim, VectorType>::evaluable() const
+  {
+    // If for some reason, the point is not found in any cell,
+    // or it is on a cell that is not locally owned, it cannot be evaluated.
+    return cell_point.first != dof_handler.end() &&
+           cell_point.first->is_locally_owned();
+  }
+
+  template <int dim, typename VectorType>
+  void GridInterpolator<dim, VectorType>::compute_shape_values()
+  {
+    if (!shape_values.empty())
+      return;
     Assert(GeometryInfo<dim>::distance_to_unit_cell(cell_point.second) < 1e-10,
            ExcInternalError());
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    const Point<dim> unit_point =
+      GeometryInfo<dim>::project_to_unit_cell(cell_point.second);
+    // The shape values do not depend on the mapping, so we evaluate the
+    // basis on the reference cell directly.
+    shape_values.resize(fe.dofs_per_cell);
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      {
+        shape_values[i] = fe.shape_value(i, unit_point);
+      }
+    local_dof_values.reinit(fe.dofs_per_cell);
+  }
 
-    const Quadrature<dim> quadrature(
-      GeometryInfo<dim>::project_to_unit_cell(cell_point.second));
-    FEValues<dim> fe_values(mapping, fe, quadrature, update_values);
-    fe_values.reinit(cell_point.first);
-    std::vector<Vector<Number>> u_value(1, Vector<Number>(fe.n_components()));
-    fe_values.get_function_values(fe_function, u_value);
-    value = u_value[0];
+  template <int dim, typename VectorType>
+  void GridInterpolator<dim, VectorType>::compute_shape_gradients()
+  {
+    if (!shape_gradients.empty())
+      return;
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    const Point<dim> unit_point =
+      GeometryInfo<dim>::project_to_unit_cell(cell_point.second);
+    // Jacobian of the d-linear mapping at the unit point, which is constant
+    // for affine cells.
+    Tensor<2, dim> jacobian;
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      {
+        const Tensor<1, dim> grad_v =
+          GeometryInfo<dim>::d_linear_shape_function_gradient(unit_point, v);
+        jacobian += outer_product(cell_point.first->vertex(v), grad_v);
+      }
+    const Tensor<2, dim> inverse_jacobian = invert(jacobian);
+    shape_gradients.resize(fe.dofs_per_cell);
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      {
+        shape_gradients[i] = fe.shape_grad(i, unit_point) * inverse_jacobian;
+      }
+    local_dof_values.reinit(fe.dofs_per_cell);
+  }
+
+  template <int dim, typename VectorType>
+  void GridInterpolator<dim, VectorType>::point_value(
+    const VectorType &fe_function, Vector<Number> &value)
+  {
+    std::vector<Vector<Number>> values(1, value);
+    point_values({&fe_function}, values);
+    value = values[0];
+  }
+
+  template <int dim, typename VectorType>
+  void GridInterpolator<dim, VectorType>::point_values(
+    const std::vector<const VectorType *> &fe_functions,
+    std::vector<Vector<Number>> &values)
+  {
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    AssertDimension(values.size(), fe_functions.size());
+    if (!evaluable())
+      {
+        for (auto &value : values)
+          {
+            value = 0;
+          }
+        return;
+      }
+    compute_shape_values();
+    for (unsigned int n = 0; n < fe_functions.size(); ++n)
+      {
+        Assert(values[n].size() == fe.n_components(),
+               ExcDimensionMismatch(values[n].size(), fe.n_components()));
+        cell_point.first->get_dof_values(*fe_functions[n], local_dof_values);
+        values[n] = 0;
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          {
+            values[n][fe.system_to_component_index(i).first] +=
+              local_dof_values[i] * shape_values[i];
+          }
+      }
   }
 
   template <int dim, typename VectorType>
   void GridInterpolator<dim, VectorType>::point_gradient(
     const VectorType &fe_function,
-    std::vector<Tensor<1, dim, typename VectorType::value_type>> &gradient)
+    std::vector<Tensor<1, dim, Number>> &gradient)
+  {
+    std::vector<std::vector<Tensor<1, dim, Number>>> gradients(1, gradient);
+    point_gradients({&fe_function}, gradients);
+    gradient = gradients[0];
+  }
+
+  template <int dim, typename VectorType>
+  void GridInterpolator<dim, VectorType>::point_gradients(
+    const std::vector<const VectorType *> &fe_functions,
+    std::vector<std::vector<Tensor<1, dim, Number>>> &gradients)
   {
-    typedef typename VectorType::value_type Number;
     const FiniteElement<dim> &fe = dof_handler.get_fe();
-    Assert(gradient.size() == fe.n_components(),
-           ExcDimensionMismatch(gradient.size(), fe.n_components()));
-    // If for some reason, the point is not found in any cell,
-    // or it is on a cell that is not locally owned, return 0.
-    if (cell_point.first == dof_handler.end() ||
-        !cell_point.first->is_locally_owned())
+    AssertDimension(gradients.size(), fe_functions.size());
+    if (!evaluable())
       {
-        for (auto &v : gradient)
+        for (auto &gradient : gradients)
           {
-            v = 0;
+            for (auto &v : gradient)
+              {
+                v = 0;
+              }
           }
         return;
       }
     Assert(GeometryInfo<dim>::distance_to_unit_cell(cell_point.second) < 1e-10,
            ExcInternalError());
-
-    const Quadrature<dim> quadrature(
-      GeometryInfo<dim>::project_to_unit_cell(cell_point.second));
-    FEValues<dim> fe_values(mapping, fe, quadrature, update_gradients);
-    fe_values.reinit(cell_point.first);
-    std::vector<std::vector<Tensor<1, dim, Number>>> u_gradient(
-      1, std::vector<Tensor<1, dim, Number>>(fe.n_components()));
-    fe_values.get_function_gradients(fe_function, u_gradient);
-    gradient = u_gradient[0];
+    compute_shape_gradients();
+    for (unsigned int n = 0; n < fe_functions.size(); ++n)
+      {
+        Assert(gradients[n].size() == fe.n_components(),
+               ExcDimensionMismatch(gradients[n].size(), fe.n_components()));
+        cell_point.first->get_dof_values(*fe_functions[n], local_dof_values);
+        for (auto &v : gradients[n])
+          {
+            v = 0;
+          }
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          {
+            gradients[n][fe.system_to_component_index(i).first] +=
+              local_dof_values[i] * shape_gradients[i];
+          }
+      }
   }
 
   template <int dim, typename VectorType>
@@ -593,6 +1329,232 @@ namespace Utils
     tria.set_manifold(0, CylindricalManifold<3>(2));
   }
 
+  template <int dim>
+  void GridCreator<dim>::write_partitioned(Triangulation<dim> &tria,
+                                           const unsigned int n_partitions,
+                                           const std::string &basename)
+  {
+    GridTools::partition_triangulation(n_partitions, tria);
+    for (unsigned int rank = 0; rank < n_partitions; ++rank)
+      {
+        const auto description =
+          TriangulationDescription::Utilities::
+            create_description_from_triangulation(
+              tria,
+              MPI_COMM_SELF,
+              TriangulationDescription::Settings::default_setting,
+              rank);
+        std::ofstream file(basename + "." + Utilities::int_to_string(rank, 4),
+                           std::ios::binary);
+        AssertThrow(file, ExcMessage("Cannot write the mesh partitions!"));
+        boost::archive::binary_oarchive archive(file);
+        archive << description;
+      }
+  }
+
+  template <int dim>
+  void GridCreator<dim>::read_partitioned(
+    parallel::fullydistributed::Triangulation<dim> &tria,
+    const std::string &basename)
+  {
+    const std::string filename =
+      basename + "." +
+      Utilities::int_to_string(
+        Utilities::MPI::this_mpi_process(tria.get_communicator()), 4);
+    std::ifstream file(filename, std::ios::binary);
+    AssertThrow(file, ExcMessage("Cannot open mesh partition " + filename));
+    TriangulationDescription::Description<dim, dim> description;
+    boost::archive::binary_iarchive archive(file);
+    archive >> description;
+    // The communicator is not stored
+    description.comm = tria.get_communicator();
+    tria.create_triangulation(description);
+  }
+
+  template <int dim>
+  void CellHints<dim>::setup(const Triangulation<dim> &fluid_tria,
+                             const DoFHandler<dim> &solid_dof_handler,
+                             const unsigned int n_points)
+  {
+    const Triangulation<dim> &solid_tria =
+      solid_dof_handler.get_triangulation();
+    // Drop the entries of the cells that have been refined or coarsened away
+    hints.clear();
+    for (auto cell = fluid_tria.begin_active(); cell != fluid_tria.end();
+         ++cell)
+      {
+        if (cell->is_artificial())
+          {
+            continue;
+          }
+        hints.initialize(cell, n_points);
+        const std::vector<std::shared_ptr<SolidCell>> cell_hints =
+          hints.get_data(cell);
+        Assert(cell_hints.size() == n_points,
+               ExcMessage("Wrong number of cell hints!"));
+        auto stored = stored_hints.find(cell->id());
+        if (stored != stored_hints.end() && stored->second.size() != n_points)
+          {
+            stored = stored_hints.end();
+          }
+        for (unsigned int v = 0; v < n_points; ++v)
+          {
+            *(cell_hints[v]) = solid_dof_handler.begin_active();
+            if (stored == stored_hints.end())
+              {
+                continue;
+              }
+            const unsigned int level = stored->second[v].first;
+            const unsigned int index = stored->second[v].second;
+            if (level < solid_tria.n_levels() &&
+                index < solid_tria.n_raw_cells(level))
+              {
+                typename Triangulation<dim>::raw_cell_iterator raw_cell(
+                  &solid_tria, level, index);
+                if (raw_cell->used() && raw_cell->active())
+                  {
+                    *(cell_hints[v]) =
+                      SolidCell(&solid_tria, level, index, &solid_dof_handler);
+                  }
+              }
+          }
+      }
+    stored_hints.clear();
+  }
+
+  template <int dim>
+  std::vector<std::shared_ptr<typename CellHints<dim>::SolidCell>>
+  CellHints<dim>::get(
+    const typename Triangulation<dim>::active_cell_iterator &cell)
+  {
+    return hints.get_data(cell);
+  }
+
+  template <int dim>
+  unsigned int CellHints<dim>::prepare_for_coarsening_and_refinement(
+    parallel::distributed::Triangulation<dim> &fluid_tria)
+  {
+    using FluidTriangulation = parallel::distributed::Triangulation<dim>;
+    return fluid_tria.register_data_attach(
+      [this](const typename FluidTriangulation::cell_iterator &cell,
+             const typename FluidTriangulation::CellStatus status) {
+        const typename FluidTriangulation::active_cell_iterator active_cell(
+          status == FluidTriangulation::CELL_COARSEN ? cell->child(0) : cell);
+        StoredHints solid_cells;
+        for (const auto &hint : hints.get_data(active_cell))
+          {
+            solid_cells.emplace_back((*hint)->level(), (*hint)->index());
+          }
+        return Utilities::pack(solid_cells, false);
+      },
+      true);
+  }
+
+  template <int dim>
+  void
+  CellHints<dim>::unpack(parallel::distributed::Triangulation<dim> &fluid_tria,
+                         const unsigned int handle)
+  {
+    using FluidTriangulation = parallel::distributed::Triangulation<dim>;
+    fluid_tria.notify_ready_to_unpack(
+      handle,
+      [this](const typename FluidTriangulation::cell_iterator &cell,
+             const typename FluidTriangulation::CellStatus status,
+             const boost::iterator_range<std::vector<char>::const_iterator>
+               &data) {
+        const StoredHints solid_cells =
+          Utilities::unpack<StoredHints>(data.begin(), data.end(), false);
+        if (status == FluidTriangulation::CELL_REFINE)
+          {
+            for (unsigned int c = 0; c < cell->n_children(); ++c)
+              {
+                stored_hints[cell->child(c)->id()] = solid_cells;
+              }
+          }
+        else
+          {
+            stored_hints[cell->id()] = solid_cells;
+          }
+      });
+  }
+
+  template <int dim>
+  void CellHints<dim>::save(
+    const std::string &filename,
+    const parallel::DistributedTriangulationBase<dim> &fluid_tria) const
+  {
+    std::ostringstream local_hints;
+    for (auto cell = fluid_tria.begin_active(); cell != fluid_tria.end();
+         ++cell)
+      {
+        if (!cell->is_locally_owned())
+          {
+            continue;
+          }
+        local_hints << cell->id();
+        for (const auto &hint : hints.get_data(cell))
+          {
+            local_hints << " " << (*hint)->level() << " " << (*hint)->index();
+          }
+        local_hints << "\n";
+      }
+    const std::vector<std::string> all_hints =
+      Utilities::MPI::gather(fluid_tria.get_communicator(), local_hints.str());
+    if (Utilities::MPI::this_mpi_process(fluid_tria.get_communicator()) != 0)
+      {
+        return;
+      }
+    std::ofstream file(filename);
+    AssertThrow(file, ExcMessage("Cannot write " + filename));
+    for (const auto &process_hints : all_hints)
+      {
+        file << process_hints;
+      }
+  }
+
+  template <int dim>
+  bool CellHints<dim>::load(const std::string &filename,
+                            const Triangulation<dim> &fluid_tria,
+                            const unsigned int n_points)
+  {
+    std::ifstream file(filename);
+    if (!file)
+      {
+        return false;
+      }
+    // Only the cells this process sees are kept
+    std::set<CellId> relevant_cells;
+    for (auto cell = fluid_tria.begin_active(); cell != fluid_tria.end();
+         ++cell)
+      {
+        if (!cell->is_artificial())
+          {
+            relevant_cells.insert(cell->id());
+          }
+      }
+    std::string line;
+    while (std::getline(file, line))
+      {
+        std::istringstream fields(line);
+        CellId id;
+        fields >> id;
+        if (!fields || relevant_cells.count(id) == 0)
+          {
+            continue;
+          }
+        StoredHints solid_cells(n_points);
+        for (auto &solid_cell : solid_cells)
+          {
+            fields >> solid_cell.first >> solid_cell.second;
+          }
+        if (fields)
+          {
+            stored_hints[id] = solid_cells;
+          }
+      }
+    return true;
+  }
+
   template class GridCreator<2>;
   template class GridCreator<3>;
   template class GridInterpolator<2, Vector<double>>;
@@ -601,10 +1563,14 @@ namespace Utils
   template class GridInterpolator<3, BlockVector<double>>;
   template class GridInterpolator<2, PETScWrappers::MPI::BlockVector>;
   template class GridInterpolator<3, PETScWrappers::MPI::BlockVector>;
+  template class CellCenterIndex<2>;
+  template class CellCenterIndex<3>;
   template class SPHInterpolator<2, Vector<double>>;
   template class SPHInterpolator<3, Vector<double>>;
   template class SPHInterpolator<2, PETScWrappers::MPI::BlockVector>;
   template class SPHInterpolator<3, PETScWrappers::MPI::BlockVector>;
   template class Utils::CellLocator<2, DoFHandler<2, 2>>;
   template class Utils::CellLocator<3, DoFHandler<3, 3>>;
+  template class CellHints<2>;
+  template class CellHints<3>;
 } // namespace Utils
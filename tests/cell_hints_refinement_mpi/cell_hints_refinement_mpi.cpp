@@ -0,0 +1,199 @@
+/**
+ * This program tests that the FSI cell hints survive the refinement of the
+ * fluid mesh. The hints of the fluid vertices in a rectangular solid are set
+ * by searching for the solid cells. Then the fluid mesh is refined around
+ * the solid, and coarsened back. After each step every hint must locate its
+ * fluid vertex, and a vertex that was there before must be found in the same
+ * solid cell as before.
+ */
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include "parameters.h"
+#include "utilities.h"
+
+using namespace dealii;
+
+extern template class Utils::CellLocator<2, DoFHandler<2, 2>>;
+extern template class Utils::CellHints<2>;
+
+// The solid cell a fluid vertex was found in, by the vertex position
+struct PointLess
+{
+  bool operator()(const Point<2> &a, const Point<2> &b) const
+  {
+    return a[0] < b[0] || (a[0] == b[0] && a[1] < b[1]);
+  }
+};
+using FoundCells =
+  std::map<Point<2>, std::pair<unsigned int, unsigned int>, PointLess>;
+
+// The solid does not line up with the fluid vertices
+const Point<2> solid_min(0.31, 0.27), solid_max(0.69, 0.73);
+
+bool in_solid(const Point<2> &p)
+{
+  return p[0] > solid_min[0] && p[0] < solid_max[0] && p[1] > solid_min[1] &&
+         p[1] < solid_max[1];
+}
+
+/**
+ * Search for the solid cells of the vertices of the locally owned fluid
+ * cells from their hints, and point the hints at them as FSI does. Check the
+ * cells against the ones found before the refinement, if any. Returns the
+ * number of vertices found from a hint other than the global search, and
+ * the number of them compared with the previous search.
+ */
+std::pair<unsigned int, unsigned int>
+search(parallel::distributed::Triangulation<2> &fluid_tria,
+       DoFHandler<2> &solid_dof_handler,
+       Utils::CellHints<2> &hints,
+       FoundCells &found_cells)
+{
+  FoundCells previous_cells;
+  std::swap(previous_cells, found_cells);
+  unsigned int n_hinted = 0, n_compared = 0;
+  for (auto cell = fluid_tria.begin_active(); cell != fluid_tria.end();
+       ++cell)
+    {
+      if (!cell->is_locally_owned())
+        {
+          continue;
+        }
+      auto cell_hints = hints.get(cell);
+      for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+        {
+          const Point<2> point = cell->vertex(v);
+          if (!in_solid(point))
+            {
+              continue;
+            }
+          n_hinted += *cell_hints[v] != solid_dof_handler.begin_active();
+          Utils::CellLocator<2, DoFHandler<2>> locator(
+            solid_dof_handler, point, *cell_hints[v]);
+          const auto solid_cell = locator.search();
+          AssertThrow(locator.found_cell() && solid_cell->point_inside(point),
+                      ExcMessage("The hint does not locate the point!"));
+          *cell_hints[v] = solid_cell;
+          const std::pair<unsigned int, unsigned int> found(
+            solid_cell->level(), solid_cell->index());
+          const auto previous = previous_cells.find(point);
+          if (previous != previous_cells.end())
+            {
+              ++n_compared;
+              AssertThrow(previous->second == found,
+                          ExcMessage("The point is found in another cell "
+                                     "after the refinement!"));
+            }
+          found_cells[point] = found;
+        }
+    }
+  return {Utilities::MPI::sum(n_hinted, MPI_COMM_WORLD),
+          Utilities::MPI::sum(n_compared, MPI_COMM_WORLD)};
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      parallel::distributed::Triangulation<2> fluid_tria(MPI_COMM_WORLD);
+      GridGenerator::hyper_cube(fluid_tria, 0, 1, true);
+      fluid_tria.refine_global(params.global_refinements[0]);
+
+      Triangulation<2> solid_tria;
+      GridGenerator::subdivided_hyper_rectangle(
+        solid_tria, {5, 7}, solid_min, solid_max, true);
+      FESystem<2> solid_fe(FE_Q<2>(1), 2);
+      DoFHandler<2> solid_dof_handler(solid_tria);
+      solid_dof_handler.distribute_dofs(solid_fe);
+
+      Utils::CellHints<2> hints;
+      FoundCells found_cells;
+      hints.setup(
+        fluid_tria, solid_dof_handler, GeometryInfo<2>::vertices_per_cell);
+      search(fluid_tria, solid_dof_handler, hints, found_cells);
+
+      for (const bool refine : {true, false})
+        {
+          for (auto cell = fluid_tria.begin_active(); cell != fluid_tria.end();
+               ++cell)
+            {
+              if (!cell->is_locally_owned())
+                {
+                  continue;
+                }
+              const Point<2> center = cell->center();
+              const bool near_solid = center[0] > solid_min[0] - 0.1 &&
+                                      center[0] < solid_max[0] + 0.1 &&
+                                      center[1] > solid_min[1] - 0.1 &&
+                                      center[1] < solid_max[1] + 0.1;
+              if (refine && near_solid)
+                {
+                  cell->set_refine_flag();
+                }
+              else if (!refine &&
+                       cell->level() >
+                         static_cast<int>(params.global_refinements[0]))
+                {
+                  cell->set_coarsen_flag();
+                }
+            }
+          fluid_tria.prepare_coarsening_and_refinement();
+          const unsigned int handle =
+            hints.prepare_for_coarsening_and_refinement(fluid_tria);
+          fluid_tria.execute_coarsening_and_refinement();
+          hints.unpack(fluid_tria, handle);
+          hints.setup(
+            fluid_tria, solid_dof_handler, GeometryInfo<2>::vertices_per_cell);
+
+          const auto counts =
+            search(fluid_tria, solid_dof_handler, hints, found_cells);
+          if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+            {
+              std::cout << (refine ? "Refined" : "Coarsened")
+                        << ": fluid cells: "
+                        << fluid_tria.n_global_active_cells()
+                        << ", transferred hints: " << counts.first
+                        << ", points compared: " << counts.second << std::endl;
+            }
+          AssertThrow(counts.first > 0 && counts.second > 0,
+                      ExcMessage("No hints have been transferred!"));
+        }
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
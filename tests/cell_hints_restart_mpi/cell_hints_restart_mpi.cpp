@@ -0,0 +1,173 @@
+/**
+ * This program tests that the FSI cell hints are restored from a checkpoint.
+ * The hints of the fluid vertices in a rectangular solid are set by searching
+ * for the solid cells on a locally refined fluid mesh and saved. The same
+ * fluid mesh is created again as in a restart, and its hints loaded from the
+ * file must point to the same solid cells, which contain their vertices.
+ */
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include "parameters.h"
+#include "utilities.h"
+
+using namespace dealii;
+
+extern template class Utils::CellLocator<2, DoFHandler<2, 2>>;
+extern template class Utils::CellHints<2>;
+
+// The solid does not line up with the fluid vertices
+const Point<2> solid_min(0.31, 0.27), solid_max(0.69, 0.73);
+
+bool in_solid(const Point<2> &p)
+{
+  return p[0] > solid_min[0] && p[0] < solid_max[0] && p[1] > solid_min[1] &&
+         p[1] < solid_max[1];
+}
+
+void create_fluid_mesh(parallel::distributed::Triangulation<2> &tria,
+                       const unsigned int n_refinements)
+{
+  GridGenerator::hyper_cube(tria, 0, 1, true);
+  tria.refine_global(n_refinements);
+  for (auto cell = tria.begin_active(); cell != tria.end(); ++cell)
+    {
+      if (cell->is_locally_owned() && in_solid(cell->center()))
+        {
+          cell->set_refine_flag();
+        }
+    }
+  tria.execute_coarsening_and_refinement();
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      Triangulation<2> solid_tria;
+      GridGenerator::subdivided_hyper_rectangle(
+        solid_tria, {5, 7}, solid_min, solid_max, true);
+      FESystem<2> solid_fe(FE_Q<2>(1), 2);
+      DoFHandler<2> solid_dof_handler(solid_tria);
+      solid_dof_handler.distribute_dofs(solid_fe);
+      const unsigned int n_points = GeometryInfo<2>::vertices_per_cell;
+      const std::string filename = "000001.fsi_hints";
+
+      // The solid cells found for every vertex of the locally owned cells
+      std::map<CellId, std::vector<std::pair<unsigned int, unsigned int>>>
+        saved_cells;
+      {
+        parallel::distributed::Triangulation<2> fluid_tria(MPI_COMM_WORLD);
+        create_fluid_mesh(fluid_tria, params.global_refinements[0]);
+        Utils::CellHints<2> hints;
+        hints.setup(fluid_tria, solid_dof_handler, n_points);
+        for (auto cell = fluid_tria.begin_active(); cell != fluid_tria.end();
+             ++cell)
+          {
+            if (!cell->is_locally_owned())
+              {
+                continue;
+              }
+            auto cell_hints = hints.get(cell);
+            for (unsigned int v = 0; v < n_points; ++v)
+              {
+                const Point<2> point = cell->vertex(v);
+                if (in_solid(point))
+                  {
+                    Utils::CellLocator<2, DoFHandler<2>> locator(
+                      solid_dof_handler, point, *cell_hints[v]);
+                    *cell_hints[v] = locator.search();
+                    AssertThrow(locator.found_cell(),
+                                ExcMessage("Cannot find point in solid!"));
+                  }
+                saved_cells[cell->id()].emplace_back(
+                  (*cell_hints[v])->level(), (*cell_hints[v])->index());
+              }
+          }
+        hints.save(filename, fluid_tria);
+      }
+
+      parallel::distributed::Triangulation<2> fluid_tria(MPI_COMM_WORLD);
+      create_fluid_mesh(fluid_tria, params.global_refinements[0]);
+      Utils::CellHints<2> hints;
+      AssertThrow(!hints.load("missing.fsi_hints", fluid_tria, n_points),
+                  ExcMessage("Loaded the hints from a missing file!"));
+      AssertThrow(hints.load(filename, fluid_tria, n_points),
+                  ExcMessage("Cannot read " + filename));
+      hints.setup(fluid_tria, solid_dof_handler, n_points);
+      unsigned int n_restored = 0;
+      for (auto cell = fluid_tria.begin_active(); cell != fluid_tria.end();
+           ++cell)
+        {
+          if (!cell->is_locally_owned())
+            {
+              continue;
+            }
+          const auto saved = saved_cells.find(cell->id());
+          AssertThrow(saved != saved_cells.end(),
+                      ExcMessage("The restarted mesh is partitioned "
+                                 "differently!"));
+          auto cell_hints = hints.get(cell);
+          for (unsigned int v = 0; v < n_points; ++v)
+            {
+              const auto &hint = *cell_hints[v];
+              AssertThrow(static_cast<unsigned int>(hint->level()) ==
+                              saved->second[v].first &&
+                            static_cast<unsigned int>(hint->index()) ==
+                              saved->second[v].second,
+                          ExcMessage("The restored hint differs from the "
+                                     "saved one!"));
+              if (in_solid(cell->vertex(v)))
+                {
+                  AssertThrow(hint->point_inside(cell->vertex(v)),
+                              ExcMessage("The restored hint does not contain "
+                                         "its point!"));
+                  ++n_restored;
+                }
+            }
+        }
+      n_restored = Utilities::MPI::sum(n_restored, MPI_COMM_WORLD);
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          std::cout << "Restored hints in the solid: " << n_restored
+                    << std::endl;
+        }
+      AssertThrow(n_restored > 0, ExcMessage("No hints have been restored!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
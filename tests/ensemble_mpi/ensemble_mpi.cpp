@@ -0,0 +1,126 @@
+/**
+ * This program tests the ensemble driver. Four variants of a pressure step
+ * relaxing in a 2D channel are run in up to two groups: members 0 and 2
+ * have the same parameters and run in the same group, the second one on the
+ * meshes of the first, and their solutions must be identical. The other
+ * members have a higher viscosity.
+ */
+#include "ensemble.h"
+#include "mpi_scnsim.h"
+#include "parameters.h"
+#include "utilities.h"
+
+#include <map>
+
+extern template class Fluid::MPI::SCnsIM<2>;
+extern template class MPI::Ensemble<2>;
+
+using namespace dealii;
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      std::vector<Parameters::AllParameters> members(4, params);
+      members[1].viscosity *= 2;
+      members[3].viscosity *= 2;
+      const unsigned int n_groups =
+        std::min(2u, Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD));
+      MPI::Ensemble<2> ensemble(members, n_groups);
+
+      auto create_meshes = [](MPI_Comm communicator,
+                              const Parameters::AllParameters &parameters,
+                              MPI::Ensemble<2>::SharedMeshes &meshes) {
+        meshes.fluid.reset(
+          new parallel::distributed::Triangulation<2>(communicator));
+        GridGenerator::subdivided_hyper_rectangle(
+          *meshes.fluid, {150, 20}, Point<2>(0, 0), Point<2>(15, 2), true);
+        meshes.fluid->refine_global(parameters.global_refinements[0]);
+      };
+
+      auto initial_condition = [](const Point<2> &point,
+                                  const unsigned int component) -> double {
+        double pressure = 1e4;
+        if (component == 2 && point[0] > 4.0 && point[0] < 5.0)
+          {
+            return pressure * (point[0] - 4.0);
+          }
+        else if (component == 2 && point[0] >= 5.0 && point[0] < 12.0)
+          {
+            return pressure;
+          }
+        return 0.0;
+      };
+
+      // Norms of the velocity and the pressure of every member of the group
+      std::map<unsigned int, std::vector<double>> norms;
+      auto run_member = [&](MPI_Comm communicator,
+                            const unsigned int member,
+                            const Parameters::AllParameters &parameters,
+                            MPI::Ensemble<2>::SharedMeshes &meshes) {
+        Fluid::MPI::SCnsIM<2> flow(*meshes.fluid, parameters);
+        flow.set_initial_condition(initial_condition);
+        flow.run();
+        const auto solution = flow.get_current_solution();
+        for (unsigned int b = 0; b < solution.n_blocks(); ++b)
+          {
+            PETScWrappers::MPI::Vector block(
+              solution.block(b).locally_owned_elements(), communicator);
+            block = solution.block(b);
+            norms[member].push_back(block.l2_norm());
+          }
+      };
+
+      ensemble.run(create_meshes, run_member);
+      ensemble.print_summary();
+
+      if (ensemble.get_group() == 0)
+        {
+          AssertThrow(ensemble.reused_meshes(2) && !ensemble.reused_meshes(0),
+                      ExcMessage("Member 2 should reuse the meshes!"));
+          for (unsigned int b = 0; b < 2; ++b)
+            {
+              AssertThrow(std::abs(norms[0][b] - norms[2][b]) <=
+                            1e-10 * norms[0][b],
+                          ExcMessage("Reusing the meshes changed the result!"));
+            }
+        }
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
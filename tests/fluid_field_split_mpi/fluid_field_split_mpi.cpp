@@ -0,0 +1,118 @@
+/**
+ * This program tests the PETSc PCFIELDSPLIT path of the parallel slightly
+ * compressible solver. A pressure step relaxes in a 2D channel, solved with
+ * the built-in incomplete Schur complement preconditioner and with
+ * PCFIELDSPLIT in Schur and multiplicative mode. All of them converge the
+ * same nonlinear systems, so the solutions must agree up to the Newton
+ * tolerance.
+ */
+#include "mpi_scnsim.h"
+#include "parameters.h"
+#include "utilities.h"
+
+extern template class Fluid::MPI::SCnsIM<2>;
+
+using namespace dealii;
+
+PETScWrappers::MPI::BlockVector run(const Parameters::AllParameters &params)
+{
+  auto initial_condition = [](const Point<2> &point,
+                              const unsigned int component) -> double {
+    double pressure = 1e4;
+    if (component == 2 && point[0] > 4.0 && point[0] < 5.0)
+      {
+        return pressure * (point[0] - 4.0);
+      }
+    else if (component == 2 && point[0] >= 5.0 && point[0] < 12.0)
+      {
+        return pressure;
+      }
+    return 0.0;
+  };
+  parallel::distributed::Triangulation<2> tria(MPI_COMM_WORLD);
+  GridGenerator::subdivided_hyper_rectangle(
+    tria, {150, 20}, Point<2>(0, 0), Point<2>(15, 2), true);
+  Fluid::MPI::SCnsIM<2> flow(tria, params);
+  flow.set_initial_condition(initial_condition);
+  flow.run();
+  return flow.get_current_solution();
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      AssertThrow(params.fluid_linear_solver == "Field split",
+                  ExcMessage("This test needs the field split solver!"));
+
+      params.fluid_linear_solver = "Block preconditioner";
+      const auto reference = run(params);
+      params.fluid_linear_solver = "Field split";
+      for (std::string split_type : {"Schur", "Multiplicative"})
+        {
+          params.field_split_type = split_type;
+          const auto solution = run(params);
+          // Compare the velocity and the pressure separately, in
+          // non-ghosted vectors
+          double difference = 0;
+          for (unsigned int b = 0; b < 2; ++b)
+            {
+              PETScWrappers::MPI::Vector error, reference_block;
+              error.reinit(reference.block(b).locally_owned_elements(),
+                           MPI_COMM_WORLD);
+              reference_block.reinit(
+                reference.block(b).locally_owned_elements(), MPI_COMM_WORLD);
+              error = solution.block(b);
+              reference_block = reference.block(b);
+              error -= reference_block;
+              difference = std::max(
+                difference, error.l2_norm() / reference_block.l2_norm());
+            }
+          if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+            {
+              std::cout << split_type << " field split, relative difference "
+                        << "from the block preconditioner: " << difference
+                        << std::endl;
+            }
+          AssertThrow(difference < 1e-4,
+                      ExcMessage(split_type + " field split differs!"));
+        }
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
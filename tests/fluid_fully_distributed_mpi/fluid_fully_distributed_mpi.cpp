@@ -0,0 +1,135 @@
+/**
+ * This program tests the fully distributed fluid mesh. A pressure step
+ * relaxes in a 2D channel whose mesh is partitioned on the first process
+ * and read back by every process, and the result is compared with the one
+ * on a parallel::distributed mesh. The dofs are numbered differently in the
+ * two meshes, so the norms of the velocity and the pressure are compared.
+ */
+#include "mpi_scnsim.h"
+#include "parameters.h"
+#include "utilities.h"
+
+extern template class Fluid::MPI::SCnsIM<2>;
+extern template class Utils::GridCreator<2>;
+
+using namespace dealii;
+
+void create_channel(Triangulation<2> &tria)
+{
+  GridGenerator::subdivided_hyper_rectangle(
+    tria, {150, 20}, Point<2>(0, 0), Point<2>(15, 2), true);
+}
+
+std::vector<double> run(parallel::DistributedTriangulationBase<2> &tria,
+                        const Parameters::AllParameters &params)
+{
+  auto initial_condition = [](const Point<2> &point,
+                              const unsigned int component) -> double {
+    double pressure = 1e4;
+    if (component == 2 && point[0] > 4.0 && point[0] < 5.0)
+      {
+        return pressure * (point[0] - 4.0);
+      }
+    else if (component == 2 && point[0] >= 5.0 && point[0] < 12.0)
+      {
+        return pressure;
+      }
+    return 0.0;
+  };
+  Fluid::MPI::SCnsIM<2> flow(tria, params);
+  flow.set_initial_condition(initial_condition);
+  flow.run();
+  const auto solution = flow.get_current_solution();
+  // The norms of ghosted vectors are computed from the locally owned part
+  std::vector<double> norms;
+  for (unsigned int b = 0; b < solution.n_blocks(); ++b)
+    {
+      PETScWrappers::MPI::Vector block(
+        solution.block(b).locally_owned_elements(), MPI_COMM_WORLD);
+      block = solution.block(b);
+      norms.push_back(block.l2_norm());
+    }
+  return norms;
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      std::vector<double> reference;
+      {
+        parallel::distributed::Triangulation<2> tria(MPI_COMM_WORLD);
+        create_channel(tria);
+        reference = run(tria, params);
+      }
+
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          Triangulation<2> serial_tria;
+          create_channel(serial_tria);
+          Utils::GridCreator<2>::write_partitioned(
+            serial_tria,
+            Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD),
+            "channel");
+        }
+      MPI_Barrier(MPI_COMM_WORLD);
+
+      parallel::fullydistributed::Triangulation<2> tria(MPI_COMM_WORLD);
+      Utils::GridCreator<2>::read_partitioned(tria, "channel");
+      AssertThrow(tria.n_global_active_cells() == 3000,
+                  ExcMessage("Wrong number of cells in the partitions!"));
+      const auto norms = run(tria, params);
+
+      double difference = 0;
+      for (unsigned int b = 0; b < norms.size(); ++b)
+        {
+          difference = std::max(
+            difference, std::abs(norms[b] - reference[b]) / reference[b]);
+        }
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          std::cout << "Relative difference of the fully distributed mesh: "
+                    << difference << std::endl;
+        }
+      AssertThrow(difference < 1e-4,
+                  ExcMessage("The fully distributed mesh gives a different "
+                             "solution!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * This program tests the local time stepping of the parallel explicit Slightly
+ * Compressible solver with the acoustic wave in a 2D duct whose right part is
+ * refined twice more. The coarse cells take the 8e-7s time step, the fine ones
+ * 4 substeps of 2e-7s. The velocity must agree with a run that advances all
+ * the cells with 2e-7s. The wall times of both runs are printed.
+ */
+#include <deal.II/base/timer.h>
+
+#include "mpi_scnsex.h"
+#include "parameters.h"
+#include "utilities.h"
+
+extern template class Fluid::MPI::SCnsEX<2>;
+extern template class Fluid::MPI::SCnsEX<3>;
+
+using namespace dealii;
+
+PETScWrappers::MPI::Vector run(const Parameters::AllParameters &params)
+{
+  double L = 4, H = 1;
+
+  auto gaussian_pulse = [](const Point<2> &p,
+                           const unsigned int component,
+                           const double time) -> double {
+    auto time_value = [](double t) {
+      return 6.0 * exp(-0.5 * pow((t - 0.5e-4) / 0.15e-4, 2));
+    };
+
+    if (component == 0 && std::abs(p[0]) < 1e-10)
+      return time_value(time);
+
+    return 0;
+  };
+
+  parallel::distributed::Triangulation<2> tria(MPI_COMM_WORLD);
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    tria, {8, 2}, Point<2>(0, 0), Point<2>(L, H), true);
+  tria.refine_global(3);
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      for (auto cell : tria.active_cell_iterators())
+        {
+          if (cell->is_locally_owned() && cell->center()[0] > 1.5)
+            {
+              cell->set_refine_flag();
+            }
+        }
+      tria.execute_coarsening_and_refinement();
+    }
+
+  Fluid::MPI::SCnsEX<2> flow(tria, params);
+  flow.add_hard_coded_boundary_condition(0, gaussian_pulse);
+  flow.set_hard_coded_boundary_condition_time(0, 1.1e-4);
+  flow.run();
+  return flow.get_current_solution().block(0);
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+      AssertThrow(params.local_time_step_levels > 1,
+                  ExcMessage("This test needs local time stepping!"));
+
+      Timer timer(MPI_COMM_WORLD, true);
+      Parameters::AllParameters global_params = params;
+      global_params.local_time_step_levels = 1;
+      global_params.time_step =
+        params.time_step / (1u << (params.local_time_step_levels - 1));
+      const auto reference = run(global_params);
+      timer.stop();
+      const double global_time = timer.wall_time();
+
+      timer.restart();
+      auto v = run(params);
+      timer.stop();
+      const double local_time = timer.wall_time();
+
+      const double vmax_error =
+        std::abs(v.max() - reference.max()) / reference.max();
+      v -= reference;
+      const double difference = v.l2_norm() / reference.l2_norm();
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          std::cout << "Wall time, global time step: " << global_time
+                    << " s, local time steps: " << local_time
+                    << " s, relative difference: " << difference
+                    << ", max velocity error: " << vmax_error << std::endl;
+        }
+      AssertThrow(vmax_error < 1e-2 && difference < 5e-2,
+                  ExcMessage("Local time stepping differs from the global "
+                             "time step!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
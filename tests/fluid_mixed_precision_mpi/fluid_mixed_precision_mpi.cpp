@@ -0,0 +1,126 @@
+/**
+ * This program tests the mixed-precision preconditioner of the parallel
+ * slightly compressible solver. A pressure step relaxes in a 2D channel,
+ * preconditioned with the double precision Euclid factors and with the
+ * single precision ILU(0) factors. The outer FGMRES and Newton iterations
+ * converge to the same tolerances, so the solutions must agree up to the
+ * Newton tolerance. The wall times of both runs are printed.
+ */
+#include <deal.II/base/timer.h>
+
+#include "mpi_scnsim.h"
+#include "parameters.h"
+#include "utilities.h"
+
+extern template class Fluid::MPI::SCnsIM<2>;
+
+using namespace dealii;
+
+PETScWrappers::MPI::BlockVector run(const Parameters::AllParameters &params)
+{
+  auto initial_condition = [](const Point<2> &point,
+                              const unsigned int component) -> double {
+    double pressure = 1e4;
+    if (component == 2 && point[0] > 4.0 && point[0] < 5.0)
+      {
+        return pressure * (point[0] - 4.0);
+      }
+    else if (component == 2 && point[0] >= 5.0 && point[0] < 12.0)
+      {
+        return pressure;
+      }
+    return 0.0;
+  };
+  parallel::distributed::Triangulation<2> tria(MPI_COMM_WORLD);
+  GridGenerator::subdivided_hyper_rectangle(
+    tria, {150, 20}, Point<2>(0, 0), Point<2>(15, 2), true);
+  Fluid::MPI::SCnsIM<2> flow(tria, params);
+  flow.set_initial_condition(initial_condition);
+  flow.run();
+  return flow.get_current_solution();
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      AssertThrow(params.fluid_mixed_precision,
+                  ExcMessage("This test needs the mixed-precision "
+                             "preconditioner!"));
+
+      Timer timer(MPI_COMM_WORLD, true);
+      params.fluid_mixed_precision = false;
+      const auto reference = run(params);
+      timer.stop();
+      const double double_time = timer.wall_time();
+
+      timer.restart();
+      params.fluid_mixed_precision = true;
+      const auto solution = run(params);
+      timer.stop();
+      const double mixed_time = timer.wall_time();
+
+      // Compare the velocity and the pressure separately, in non-ghosted
+      // vectors
+      double difference = 0;
+      for (unsigned int b = 0; b < 2; ++b)
+        {
+          PETScWrappers::MPI::Vector error, reference_block;
+          error.reinit(reference.block(b).locally_owned_elements(),
+                       MPI_COMM_WORLD);
+          reference_block.reinit(reference.block(b).locally_owned_elements(),
+                                 MPI_COMM_WORLD);
+          error = solution.block(b);
+          reference_block = reference.block(b);
+          error -= reference_block;
+          difference = std::max(difference,
+                                error.l2_norm() / reference_block.l2_norm());
+        }
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          std::cout << "Wall time, double precision: " << double_time
+                    << " s, mixed precision: " << mixed_time
+                    << " s, relative difference: " << difference << std::endl;
+        }
+      AssertThrow(difference < 1e-4,
+                  ExcMessage("Mixed-precision preconditioned solution "
+                             "differs from the double precision one!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * This program tests the nonlinear solvers of the parallel slightly
+ * compressible solver. A pressure step relaxes in a 2D channel, solved with
+ * full Newton, modified Newton that reuses the Jacobian, and JFNK that only
+ * uses it as the preconditioner. All of them converge the same nonlinear
+ * systems, so the solutions must agree up to the Newton tolerance.
+ */
+#include "mpi_scnsim.h"
+#include "parameters.h"
+#include "utilities.h"
+
+extern template class Fluid::MPI::SCnsIM<2>;
+
+using namespace dealii;
+
+PETScWrappers::MPI::BlockVector run(const Parameters::AllParameters &params)
+{
+  auto initial_condition = [](const Point<2> &point,
+                              const unsigned int component) -> double {
+    double pressure = 1e4;
+    if (component == 2 && point[0] > 4.0 && point[0] < 5.0)
+      {
+        return pressure * (point[0] - 4.0);
+      }
+    else if (component == 2 && point[0] >= 5.0 && point[0] < 12.0)
+      {
+        return pressure;
+      }
+    return 0.0;
+  };
+  parallel::distributed::Triangulation<2> tria(MPI_COMM_WORLD);
+  GridGenerator::subdivided_hyper_rectangle(
+    tria, {150, 20}, Point<2>(0, 0), Point<2>(15, 2), true);
+  Fluid::MPI::SCnsIM<2> flow(tria, params);
+  flow.set_initial_condition(initial_condition);
+  flow.run();
+  return flow.get_current_solution();
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      params.fluid_nonlinear_solver = "Newton";
+      const auto newton = run(params);
+      for (std::string solver : {"Modified Newton", "JFNK"})
+        {
+          params.fluid_nonlinear_solver = solver;
+          const auto solution = run(params);
+          // Compare the velocity and the pressure separately, in
+          // non-ghosted vectors
+          double difference = 0;
+          for (unsigned int b = 0; b < 2; ++b)
+            {
+              PETScWrappers::MPI::Vector error, reference;
+              error.reinit(newton.block(b).locally_owned_elements(),
+                           MPI_COMM_WORLD);
+              reference.reinit(newton.block(b).locally_owned_elements(),
+                               MPI_COMM_WORLD);
+              error = solution.block(b);
+              reference = newton.block(b);
+              error -= reference;
+              difference =
+                std::max(difference, error.l2_norm() / reference.l2_norm());
+            }
+          if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+            {
+              std::cout << solver
+                        << ", relative difference from Newton: " << difference
+                        << std::endl;
+            }
+          AssertThrow(difference < 1e-4,
+                      ExcMessage(solver + " differs from Newton!"));
+        }
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
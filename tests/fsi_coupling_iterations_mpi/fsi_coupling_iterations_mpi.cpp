@@ -0,0 +1,104 @@
+/**
+ * This program tests the coupling iterations of the FSI. A ball falling in a
+ * tank is simulated with the coupling iterations accelerated by IQN-ILS and
+ * by Aitken relaxation. Both converge the fluid traction on the solid, so
+ * the solutions must agree up to the coupling tolerance.
+ */
+#include "mpi_fsi.h"
+#include "mpi_insim.h"
+#include "mpi_shared_hyper_elasticity.h"
+
+extern template class Fluid::MPI::InsIM<2>;
+extern template class Solid::MPI::SharedHyperElasticity<2>;
+extern template class Utils::GridCreator<2>;
+extern template class MPI::FSI<2>;
+
+using namespace dealii;
+
+// Return the norms of the fluid and solid solutions.
+std::pair<double, double> run(const Parameters::AllParameters &params)
+{
+  double L = 1, W = 2, H = 5, R = 0.125, h = 0.25;
+  parallel::distributed::Triangulation<2> fluid_tria(MPI_COMM_WORLD);
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    fluid_tria,
+    {static_cast<unsigned int>(W / h), static_cast<unsigned int>(H / h)},
+    Point<2>(0, 0),
+    Point<2>(W, -H),
+    true);
+  Fluid::MPI::InsIM<2> fluid(fluid_tria, params);
+
+  Triangulation<2> solid_tria;
+  Point<2> center(L, -L);
+  Utils::GridCreator<2>::sphere(solid_tria, center, R);
+  Solid::MPI::SharedHyperElasticity<2> solid(solid_tria, params);
+
+  MPI::FSI<2> fsi(fluid, solid, params);
+  fsi.run();
+  return {fluid.get_current_solution().l2_norm(),
+          solid.get_current_solution().l2_norm()};
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+      AssertThrow(params.max_coupling_iterations > 1,
+                  ExcMessage("This test needs coupling iterations!"));
+
+      Parameters::AllParameters iqn_params(params);
+      iqn_params.coupling_acceleration = "IQN-ILS";
+      auto iqn = run(iqn_params);
+
+      Parameters::AllParameters aitken_params(params);
+      aitken_params.coupling_acceleration = "Aitken";
+      auto aitken = run(aitken_params);
+
+      const double difference =
+        std::max(std::abs(aitken.first - iqn.first) / iqn.first,
+                 std::abs(aitken.second - iqn.second) / iqn.second);
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          std::cout << "Relative difference of IQN-ILS and Aitken: "
+                    << difference << std::endl;
+        }
+      AssertThrow(difference < 1e-3,
+                  ExcMessage("IQN-ILS and Aitken converge to different "
+                             "solutions!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
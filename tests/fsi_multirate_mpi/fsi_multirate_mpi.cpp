@@ -0,0 +1,116 @@
+/**
+ * This program tests the multirate FSI coupling. A ball falling in a tank is
+ * simulated with the same time step in the fluid and the solid, then with
+ * the fluid taking "Fluid steps per solid step" time steps in one solid time
+ * step, and with the solid taking as many in one fluid time step. The
+ * subcycled runs use interpolated or extrapolated coupling data, so they are
+ * only required to stay close to the reference.
+ */
+#include "mpi_fsi.h"
+#include "mpi_insim.h"
+#include "mpi_shared_hyper_elasticity.h"
+
+extern template class Fluid::MPI::InsIM<2>;
+extern template class Solid::MPI::SharedHyperElasticity<2>;
+extern template class Utils::GridCreator<2>;
+extern template class MPI::FSI<2>;
+
+using namespace dealii;
+
+// Return the norms of the fluid and solid solutions.
+std::pair<double, double> run(const Parameters::AllParameters &params)
+{
+  double L = 1, W = 2, H = 5, R = 0.125, h = 0.25;
+  parallel::distributed::Triangulation<2> fluid_tria(MPI_COMM_WORLD);
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    fluid_tria,
+    {static_cast<unsigned int>(W / h), static_cast<unsigned int>(H / h)},
+    Point<2>(0, 0),
+    Point<2>(W, -H),
+    true);
+  Fluid::MPI::InsIM<2> fluid(fluid_tria, params);
+
+  Triangulation<2> solid_tria;
+  Point<2> center(L, -L);
+  Utils::GridCreator<2>::sphere(solid_tria, center, R);
+  Solid::MPI::SharedHyperElasticity<2> solid(solid_tria, params);
+
+  MPI::FSI<2> fsi(fluid, solid, params);
+  fsi.run();
+  return {fluid.get_current_solution().l2_norm(),
+          solid.get_current_solution().l2_norm()};
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+      const unsigned int ratio = params.fluid_steps_per_solid_step;
+      AssertThrow(ratio > 1, ExcMessage("This test needs fluid subcycling!"));
+
+      Parameters::AllParameters reference_params(params);
+      reference_params.fluid_steps_per_solid_step = 1;
+      reference_params.solid_steps_per_fluid_step = 1;
+      auto reference = run(reference_params);
+
+      auto fluid_subcycled = run(params);
+
+      Parameters::AllParameters solid_params(params);
+      solid_params.fluid_steps_per_solid_step = 1;
+      solid_params.solid_steps_per_fluid_step = ratio;
+      auto solid_subcycled = run(solid_params);
+
+      auto difference = [&reference](const std::pair<double, double> &norms) {
+        return std::max(
+          std::abs(norms.first - reference.first) / reference.first,
+          std::abs(norms.second - reference.second) / reference.second);
+      };
+      const double fluid_subcycled_diff = difference(fluid_subcycled);
+      const double solid_subcycled_diff = difference(solid_subcycled);
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          std::cout << "Relative difference from the reference run, fluid "
+                       "subcycled: "
+                    << fluid_subcycled_diff
+                    << ", solid subcycled: " << solid_subcycled_diff
+                    << std::endl;
+        }
+      AssertThrow(fluid_subcycled_diff < 0.5 && solid_subcycled_diff < 0.5,
+                  ExcMessage("Multirate run is too far from the reference!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
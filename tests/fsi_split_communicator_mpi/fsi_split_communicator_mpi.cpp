@@ -0,0 +1,134 @@
+/**
+ * This program tests running the fluid and the solid on separate groups of
+ * processes. A ball falling in a tank is simulated with both solvers on all
+ * the processes, then with "Solid processes" of them running the solid only,
+ * staggered and pipelined. The staggered run must reproduce the shared one
+ * up to the solver tolerances. The pipelined run lags the solid by one time
+ * step in the fluid, so it is only required to stay close.
+ */
+#include "mpi_fsi.h"
+#include "mpi_insim.h"
+#include "mpi_shared_hyper_elasticity.h"
+
+extern template class Fluid::MPI::InsIM<2>;
+extern template class Solid::MPI::SharedHyperElasticity<2>;
+extern template class Utils::GridCreator<2>;
+extern template class MPI::FSI<2>;
+
+using namespace dealii;
+
+// Return the norms of the fluid and solid solutions on all the processes.
+std::pair<double, double> run(const Parameters::AllParameters &params)
+{
+  MPI::SplitCommunicators communicators(params);
+  const unsigned int n_processes =
+    Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const bool is_solid_process = rank + params.solid_processes >= n_processes;
+  const bool runs_fluid = params.solid_processes == 0 || !is_solid_process;
+  const bool runs_solid = params.solid_processes == 0 || is_solid_process;
+
+  double L = 1, W = 2, H = 5, R = 0.125, h = 0.25;
+  parallel::distributed::Triangulation<2> fluid_tria(communicators.fluid);
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    fluid_tria,
+    {static_cast<unsigned int>(W / h), static_cast<unsigned int>(H / h)},
+    Point<2>(0, 0),
+    Point<2>(W, -H),
+    true);
+  Fluid::MPI::InsIM<2> fluid(fluid_tria, params);
+
+  Triangulation<2> solid_tria;
+  Point<2> center(L, -L);
+  Utils::GridCreator<2>::sphere(solid_tria, center, R);
+  Solid::MPI::SharedHyperElasticity<2> solid(solid_tria,
+                                             params,
+                                             communicators.solid);
+
+  MPI::FSI<2> fsi(fluid, solid, params);
+  fsi.run();
+
+  const double fluid_norm =
+    runs_fluid ? fluid.get_current_solution().l2_norm() : 0;
+  const double solid_norm =
+    runs_solid ? solid.get_current_solution().l2_norm() : 0;
+  return {Utilities::MPI::max(fluid_norm, MPI_COMM_WORLD),
+          Utilities::MPI::max(solid_norm, MPI_COMM_WORLD)};
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+      AssertThrow(params.solid_processes > 0,
+                  ExcMessage("This test needs solid processes!"));
+
+      Parameters::AllParameters shared_params(params);
+      shared_params.solid_processes = 0;
+      shared_params.pipelined_coupling = false;
+      auto shared = run(shared_params);
+
+      Parameters::AllParameters staggered_params(params);
+      staggered_params.pipelined_coupling = false;
+      auto staggered = run(staggered_params);
+
+      Parameters::AllParameters pipelined_params(params);
+      pipelined_params.pipelined_coupling = true;
+      auto pipelined = run(pipelined_params);
+
+      auto difference = [&shared](const std::pair<double, double> &norms) {
+        return std::max(std::abs(norms.first - shared.first) / shared.first,
+                        std::abs(norms.second - shared.second) /
+                          shared.second);
+      };
+      const double staggered_diff = difference(staggered);
+      const double pipelined_diff = difference(pipelined);
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          std::cout << "Relative difference from the shared run, staggered: "
+                    << staggered_diff << ", pipelined: " << pipelined_diff
+                    << std::endl;
+        }
+      AssertThrow(staggered_diff < 1e-3,
+                  ExcMessage("Staggered split run differs from the shared "
+                             "one!"));
+      AssertThrow(pipelined_diff < 0.5,
+                  ExcMessage("Pipelined split run is too far from the shared "
+                             "one!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * This program tests the thread-parallel FSI coupling kernels.
+ * A ball falling in a tank is simulated with one thread and with all the
+ * available threads, both with the Dirichlet BCs and with the FSI
+ * acceleration in the artificial fluid. The solutions must be identical.
+ */
+#include <deal.II/base/multithread_info.h>
+
+#include "mpi_fsi.h"
+#include "mpi_insim.h"
+#include "mpi_shared_hyper_elasticity.h"
+
+extern template class Fluid::MPI::InsIM<2>;
+extern template class Solid::MPI::SharedHyperElasticity<2>;
+extern template class Utils::GridCreator<2>;
+extern template class MPI::FSI<2>;
+
+using namespace dealii;
+
+std::pair<PETScWrappers::MPI::BlockVector, PETScWrappers::MPI::Vector>
+run(const Parameters::AllParameters &params, bool use_dirichlet_bc)
+{
+  double L = 1, W = 2, H = 5, R = 0.125, h = 0.25;
+  parallel::distributed::Triangulation<2> fluid_tria(MPI_COMM_WORLD);
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    fluid_tria,
+    {static_cast<unsigned int>(W / h), static_cast<unsigned int>(H / h)},
+    Point<2>(0, 0),
+    Point<2>(W, -H),
+    true);
+  Fluid::MPI::InsIM<2> fluid(fluid_tria, params);
+
+  Triangulation<2> solid_tria;
+  Point<2> center(L, -L);
+  Utils::GridCreator<2>::sphere(solid_tria, center, R);
+  Solid::MPI::SharedHyperElasticity<2> solid(solid_tria, params);
+
+  MPI::FSI<2> fsi(fluid, solid, params, use_dirichlet_bc);
+  fsi.run();
+  return {fluid.get_current_solution(), solid.get_current_solution()};
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      const unsigned int n_threads = MultithreadInfo::n_threads();
+      for (bool use_dirichlet_bc : {true, false})
+        {
+          MultithreadInfo::set_thread_limit(1);
+          auto serial = run(params, use_dirichlet_bc);
+          MultithreadInfo::set_thread_limit(n_threads);
+          auto threaded = run(params, use_dirichlet_bc);
+
+          // The fluid solutions are ghosted, compare non-ghosted copies
+          std::vector<IndexSet> owned_partitioning;
+          for (unsigned int b = 0; b < serial.first.n_blocks(); ++b)
+            {
+              owned_partitioning.push_back(
+                serial.first.block(b).locally_owned_elements());
+            }
+          PETScWrappers::MPI::BlockVector fluid_error, threaded_fluid;
+          fluid_error.reinit(owned_partitioning, MPI_COMM_WORLD);
+          threaded_fluid.reinit(owned_partitioning, MPI_COMM_WORLD);
+          fluid_error = serial.first;
+          threaded_fluid = threaded.first;
+          fluid_error -= threaded_fluid;
+          serial.second -= threaded.second;
+          const double fluid_diff = fluid_error.linfty_norm();
+          const double solid_diff = serial.second.linfty_norm();
+          if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+            {
+              std::cout << "Threads: " << n_threads
+                        << ", Dirichlet BCs: " << use_dirichlet_bc
+                        << ", fluid difference: " << fluid_diff
+                        << ", solid difference: " << solid_diff << std::endl;
+            }
+          AssertThrow(fluid_diff == 0 && solid_diff == 0,
+                      ExcMessage("Threaded coupling differs from the serial "
+                                 "one!"));
+        }
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * This program tests the halo exchange of the distributed hypoelastic solver.
+ * The bending beam is advanced over several time steps by the serial solver
+ * on the first process and by the distributed solver on all the processes.
+ * The halo particles take the states of their owners before every step, so
+ * the displacements must agree. The dofs are numbered differently by the two
+ * solvers, hence the sorted entries of the displacements are compared.
+ */
+#include "hypo_elasticity.h"
+#include "mpi_shared_hypo_elasticity.h"
+
+extern template class Solid::HypoElasticity<2>;
+extern template class Solid::MPI::SharedHypoElasticity<2>;
+
+const double L = 8, H = 1, h = 0.125;
+
+using namespace dealii;
+
+void make_beam(Triangulation<2> &tria)
+{
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    tria,
+    {static_cast<unsigned int>(L / h), static_cast<unsigned int>(H / h)},
+    Point<2>(0, 0),
+    Point<2>(L, H),
+    true);
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+      AssertThrow(params.end_time > 2 * params.time_step,
+                  ExcMessage("This test should run several time steps!"));
+      const double dx = h / pow(2, params.global_refinements[1]);
+
+      std::vector<double> serial;
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          Triangulation<2> tria;
+          make_beam(tria);
+          Solid::HypoElasticity<2> solid(tria, params, dx, 1.3);
+          solid.run();
+          const Vector<double> u = solid.get_current_solution();
+          serial.assign(u.begin(), u.end());
+        }
+      serial = Utilities::MPI::broadcast(MPI_COMM_WORLD, serial, 0);
+
+      Triangulation<2> tria;
+      make_beam(tria);
+      Solid::MPI::SharedHypoElasticity<2> solid(tria, params, dx, 1.3);
+      solid.run();
+      const Vector<double> u(solid.get_current_solution());
+      std::vector<double> distributed(u.begin(), u.end());
+
+      AssertThrow(serial.size() == distributed.size(),
+                  ExcMessage("The solvers have different numbers of dofs!"));
+      std::sort(serial.begin(), serial.end());
+      std::sort(distributed.begin(), distributed.end());
+      double difference = 0, norm = 0;
+      for (unsigned int i = 0; i < serial.size(); ++i)
+        {
+          difference =
+            std::max(difference, std::abs(serial[i] - distributed[i]));
+          norm = std::max(norm, std::abs(serial[i]));
+        }
+      difference /= norm;
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        {
+          std::cout << "Max deflection: " << norm
+                    << ", relative difference: " << difference << std::endl;
+        }
+      AssertThrow(norm > 0, ExcMessage("The beam does not move!"));
+      AssertThrow(difference < 1e-8,
+                  ExcMessage("Distributed solution differs from the serial "
+                             "one!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * This program measures the strong scaling of the distributed hypoelastic
+ * solver. The bending beam is run on the first process alone and then on
+ * all the processes. The displacements must agree, and the speedup and the
+ * parallel efficiency are printed.
+ */
+#include <deal.II/base/timer.h>
+
+#include "mpi_shared_hypo_elasticity.h"
+
+extern template class Solid::MPI::SharedHypoElasticity<2>;
+
+const double L = 8, H = 1, h = 0.125;
+
+using namespace dealii;
+
+double run(const Parameters::AllParameters &params, MPI_Comm mpi_communicator)
+{
+  Triangulation<2> solid_tria;
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    solid_tria,
+    {static_cast<unsigned int>(L / h), static_cast<unsigned int>(H / h)},
+    Point<2>(0, 0),
+    Point<2>(L, H),
+    true);
+  Solid::MPI::SharedHypoElasticity<2> solid(
+    solid_tria,
+    params,
+    h / pow(2, params.global_refinements[1]),
+    1.3,
+    mpi_communicator);
+  solid.run();
+  return solid.get_current_solution().l2_norm();
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      const unsigned int rank =
+        Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+      const unsigned int n_processes =
+        Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+      // The reference run on a single process
+      MPI_Comm single_communicator;
+      MPI_Comm_split(MPI_COMM_WORLD,
+                     rank == 0 ? 0 : MPI_UNDEFINED,
+                     rank,
+                     &single_communicator);
+      double single_norm = 0, single_time = 0;
+      if (rank == 0)
+        {
+          Timer timer;
+          single_norm = run(params, single_communicator);
+          timer.stop();
+          single_time = timer.wall_time();
+          MPI_Comm_free(&single_communicator);
+        }
+      single_norm = Utilities::MPI::max(single_norm, MPI_COMM_WORLD);
+      single_time = Utilities::MPI::max(single_time, MPI_COMM_WORLD);
+
+      Timer timer(MPI_COMM_WORLD, true);
+      const double norm = run(params, MPI_COMM_WORLD);
+      timer.stop();
+      const double parallel_time = timer.wall_time();
+
+      const double difference = std::abs(norm - single_norm) / single_norm;
+      if (rank == 0)
+        {
+          const double speedup = single_time / parallel_time;
+          std::cout << "Wall time, 1 process: " << single_time << " s, "
+                    << n_processes << " processes: " << parallel_time
+                    << " s, speedup: " << speedup
+                    << ", efficiency: " << speedup / n_processes
+                    << ", relative difference: " << difference << std::endl;
+        }
+      AssertThrow(difference < 1e-8,
+                  ExcMessage("Distributed solution differs from the one "
+                             "computed on a single process!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
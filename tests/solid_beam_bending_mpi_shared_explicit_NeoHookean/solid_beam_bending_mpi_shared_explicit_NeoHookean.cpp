@@ -0,0 +1,97 @@
+/**
+ * This program tests the explicit solver with the beam bending problem
+ * with Neo-Hookean model. Constant traction is applied to the upper surface.
+ * The results are compared with those of the implicit solver, the time step
+ * is subcycled according to the estimated critical time step.
+ */
+#include "mpi_shared_explicit_hyper_elasticity.h"
+#include "parameters.h"
+#include "utilities.h"
+
+extern template class Solid::MPI::SharedExplicitHyperElasticity<2>;
+extern template class Solid::MPI::SharedExplicitHyperElasticity<3>;
+
+int main(int argc, char *argv[])
+{
+  using namespace dealii;
+
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      double L = 10.0, H = 1.0;
+      PETScWrappers::MPI::Vector u;
+      if (params.dimension == 2)
+        {
+          Triangulation<2> tria;
+          GridGenerator::subdivided_hyper_rectangle(
+            tria,
+            std::vector<unsigned int>{40, 4},
+            Point<2>(0, 0),
+            Point<2>(L, H),
+            true);
+          Solid::MPI::SharedExplicitHyperElasticity<2> solid(tria, params);
+          solid.run();
+          u = solid.get_current_solution();
+        }
+      else if (params.dimension == 3)
+        {
+          Triangulation<3> tria;
+          GridGenerator::subdivided_hyper_rectangle(
+            tria,
+            std::vector<unsigned int>{40, 4, 4},
+            Point<3>(0, 0, 0),
+            Point<3>(L, H, H),
+            true);
+          Solid::MPI::SharedExplicitHyperElasticity<3> solid(tria, params);
+          solid.run();
+          u = solid.get_current_solution();
+        }
+      else
+        {
+          AssertThrow(false, ExcNotImplemented());
+        }
+      double umin = u.min(), umax = u.max();
+      double umin_expected = (params.dimension == 2 ? -0.0616287 : -0.0617214);
+      double umax_expected = (params.dimension == 2 ? 0.00867069 : 0.00867507);
+      // The explicit and implicit time integrations differ slightly
+      double uerror = std::abs((umin - umin_expected) / umin_expected);
+      AssertThrow(uerror < 2e-2,
+                  ExcMessage("Minimum displacemet is incorrect"));
+      uerror = std::abs((umax - umax_expected) / umax_expected);
+      AssertThrow(uerror < 2e-2,
+                  ExcMessage("Maximum displacemet is incorrect"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * This program tests the symmetric storage of the solid matrices with the
+ * 2D bending beam. The beam is solved by the parallel linear elastic and
+ * hyperelastic solvers on a shared triangulation, and by the hyperelastic
+ * solver on a distributed triangulation, which uses its own block Jacobi
+ * preconditioner. Each one is solved with full AIJ matrices and with SBAIJ
+ * matrices, the displacements must agree up to the solver tolerance. The
+ * matrix memory is printed by the solvers, the wall times of the runs are
+ * printed here.
+ */
+#include <deal.II/base/timer.h>
+
+#include "mpi_hyper_elasticity.h"
+#include "mpi_shared_hyper_elasticity.h"
+#include "mpi_shared_linear_elasticity.h"
+
+extern template class Solid::MPI::SharedLinearElasticity<2>;
+extern template class Solid::MPI::SharedHyperElasticity<2>;
+extern template class Solid::MPI::HyperElasticity<2>;
+
+using namespace dealii;
+
+const double L = 8.0, H = 1.0;
+
+template <typename SolidSolver>
+PETScWrappers::MPI::Vector run_shared(const Parameters::AllParameters &params)
+{
+  Triangulation<2> tria;
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    tria, {32, 4}, Point<2>(0, 0), Point<2>(L, H), true);
+  SolidSolver solid(tria, params);
+  solid.run();
+  return solid.get_current_solution();
+}
+
+PETScWrappers::MPI::Vector
+run_distributed(const Parameters::AllParameters &params)
+{
+  parallel::distributed::Triangulation<2> tria(MPI_COMM_WORLD);
+  dealii::GridGenerator::subdivided_hyper_rectangle(
+    tria, {32, 4}, Point<2>(0, 0), Point<2>(L, H), true);
+  Solid::MPI::HyperElasticity<2> solid(tria, params);
+  solid.run();
+  return solid.get_current_solution();
+}
+
+/**
+ * Solve with full and with symmetric storage and return the relative
+ * difference of the displacements. The distributed solver numbers the dofs
+ * differently with symmetric storage, so only the norms of its
+ * displacements are compared.
+ */
+template <typename Run>
+double compare(const std::string &name,
+               Parameters::AllParameters params,
+               const Run &run,
+               const bool same_numbering)
+{
+  Timer timer(MPI_COMM_WORLD, true);
+  params.solid_symmetric_storage = false;
+  const auto reference = run(params);
+  timer.stop();
+  const double full_time = timer.wall_time();
+
+  timer.restart();
+  params.solid_symmetric_storage = true;
+  auto u = run(params);
+  timer.stop();
+  const double symmetric_time = timer.wall_time();
+
+  double difference;
+  if (same_numbering)
+    {
+      u -= reference;
+      difference = u.l2_norm() / reference.l2_norm();
+    }
+  else
+    {
+      difference =
+        std::max(std::abs(u.l2_norm() - reference.l2_norm()) /
+                   reference.l2_norm(),
+                 std::abs(u.linfty_norm() - reference.linfty_norm()) /
+                   reference.linfty_norm());
+    }
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      std::cout << name << ": wall time, full storage: " << full_time
+                << " s, symmetric storage: " << symmetric_time
+                << " s, relative difference: " << difference << std::endl;
+    }
+  return difference;
+}
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.dimension == 2,
+                  ExcMessage("This test should be run in 2D!"));
+
+      AssertThrow(params.solid_symmetric_storage,
+                  ExcMessage("This test needs the symmetric storage!"));
+
+      AssertThrow(
+        compare("Shared linear elastic",
+                params,
+                run_shared<Solid::MPI::SharedLinearElasticity<2>>,
+                true) < 1e-6,
+        ExcMessage("Linear elastic solution with symmetric storage differs "
+                   "from the one with full storage!"));
+
+      // The same beam as a Neo-Hookean material with the same small strain
+      // moduli, over fewer steps
+      const double E = params.E[0], nu = params.nu[0];
+      params.solid_type = "NeoHookean";
+      params.C = {{E / (4 * (1 + nu)), E / (3 * (1 - 2 * nu))}};
+      params.end_time = 10 * params.time_step;
+      AssertThrow(
+        compare("Shared hyperelastic",
+                params,
+                run_shared<Solid::MPI::SharedHyperElasticity<2>>,
+                true) < 1e-6,
+        ExcMessage("Hyperelastic solution with symmetric storage differs "
+                   "from the one with full storage!"));
+      AssertThrow(
+        compare("Distributed hyperelastic", params, run_distributed, false) <
+          1e-6,
+        ExcMessage("Distributed solution with symmetric storage differs "
+                   "from the one with full storage!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * This program tests the cell-list based SPH interpolation against the
+ * original brute-force search, and reports the time spent by both.
+ * A linear vector field is interpolated to a lattice of target points in a
+ * unit square, the two interpolators must agree to round-off.
+ */
+#include <deal.II/base/timer.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include "parameters.h"
+#include "utilities.h"
+
+using namespace dealii;
+
+extern template class Utils::CellCenterIndex<2>;
+extern template class Utils::SPHInterpolator<2, Vector<double>>;
+
+class LinearField : public Function<2>
+{
+public:
+  LinearField() : Function<2>(2) {}
+  virtual double value(const Point<2> &p, const unsigned int component) const
+  {
+    return component == 0 ? p[0] + 2 * p[1] : 3 * p[0] - p[1];
+  }
+};
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+
+      if (params.dimension == 2)
+        {
+          Triangulation<2> tria;
+          GridGenerator::hyper_cube(tria, 0, 1, true);
+          tria.refine_global(params.global_refinements[0]);
+          FESystem<2> fe(FE_Q<2>(params.fluid_velocity_degree), 2);
+          DoFHandler<2> dof_handler(tria);
+          dof_handler.distribute_dofs(fe);
+          Vector<double> field(dof_handler.n_dofs());
+          VectorTools::interpolate(dof_handler, LinearField(), field);
+
+          // Target points on a lattice that is not aligned with the mesh
+          const unsigned int n = 100;
+          std::vector<Point<2>> targets;
+          for (unsigned int i = 0; i < n; ++i)
+            for (unsigned int j = 0; j < n; ++j)
+              targets.push_back(
+                Point<2>(0.1 + 0.8 * i / (n - 1), 0.1 + 0.8 * j / (n - 1)));
+
+          Timer timer;
+          std::vector<Vector<double>> reference(targets.size(),
+                                                Vector<double>(2));
+          for (unsigned int t = 0; t < targets.size(); ++t)
+            {
+              Utils::SPHInterpolator<2, Vector<double>> sph(dof_handler,
+                                                            targets[t]);
+              sph.point_value(field, reference[t]);
+            }
+          timer.stop();
+          const double brute_force_time = timer.wall_time();
+
+          timer.restart();
+          Utils::CellCenterIndex<2> index(dof_handler);
+          Utils::SPHInterpolator<2, Vector<double>> sph(index, targets);
+          std::vector<Vector<double>> values(targets.size(),
+                                             Vector<double>(2));
+          sph.point_values(field, values);
+          timer.stop();
+          const double cell_list_time = timer.wall_time();
+
+          double max_diff = 0;
+          for (unsigned int t = 0; t < targets.size(); ++t)
+            {
+              values[t] -= reference[t];
+              max_diff = std::max(max_diff, values[t].linfty_norm());
+            }
+          std::cout << "Cells: " << tria.n_active_cells()
+                    << ", targets: " << targets.size() << std::endl
+                    << "Brute force search: " << brute_force_time << "s"
+                    << std::endl
+                    << "Cell list search:   " << cell_list_time << "s"
+                    << std::endl
+                    << "Max difference:     " << max_diff << std::endl;
+          AssertThrow(max_diff < 1e-10,
+                      ExcMessage("Cell list SPH interpolation differs from "
+                                 "the brute force one!"));
+        }
+      else
+        {
+          AssertThrow(false, ExcMessage("This test should be run in 2D!"));
+        }
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * This program tests the adaptive time step controller and the time-based
+ * output triggers. The time step size is driven up and down by large
+ * factors, it must stay within the bounds of the parameter file, end exactly
+ * at the end time, and the output must still happen once per output
+ * interval.
+ */
+#include "parameters.h"
+#include "utilities.h"
+
+using namespace dealii;
+
+int main(int argc, char *argv[])
+{
+  try
+    {
+      std::string infile("parameters.prm");
+      if (argc > 1)
+        {
+          infile = argv[1];
+        }
+      Parameters::AllParameters params(infile);
+      AssertThrow(params.adaptive_time_stepping,
+                  ExcMessage("This test needs adaptive time stepping!"));
+
+      Utils::Time time(params.end_time,
+                       params.time_step,
+                       params.output_interval,
+                       params.refinement_interval,
+                       params.save_interval);
+      Utils::TimeStepController controller(params);
+
+      // The factors of a well resolved and of a hard step
+      AssertThrow(std::abs(controller.error_factor(
+                             params.truncation_error_tolerance, 1) -
+                           0.9) < 1e-12,
+                  ExcMessage("Wrong error factor!"));
+      AssertThrow(controller.iteration_factor(
+                    2 * params.target_nonlinear_iterations) == 0.5,
+                  ExcMessage("Wrong iteration factor!"));
+
+      unsigned int n_outputs = 0;
+      while (time.end() - time.current() > 1e-12)
+        {
+          const double delta_t = time.get_delta_t();
+          time.increment();
+          if (time.time_to_output())
+            {
+              ++n_outputs;
+            }
+          // Grow for a few steps, then cut the step
+          const double factor = (time.get_timestep() % 5 == 0) ? 1e-2 : 1e2;
+          controller.update(time, factor);
+          const double ratio = time.get_delta_t() / delta_t;
+          // The step before the end time is shortened to reach it
+          const bool last_step =
+            time.current() + time.get_delta_t() > time.end() - 1e-12;
+          AssertThrow(last_step || (time.get_delta_t() >=
+                                      params.min_time_step * (1 - 1e-12) &&
+                                    time.get_delta_t() <=
+                                      params.max_time_step * (1 + 1e-12)),
+                      ExcMessage("Time step size out of bounds!"));
+          AssertThrow(last_step ||
+                        (ratio >= params.time_step_reduction * (1 - 1e-12) &&
+                         ratio <= params.time_step_growth * (1 + 1e-12)),
+                      ExcMessage("Time step size changed too fast!"));
+        }
+      const unsigned int expected_outputs = static_cast<unsigned int>(
+        std::round(params.end_time / params.output_interval));
+      std::cout << "Time steps: " << time.get_timestep()
+                << ", end time: " << time.current()
+                << ", outputs: " << n_outputs << std::endl;
+      AssertThrow(std::abs(time.current() - params.end_time) < 1e-12,
+                  ExcMessage("Did not stop at the end time!"));
+      AssertThrow(n_outputs == expected_outputs,
+                  ExcMessage("Wrong number of outputs!"));
+
+      // A sharp drop of the stable step cuts the step size below the
+      // reduction factor and the minimum size
+      Utils::Time cfl_time(params.end_time,
+                           params.min_time_step,
+                           params.output_interval,
+                           params.refinement_interval,
+                           params.save_interval);
+      cfl_time.increment();
+      controller.update(cfl_time, 1.0, 1e-3);
+      AssertThrow(std::abs(cfl_time.get_delta_t() -
+                           1e-3 * params.min_time_step) <
+                    1e-12 * params.min_time_step,
+                  ExcMessage("The CFL limit is not a hard cap!"));
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  return 0;
+}